@@ -203,16 +203,25 @@ void InitDiskCacheOption(Configuration *conf,
                               &diskCacheOption->avgReadFileBytes);
     conf->GetValueFatalIfFail("diskCache.avgReadFileIops",
                               &diskCacheOption->avgReadFileIops);
+    conf->GetValueFatalIfFail("diskCache.admissionFilter",
+                              &diskCacheOption->admissionFilter);
 }
 
 void InitS3Option(Configuration *conf, S3Option *s3Opt) {
     conf->GetValueFatalIfFail("s3.fakeS3", &FLAGS_useFakeS3);
     conf->GetValueFatalIfFail("s3.pageSize",
                               &s3Opt->s3ClientAdaptorOpt.pageSize);
+    conf->GetValueFatalIfFail("s3.pagePoolMaxIdleByte",
+                              &s3Opt->s3ClientAdaptorOpt.pagePoolMaxIdleByte);
     conf->GetValueFatalIfFail("s3.prefetchBlocks",
                               &s3Opt->s3ClientAdaptorOpt.prefetchBlocks);
     conf->GetValueFatalIfFail("s3.prefetchExecQueueNum",
                               &s3Opt->s3ClientAdaptorOpt.prefetchExecQueueNum);
+    conf->GetValueFatalIfFail("s3.prefetchMaxBlocks",
+                              &s3Opt->s3ClientAdaptorOpt.prefetchMaxBlocks);
+    conf->GetValueFatalIfFail(
+        "s3.prefetchMaxInflightBytes",
+        &s3Opt->s3ClientAdaptorOpt.prefetchMaxInflightBytes);
     conf->GetValueFatalIfFail("s3.threadScheduleInterval",
                               &s3Opt->s3ClientAdaptorOpt.intervalSec);
     conf->GetValueFatalIfFail("s3.cacheFlushIntervalSec",
@@ -225,6 +234,8 @@ void InitS3Option(Configuration *conf, S3Option *s3Opt) {
                               &s3Opt->s3ClientAdaptorOpt.readCacheMaxByte);
     conf->GetValueFatalIfFail("s3.readCacheThreads",
                               &s3Opt->s3ClientAdaptorOpt.readCacheThreads);
+    conf->GetValueFatalIfFail("s3.readCacheShards",
+                              &s3Opt->s3ClientAdaptorOpt.readCacheShards);
     conf->GetValueFatalIfFail("s3.nearfullRatio",
                               &s3Opt->s3ClientAdaptorOpt.nearfullRatio);
     conf->GetValueFatalIfFail("s3.baseSleepUs",
@@ -281,6 +292,10 @@ void InitRefreshDataOpt(Configuration *conf,
                               &opt->maxDataSize);
     conf->GetValueFatalIfFail("fuseClient.refreshDataIntervalSec",
                               &opt->refreshDataIntervalSec);
+    conf->GetValueFatalIfFail("fuseClient.inodeLeaseMs",
+                              &opt->inodeLeaseMs);
+    conf->GetValueFatalIfFail("fuseClient.inodeLeaseCacheSize",
+                              &opt->inodeLeaseCacheSize);
 }
 
 void InitKVClientManagerOpt(Configuration *conf,
@@ -293,6 +308,18 @@ void InitKVClientManagerOpt(Configuration *conf,
                               &config->getThreadPooln);
 }
 
+void InitPeerCacheOption(Configuration *conf, PeerCacheOption *option) {
+    conf->GetValueFatalIfFail("peerCache.enable", &option->enable);
+    conf->GetValueFatalIfFail("peerCache.listenPort", &option->listenPort);
+    conf->GetValueFatalIfFail("peerCache.memoryMaxByte",
+                              &option->memoryMaxByte);
+    conf->GetValueFatalIfFail("peerCache.rpcTimeoutMs", &option->rpcTimeoutMs);
+    conf->GetValueFatalIfFail("peerCache.refreshIntervalSec",
+                              &option->refreshIntervalSec);
+    conf->GetValueFatalIfFail("peerCache.virtualNodes",
+                              &option->virtualNodes);
+}
+
 void InitFileSystemOption(Configuration* c, FileSystemOption* option) {
     c->GetValueFatalIfFail("fs.cto", &option->cto);
     c->GetValueFatalIfFail("fs.cto", &FLAGS_enableCto);
@@ -339,6 +366,11 @@ void InitFileSystemOption(Configuration* c, FileSystemOption* option) {
         auto o = &option->deferSyncOption;
         c->GetValueFatalIfFail("fs.deferSync.delay", &o->delay);
         c->GetValueFatalIfFail("fs.deferSync.deferDirMtime", &o->deferDirMtime);
+        c->GetValueFatalIfFail("fs.deferSync.deferCreate", &o->deferCreate);
+        c->GetValueFatalIfFail("fs.deferSync.deferCreateThreads",
+                               &o->deferCreateThreads);
+        c->GetValueFatalIfFail("fs.deferSync.deferCreateMaxPending",
+                               &o->deferCreateMaxPending);
     }
 }
 
@@ -362,6 +394,7 @@ void InitFuseClientOption(Configuration *conf, FuseClientOption *clientOption) {
     InitLeaseOpt(conf, &clientOption->leaseOpt);
     InitRefreshDataOpt(conf, &clientOption->refreshDataOption);
     InitKVClientManagerOpt(conf, &clientOption->kvClientManagerOpt);
+    InitPeerCacheOption(conf, &clientOption->peerCacheOpt);
     InitFileSystemOption(conf, &clientOption->fileSystemOption);
 
     conf->GetValueFatalIfFail("fuseClient.listDentryLimit",
@@ -376,6 +409,8 @@ void InitFuseClientOption(Configuration *conf, FuseClientOption *clientOption) {
                               &clientOption->downloadMaxRetryTimes);
     conf->GetValueFatalIfFail("fuseClient.warmupThreadsNum",
                               &clientOption->warmupThreadsNum);
+    conf->GetValueFatalIfFail("fuseClient.warmupBandwidthLimitMB",
+                              &clientOption->warmupBandwidthLimitMB);
     LOG_IF(WARNING, conf->GetBoolValue("fuseClient.enableSplice",
                                        &clientOption->enableFuseSplice))
         << "Not found `fuseClient.enableSplice` in conf, use default value `"
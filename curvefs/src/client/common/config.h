@@ -83,6 +83,18 @@ struct KVClientManagerOpt {
     int getThreadPooln = 4;
 };
 
+// peer cache shares the blocks read from s3 among the clients of a fs,
+// it takes the place of memcache if enabled
+struct PeerCacheOption {
+    bool enable = false;
+    // the first port to listen on, the next free one is used if it's taken
+    uint32_t listenPort = 9200;
+    uint64_t memoryMaxByte = 1ULL * 1024 * 1024 * 1024;
+    uint32_t rpcTimeoutMs = 100;
+    uint32_t refreshIntervalSec = 30;
+    uint32_t virtualNodes = 100;
+};
+
 struct DiskCacheOption {
     DiskCacheType diskCacheType;
     // cache disk dir
@@ -117,20 +129,31 @@ struct DiskCacheOption {
     uint64_t avgFlushIops;
     // the read throttle iops of disk cache
     uint64_t avgReadFileIops;
+    // if true, objects read from s3 are admitted into a disk cache under
+    // trim pressure only if they are accessed more often than the victims
+    bool admissionFilter = false;
 };
 
 struct S3ClientAdaptorOption {
     uint64_t blockSize;
     uint64_t chunkSize;
     uint64_t pageSize;
+    // released pages of data caches kept for reuse, 0 means no reuse
+    uint64_t pagePoolMaxIdleByte = 0;
     uint32_t prefetchBlocks;
     uint32_t prefetchExecQueueNum;
+    // the prefetch window grows up to it for sequential and strided reads
+    uint32_t prefetchMaxBlocks = 0;
+    // 0 means no limit
+    uint64_t prefetchMaxInflightBytes = 0;
     uint32_t intervalSec;
     uint32_t chunkFlushThreads;
     uint32_t flushIntervalSec;
     uint64_t writeCacheMaxByte;
     uint64_t readCacheMaxByte;
     uint32_t readCacheThreads;
+    // number of shards of the read cache lru, each has its own lock
+    uint32_t readCacheShards = 1;
     uint32_t nearfullRatio;
     uint32_t baseSleepUs;
     uint32_t maxReadRetryIntervalMs;
@@ -173,6 +196,9 @@ struct ExtentManagerOption {
 struct RefreshDataOption {
     uint64_t maxDataSize = 1024;
     uint32_t refreshDataIntervalSec = 30;
+    // lease of the inodes kept after they are closed, 0 means disable
+    uint32_t inodeLeaseMs = 0;
+    uint64_t inodeLeaseCacheSize = 65536;
 };
 
 // { filesystem option
@@ -210,6 +236,9 @@ struct RPCOption {
 struct DeferSyncOption {
     uint32_t delay;
     bool deferDirMtime;
+    bool deferCreate = false;
+    uint32_t deferCreateThreads = 4;
+    uint32_t deferCreateMaxPending = 65536;
 };
 
 struct FileSystemOption {
@@ -240,6 +269,7 @@ struct FuseClientOption {
     LeaseOpt leaseOpt;
     RefreshDataOption refreshDataOption;
     KVClientManagerOpt kvClientManagerOpt;
+    PeerCacheOption peerCacheOpt;
     FileSystemOption fileSystemOption;
 
     uint32_t listDentryLimit;
@@ -249,6 +279,8 @@ struct FuseClientOption {
     bool enableFuseSplice = false;
     uint32_t downloadMaxRetryTimes;
     uint32_t warmupThreadsNum = 10;
+    // bandwidth limit of downloading objects for warmup, 0 means no limit
+    uint64_t warmupBandwidthLimitMB = 0;
 };
 
 void InitFuseClientOption(Configuration *conf, FuseClientOption *clientOption);
@@ -25,6 +25,7 @@
 #include <cstdint>
 #include <string>
 #include <list>
+#include <map>
 #include <vector>
 #include <utility>
 #include <unordered_map>
@@ -42,13 +43,47 @@ DECLARE_bool(enableCto);
 namespace curvefs {
 namespace client {
 
+using curve::common::LockGuard;
+using curve::common::UniqueLock;
 using curve::common::WriteLockGuard;
 using NameLockGuard = ::curve::common::GenericNameLockGuard<Mutex>;
 using ::curvefs::client::filesystem::ToFSError;
 
+CURVEFS_ERROR DentryCacheManagerImpl::Init(const DeferSyncOption &option) {
+    deferCreate_ = option.deferCreate;
+    if (!deferCreate_) {
+        return CURVEFS_ERROR::OK;
+    }
+
+    int rc = flushThreadPool_.Start(option.deferCreateThreads,
+                                    option.deferCreateMaxPending);
+    if (rc != 0) {
+        LOG(ERROR) << "Start defer create thread pool failed, rc = " << rc;
+        return CURVEFS_ERROR::INTERNAL;
+    }
+    return CURVEFS_ERROR::OK;
+}
+
+void DentryCacheManagerImpl::UnInit() {
+    if (!deferCreate_) {
+        return;
+    }
+
+    {
+        UniqueLock lk(pendingMutex_);
+        pendingCond_.wait(lk, [&]() { return pendingDentrys_.empty(); });
+    }
+    flushThreadPool_.Stop();
+    deferCreate_ = false;
+}
+
 CURVEFS_ERROR DentryCacheManagerImpl::GetDentry(uint64_t parent,
                                                 const std::string &name,
                                                 Dentry *out) {
+    if (deferCreate_ && GetPendingDentry(parent, name, out)) {
+        return CURVEFS_ERROR::OK;
+    }
+
     std::string key = GetDentryCacheKey(parent, name);
     NameLockGuard lock(nameLock_, key);
 
@@ -79,9 +114,106 @@ CURVEFS_ERROR DentryCacheManagerImpl::CreateDentry(const Dentry &dentry) {
     return CURVEFS_ERROR::OK;
 }
 
+CURVEFS_ERROR DentryCacheManagerImpl::DeferCreateDentry(const Dentry &dentry) {
+    if (!deferCreate_) {
+        return CreateDentry(dentry);
+    }
+
+    uint64_t parent = dentry.parentinodeid();
+    {
+        LockGuard lk(pendingMutex_);
+        auto &dentrys = pendingDentrys_[parent];
+        if (!dentrys.emplace(dentry.name(), dentry).second) {
+            return CURVEFS_ERROR::EXISTS;
+        }
+        pendingInodes_[dentry.inodeid()]++;
+    }
+
+    // blocks if there are too many pending dentries
+    flushThreadPool_.Enqueue(&DentryCacheManagerImpl::FlushPendingDentry,
+                             this, dentry);
+    return CURVEFS_ERROR::OK;
+}
+
+bool DentryCacheManagerImpl::GetPendingDentry(uint64_t parent,
+                                              const std::string &name,
+                                              Dentry *out) {
+    LockGuard lk(pendingMutex_);
+    auto iter = pendingDentrys_.find(parent);
+    if (iter == pendingDentrys_.end()) {
+        return false;
+    }
+    auto it = iter->second.find(name);
+    if (it == iter->second.end()) {
+        return false;
+    }
+    *out = it->second;
+    return true;
+}
+
+void DentryCacheManagerImpl::FlushPendingDentry(const Dentry &dentry) {
+    uint64_t parent = dentry.parentinodeid();
+    CURVEFS_ERROR rc = CreateDentry(dentry);
+    if (rc != CURVEFS_ERROR::OK) {
+        // the create has been acknowledged, what we can do is to remove
+        // the orphan inode, just like what a synchronous create does
+        MetaStatusCode ret = metaClient_->DeleteInode(fsId_, dentry.inodeid());
+        LOG(ERROR) << "Deferred create dentry failed, rc = " << rc
+                   << ", parent = " << parent << ", name = " << dentry.name()
+                   << ", inodeid = " << dentry.inodeid()
+                   << ", delete inode " << MetaStatusCode_Name(ret);
+    }
+
+    LockGuard lk(pendingMutex_);
+    if (rc != CURVEFS_ERROR::OK) {
+        failedInodes_.insert(dentry.inodeid());
+    }
+    auto iter = pendingDentrys_.find(parent);
+    iter->second.erase(dentry.name());
+    if (iter->second.empty()) {
+        pendingDentrys_.erase(iter);
+    }
+    auto it = pendingInodes_.find(dentry.inodeid());
+    if (--it->second == 0) {
+        pendingInodes_.erase(it);
+    }
+    pendingCond_.notify_all();
+}
+
+void DentryCacheManagerImpl::WaitPendingDentry(uint64_t parent) {
+    if (!deferCreate_) {
+        return;
+    }
+
+    UniqueLock lk(pendingMutex_);
+    pendingCond_.wait(lk, [&]() {
+        return pendingDentrys_.find(parent) == pendingDentrys_.end();
+    });
+}
+
+CURVEFS_ERROR DentryCacheManagerImpl::WaitPendingInode(uint64_t inodeId) {
+    if (!deferCreate_) {
+        return CURVEFS_ERROR::OK;
+    }
+
+    UniqueLock lk(pendingMutex_);
+    pendingCond_.wait(lk, [&]() {
+        return pendingInodes_.find(inodeId) == pendingInodes_.end();
+    });
+    // the error is reported once, so the set doesn't grow with the mount
+    if (failedInodes_.erase(inodeId) != 0) {
+        LOG(ERROR) << "Deferred create dentry of inode " << inodeId
+                   << " failed, the inode has been removed";
+        return CURVEFS_ERROR::IO_ERROR;
+    }
+    return CURVEFS_ERROR::OK;
+}
+
 CURVEFS_ERROR DentryCacheManagerImpl::DeleteDentry(uint64_t parent,
                                                    const std::string &name,
                                                    FsFileType type) {
+    WaitPendingDentry(parent);
+
     std::string key = GetDentryCacheKey(parent, name);
     NameLockGuard lock(nameLock_, key);
 
@@ -101,6 +233,7 @@ CURVEFS_ERROR DentryCacheManagerImpl::ListDentry(uint64_t parent,
                                                  bool onlyDir,
                                                  uint32_t nlink) {
     dentryList->clear();
+    WaitPendingDentry(parent);
     // means no dir under this dir
     if (onlyDir && nlink == 2) {
         LOG(INFO) << "ListDentry parent = " << parent
@@ -156,5 +289,47 @@ CURVEFS_ERROR DentryCacheManagerImpl::ListDentry(uint64_t parent,
     return CURVEFS_ERROR::OK;
 }
 
+CURVEFS_ERROR DentryCacheManagerImpl::ListDentryPlus(
+    uint64_t parent, std::list<Dentry> *dentryList,
+    std::map<uint64_t, InodeAttr> *attrs, uint32_t limit) {
+    dentryList->clear();
+    attrs->clear();
+    WaitPendingDentry(parent);
+
+    bool perceed = true;
+    std::string last = "";
+    do {
+        std::list<Dentry> part;
+        std::list<InodeAttr> partAttrs;
+        MetaStatusCode ret = metaClient_->ListDentryPlus(
+            fsId_, parent, last, limit, &part, &partAttrs);
+        VLOG(6) << "ListDentryPlus fsId = " << fsId_ << ", parent = " << parent
+                << ", last = " << last << ", count = " << limit
+                << ", ret = " << ret << ", part.size() = " << part.size()
+                << ", attrs.size() = " << partAttrs.size();
+        if (ret != MetaStatusCode::OK) {
+            LOG(ERROR) << "metaClient_ ListDentryPlus failed"
+                       << ", MetaStatusCode_Name = " << MetaStatusCode_Name(ret)
+                       << ", parent = " << parent << ", last = " << last
+                       << ", count = " << limit;
+            return ToFSError(ret);
+        }
+
+        if (part.size() < limit) {
+            perceed = false;
+        }
+        if (!part.empty()) {
+            last = part.back().name();
+            dentryList->splice(dentryList->end(), part);
+        }
+        for (auto &attr : partAttrs) {
+            uint64_t inodeId = attr.inodeid();
+            attrs->emplace(inodeId, std::move(attr));
+        }
+    } while (perceed);
+
+    return CURVEFS_ERROR::OK;
+}
+
 }  // namespace client
 }  // namespace curvefs
@@ -29,12 +29,15 @@
 #include <string>
 #include <list>
 #include <unordered_map>
+#include <unordered_set>
 #include <map>
 #include <utility>
 
 #include "curvefs/src/client/rpcclient/metaserver_client.h"
+#include "curvefs/src/client/common/config.h"
 #include "src/common/concurrent/concurrent.h"
 #include "src/common/concurrent/name_lock.h"
+#include "src/common/concurrent/task_thread_pool.h"
 #include "curvefs/src/client/filesystem/error.h"
 
 using ::curvefs::metaserver::Dentry;
@@ -45,6 +48,7 @@ namespace client {
 using rpcclient::MetaServerClient;
 using rpcclient::MetaServerClientImpl;
 using ::curvefs::client::filesystem::CURVEFS_ERROR;
+using ::curvefs::client::common::DeferSyncOption;
 
 static const char* kDentryKeyDelimiter = ":";
 
@@ -57,6 +61,13 @@ class DentryCacheManager {
         fsId_ = fsId;
     }
 
+    virtual CURVEFS_ERROR Init(const DeferSyncOption &option) {
+        (void)option;
+        return CURVEFS_ERROR::OK;
+    }
+
+    virtual void UnInit() {}
+
     virtual CURVEFS_ERROR GetDentry(uint64_t parent,
         const std::string &name, Dentry *out) = 0;
 
@@ -70,6 +81,29 @@ class DentryCacheManager {
         std::list<Dentry> *dentryList, uint32_t limit,
         bool onlyDir = false, uint32_t nlink = 0) = 0;
 
+    // list all dentries under |parent|, attributes of the inodes which are
+    // stored with their dentries are returned in |attrs| together
+    virtual CURVEFS_ERROR ListDentryPlus(uint64_t parent,
+        std::list<Dentry> *dentryList,
+        std::map<uint64_t, InodeAttr> *attrs, uint32_t limit) = 0;
+
+    // create dentry in background if defer create is enabled, the dentry
+    // is visible to GetDentry() of this client before it's created
+    virtual CURVEFS_ERROR DeferCreateDentry(const Dentry &dentry) {
+        return CreateDentry(dentry);
+    }
+
+    // wait until all deferred dentries under |parent| are created
+    virtual void WaitPendingDentry(uint64_t parent) { (void)parent; }
+
+    // wait until all deferred dentries point to |inodeId| are created,
+    // return IO_ERROR if any of them failed and the inode has been removed,
+    // the failure is returned to the first caller only
+    virtual CURVEFS_ERROR WaitPendingInode(uint64_t inodeId) {
+        (void)inodeId;
+        return CURVEFS_ERROR::OK;
+    }
+
  protected:
     uint32_t fsId_;
 };
@@ -83,6 +117,10 @@ class DentryCacheManagerImpl : public DentryCacheManager {
         const std::shared_ptr<MetaServerClient> &metaClient)
       : metaClient_(metaClient) {}
 
+    CURVEFS_ERROR Init(const DeferSyncOption &option) override;
+
+    void UnInit() override;
+
     CURVEFS_ERROR GetDentry(uint64_t parent,
         const std::string &name, Dentry *out) override;
 
@@ -96,13 +134,40 @@ class DentryCacheManagerImpl : public DentryCacheManager {
         std::list<Dentry> *dentryList, uint32_t limit,
         bool dirOnly = false, uint32_t nlink = 0) override;
 
+    CURVEFS_ERROR ListDentryPlus(uint64_t parent,
+        std::list<Dentry> *dentryList,
+        std::map<uint64_t, InodeAttr> *attrs, uint32_t limit) override;
+
+    CURVEFS_ERROR DeferCreateDentry(const Dentry &dentry) override;
+
+    void WaitPendingDentry(uint64_t parent) override;
+
+    CURVEFS_ERROR WaitPendingInode(uint64_t inodeId) override;
+
     std::string GetDentryCacheKey(uint64_t parent, const std::string &name) {
         return std::to_string(parent) + kDentryKeyDelimiter + name;
     }
 
+ private:
+    bool GetPendingDentry(uint64_t parent, const std::string &name,
+                          Dentry *out);
+
+    void FlushPendingDentry(const Dentry &dentry);
+
  private:
     std::shared_ptr<MetaServerClient> metaClient_;
     curve::common::GenericNameLock<Mutex> nameLock_;
+
+    // dentries of deferred creates, parent => (name => dentry)
+    bool deferCreate_ = false;
+    Mutex pendingMutex_;
+    curve::common::ConditionVariable pendingCond_;
+    std::unordered_map<uint64_t, std::map<std::string, Dentry>> pendingDentrys_;
+    std::unordered_map<uint64_t, uint32_t> pendingInodes_;
+    // inodes removed because their deferred dentries failed to create,
+    // erased once the failure is reported by WaitPendingInode()
+    std::unordered_set<uint64_t> failedInodes_;
+    curve::common::TaskThreadPool<> flushThreadPool_;
 };
 
 }  // namespace client
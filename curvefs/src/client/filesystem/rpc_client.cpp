@@ -74,18 +74,23 @@ CURVEFS_ERROR RPCClient::ReadDir(Ino ino,
                                  std::shared_ptr<DirEntryList>* entries) {
     uint32_t limit = option_.listDentryLimit;
 
+    // attributes of inodes in the same partition with their dentries
+    // are returned by ListDentryPlus, so only fetch the rest of them
     std::list<Dentry> dentries;
-    CURVEFS_ERROR rc = dentryManager_->ListDentry(ino, &dentries, limit);
+    std::map<uint64_t, InodeAttr> attrs;
+    CURVEFS_ERROR rc = dentryManager_->ListDentryPlus(ino, &dentries, &attrs,
+                                                      limit);
     if (rc != CURVEFS_ERROR::OK) {
-        LOG(ERROR) << "rpc(readdir::ListDentry) failed, retCode = " << rc
+        LOG(ERROR) << "rpc(readdir::ListDentryPlus) failed, retCode = " << rc
                    << ", ino = " << ino;
         return rc;
     }
 
     std::set<uint64_t> inos;
-    std::map<uint64_t, InodeAttr> attrs;
     std::for_each(dentries.begin(), dentries.end(), [&](Dentry& dentry){
-        inos.emplace(dentry.inodeid());
+        if (attrs.find(dentry.inodeid()) == attrs.end()) {
+            inos.emplace(dentry.inodeid());
+        }
     });
     rc = inodeManager_->BatchGetInodeAttrAsync(ino, &inos, &attrs);
     if (rc != CURVEFS_ERROR::OK) {
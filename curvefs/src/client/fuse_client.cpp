@@ -179,6 +179,14 @@ CURVEFS_ERROR FuseClient::Init(const FuseClientOption &option) {
         }
     }
 
+    {  // init dentry manager
+        CURVEFS_ERROR rc = dentryManager_->Init(
+            option_.fileSystemOption.deferSyncOption);
+        if (rc != CURVEFS_ERROR::OK) {
+            return rc;
+        }
+    }
+
     if (warmupManager_ != nullptr) {
         warmupManager_->Init(option);
         warmupManager_->SetFsInfo(fsInfo_);
@@ -194,6 +202,8 @@ void FuseClient::UnInit() {
         warmupManager_->UnInit();
     }
 
+    dentryManager_->UnInit();
+
     delete mdsBase_;
     mdsBase_ = nullptr;
 
@@ -439,7 +449,14 @@ CURVEFS_ERROR FuseClient::MakeNode(
         dentry.set_flag(DentryFlag::TYPE_FILE_FLAG);
     }
 
-    ret = dentryManager_->CreateDentry(dentry);
+    // only creating of regular file is deferred, because directories
+    // are the parents of following creates
+    if (option_.fileSystemOption.deferSyncOption.deferCreate &&
+        (type == FsFileType::TYPE_FILE || type == FsFileType::TYPE_S3)) {
+        ret = dentryManager_->DeferCreateDentry(dentry);
+    } else {
+        ret = dentryManager_->CreateDentry(dentry);
+    }
     if (ret != CURVEFS_ERROR::OK) {
         LOG(ERROR) << "dentryManager_ CreateDentry fail, ret = " << ret
                    << ", parent = " << parent << ", name = " << name
@@ -917,6 +934,12 @@ CURVEFS_ERROR FuseClient::FuseOpRename(fuse_req_t req, fuse_ino_t parent,
         return CURVEFS_ERROR::NAMETOOLONG;
     }
 
+    // rename transaction works on the dentries in metaserver
+    dentryManager_->WaitPendingDentry(parent);
+    if (newparent != parent) {
+        dentryManager_->WaitPendingDentry(newparent);
+    }
+
     auto renameOp =
         RenameOperator(fsInfo_->fsid(), fsInfo_->fsname(),
                        parent, name, newparent, newname,
@@ -1348,11 +1371,18 @@ CURVEFS_ERROR FuseClient::FuseOpReadLink(fuse_req_t req, fuse_ino_t ino,
 CURVEFS_ERROR FuseClient::FuseOpRelease(fuse_req_t req,
                                         fuse_ino_t ino,
                                         struct fuse_file_info *fi) {
+    // close-to-open: the file should be visible to other clients
+    CURVEFS_ERROR pending = CURVEFS_ERROR::OK;
+    if (FLAGS_enableCto) {
+        pending = dentryManager_->WaitPendingInode(ino);
+    }
+
     CURVEFS_ERROR rc = fs_->Release(req, ino);
     if (rc != CURVEFS_ERROR::OK) {
         LOG(ERROR) << "release() failed, ino = " << ino;
+        return rc;
     }
-    return rc;
+    return pending;
 }
 
 void FuseClient::FlushAll() {
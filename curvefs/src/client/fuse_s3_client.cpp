@@ -22,10 +22,13 @@
 
 
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "absl/memory/memory.h"
 #include "curvefs/src/client/fuse_s3_client.h"
 #include "curvefs/src/client/kvclient/memcache_client.h"
+#include "curvefs/src/client/kvclient/peer_cache_client.h"
 
 namespace curvefs {
 namespace client {
@@ -45,6 +48,11 @@ using curvefs::client::common::FLAGS_supportKVcache;
 using curvefs::client::common::FLAGS_enableCto;
 using curvefs::mds::topology::MemcacheClusterInfo;
 using curvefs::mds::topology::MemcacheServerInfo;
+using curvefs::mds::FsInfo;
+using curvefs::mds::FSStatusCode;
+using curvefs::mds::FSStatusCode_Name;
+
+static constexpr uint32_t kPeerCacheMaxPort = 65535;
 
 CURVEFS_ERROR FuseS3Client::Init(const FuseClientOption &option) {
     FuseClientOption opt(option);
@@ -54,8 +62,13 @@ CURVEFS_ERROR FuseS3Client::Init(const FuseClientOption &option) {
         return ret;
     }
 
-    // init kvcache
-    if (FLAGS_supportKVcache && !InitKVCache(option.kvClientManagerOpt)) {
+    // init kvcache, peer cache takes the place of memcache if enabled
+    if (option.peerCacheOpt.enable) {
+        if (!InitPeerCache(option)) {
+            return CURVEFS_ERROR::INTERNAL;
+        }
+    } else if (FLAGS_supportKVcache &&
+               !InitKVCache(option.kvClientManagerOpt)) {
         return CURVEFS_ERROR::INTERNAL;
     }
 
@@ -80,7 +93,8 @@ CURVEFS_ERROR FuseS3Client::Init(const FuseClientOption &option) {
     auto fsCacheManager = std::make_shared<FsCacheManager>(
         dynamic_cast<S3ClientAdaptorImpl *>(s3Adaptor_.get()),
         opt.s3Opt.s3ClientAdaptorOpt.readCacheMaxByte, writeCacheMaxByte,
-        opt.s3Opt.s3ClientAdaptorOpt.readCacheThreads, kvClientManager_);
+        opt.s3Opt.s3ClientAdaptorOpt.readCacheThreads, kvClientManager_,
+        opt.s3Opt.s3ClientAdaptorOpt.readCacheShards);
     if (opt.s3Opt.s3ClientAdaptorOpt.diskCacheOpt.diskCacheType !=
         DiskCacheType::Disable) {
         auto s3DiskCacheClient = std::make_shared<S3ClientImpl>();
@@ -136,9 +150,76 @@ bool FuseS3Client::InitKVCache(const KVClientManagerOpt &opt) {
     return true;
 }
 
+bool FuseS3Client::InitPeerCache(const FuseClientOption &option) {
+    const auto &opt = option.peerCacheOpt;
+    auto store = std::make_shared<PeerCacheStore>(opt.memoryMaxByte);
+
+    peerCacheService_ = absl::make_unique<PeerCacheServiceImpl>(store);
+    peerCacheServer_ = absl::make_unique<brpc::Server>();
+    if (peerCacheServer_->AddService(peerCacheService_.get(),
+                                     brpc::SERVER_DOESNT_OWN_SERVICE) != 0) {
+        LOG(ERROR) << "Add peer cache service failed";
+        return false;
+    }
+
+    brpc::ServerOptions serverOptions;
+    brpc::PortRange ports(opt.listenPort, kPeerCacheMaxPort);
+    if (peerCacheServer_->Start(ports, &serverOptions) != 0) {
+        LOG(ERROR) << "Start peer cache server failed, listenPort = "
+                   << opt.listenPort;
+        return false;
+    }
+
+    // the address is registered to mds along with the mountpoint,
+    // so the other clients of the fs can find it
+    const std::string self =
+        curve::client::ClientDummyServerInfo::GetInstance().GetIP() + ":" +
+        std::to_string(peerCacheServer_->listen_address().port);
+    mountpoint_.set_peercacheaddr(self);
+
+    auto fetcher = [this](std::vector<std::string> *peers) {
+        FsInfo fsInfo;
+        FSStatusCode rc = mdsClient_->GetFsInfo(fsInfo_->fsid(), &fsInfo);
+        if (rc != FSStatusCode::OK) {
+            LOG(WARNING) << "Get fsinfo failed, fsid = " << fsInfo_->fsid()
+                         << ", rc = " << FSStatusCode_Name(rc);
+            return false;
+        }
+        for (const auto &mountpoint : fsInfo.mountpoints()) {
+            if (mountpoint.has_peercacheaddr()) {
+                peers->push_back(mountpoint.peercacheaddr());
+            }
+        }
+        return true;
+    };
+
+    auto peerCacheClient = std::make_shared<PeerCacheClient>();
+    if (!peerCacheClient->Init(opt, self, store, fetcher)) {
+        LOG(ERROR) << "Init peer cache client failed";
+        return false;
+    }
+
+    kvClientManager_ = std::make_shared<KVClientManager>();
+    if (!kvClientManager_->Init(option.kvClientManagerOpt, peerCacheClient)) {
+        LOG(ERROR) << "Init kvClientManager for peer cache failed";
+        return false;
+    }
+
+    if (warmupManager_ != nullptr) {
+        warmupManager_->SetKVClientManager(kvClientManager_);
+    }
+
+    LOG(INFO) << "Init peer cache success, address = " << self;
+    return true;
+}
+
 void FuseS3Client::UnInit() {
     FuseClient::UnInit();
     s3Adaptor_->Stop();
+    if (peerCacheServer_ != nullptr) {
+        peerCacheServer_->Stop(0);
+        peerCacheServer_->Join();
+    }
     curve::common::S3Adapter::Shutdown();
 }
 
@@ -353,6 +434,10 @@ CURVEFS_ERROR FuseS3Client::FuseOpFsync(fuse_req_t req, fuse_ino_t ino,
                    << ", inodeid = " << ino;
         return ret;
     }
+    ret = dentryManager_->WaitPendingInode(ino);
+    if (ret != CURVEFS_ERROR::OK) {
+        return ret;
+    }
     if (datasync != 0) {
         return CURVEFS_ERROR::OK;
     }
@@ -24,6 +24,8 @@
 #ifndef CURVEFS_SRC_CLIENT_FUSE_S3_CLIENT_H_
 #define CURVEFS_SRC_CLIENT_FUSE_S3_CLIENT_H_
 
+#include <brpc/server.h>
+
 #include <memory>
 #include <string>
 #include <list>
@@ -31,6 +33,7 @@
 #include <utility>
 
 #include "curvefs/src/client/fuse_client.h"
+#include "curvefs/src/client/kvclient/peer_cache_service.h"
 #include "curvefs/src/client/s3/client_s3_cache_manager.h"
 #include "curvefs/src/client/warmup/warmup_manager.h"
 #include "curvefs/src/volume/common.h"
@@ -123,12 +126,18 @@ class FuseS3Client : public FuseClient {
  private:
     bool InitKVCache(const KVClientManagerOpt &opt);
 
+    bool InitPeerCache(const FuseClientOption &option);
+
     void FlushData() override;
 
  private:
     // s3 adaptor
     std::shared_ptr<S3ClientAdaptor> s3Adaptor_;
     std::shared_ptr<KVClientManager> kvClientManager_;
+    // serve the blocks of peer cache to the other clients,
+    // the service must outlive the server
+    std::unique_ptr<PeerCacheServiceImpl> peerCacheService_;
+    std::unique_ptr<brpc::Server> peerCacheServer_;
 
     static constexpr auto MIN_WRITE_CACHE_SIZE = 8 * kMiB;
 };
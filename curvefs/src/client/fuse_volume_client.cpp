@@ -306,6 +306,10 @@ CURVEFS_ERROR FuseVolumeClient::FuseOpFsync(fuse_req_t req, fuse_ino_t ino,
         LOG(ERROR) << "Storage flush ino: " << ino << " failed, error: " << ret;
         return ret;
     }
+    ret = dentryManager_->WaitPendingInode(ino);
+    if (ret != CURVEFS_ERROR::OK) {
+        return ret;
+    }
 
     if (datasync) {
         VLOG(3) << "FuseOpFsync end, ino: " << ino
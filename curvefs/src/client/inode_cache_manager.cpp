@@ -76,6 +76,10 @@ InodeCacheManagerImpl::GetInode(uint64_t inodeId,
         return CURVEFS_ERROR::OK;
     }
 
+    if (GetInodeFromLease(inodeId, &out)) {
+        return CURVEFS_ERROR::OK;
+    }
+
     // get inode from metaserver
     Inode inode;
     bool streaming = false;
@@ -87,9 +91,64 @@ InodeCacheManagerImpl::GetInode(uint64_t inodeId,
     // refresh data
     REFRESH_DATA_REMOTE(out, streaming);
 
+    PutInodeLease(out);
     return CURVEFS_ERROR::OK;
 }
 
+bool InodeCacheManagerImpl::GetInodeFromLease(
+    uint64_t inodeId, std::shared_ptr<InodeWrapper>* out) {
+    InodeLease lease;
+    if (leases_ == nullptr || !leases_->Get(inodeId, &lease)) {
+        return false;
+    }
+
+    uint64_t now = TimeUtility::GetTimeofDayMs();
+    if (!FLAGS_enableCto && now < lease.expireMs) {
+        *out = lease.inode;
+        return true;
+    }
+
+    // revalidate, the attribute is much cheaper than the whole inode
+    std::set<uint64_t> inodeIds{inodeId};
+    std::list<InodeAttr> attrs;
+    MetaStatusCode ret =
+        metaClient_->BatchGetInodeAttr(fsId_, inodeIds, &attrs);
+    if (ret != MetaStatusCode::OK || attrs.size() != 1) {
+        leases_->Remove(inodeId);
+        return false;
+    }
+
+    InodeAttr cached;
+    lease.inode->GetInodeAttr(&cached);
+    const InodeAttr& remote = attrs.front();
+    if (cached.length() != remote.length() ||
+        cached.mtime() != remote.mtime() ||
+        cached.mtime_ns() != remote.mtime_ns() ||
+        cached.ctime() != remote.ctime() ||
+        cached.ctime_ns() != remote.ctime_ns()) {
+        VLOG(6) << "inode lease is stale, inodeId = " << inodeId;
+        leases_->Remove(inodeId);
+        return false;
+    }
+
+    lease.expireMs = now + option_.inodeLeaseMs;
+    leases_->Put(inodeId, lease);
+    *out = lease.inode;
+    return true;
+}
+
+void InodeCacheManagerImpl::PutInodeLease(
+    const std::shared_ptr<InodeWrapper>& inode) {
+    if (leases_ == nullptr || inode->GetType() != FsFileType::TYPE_S3) {
+        return;
+    }
+
+    InodeLease lease;
+    lease.inode = inode;
+    lease.expireMs = TimeUtility::GetTimeofDayMs() + option_.inodeLeaseMs;
+    leases_->Put(inode->GetInodeId(), lease);
+}
+
 CURVEFS_ERROR InodeCacheManagerImpl::GetInodeAttr(uint64_t inodeId,
                                                   InodeAttr *out) {
     NameLockGuard lock(nameLock_, std::to_string(inodeId));
@@ -221,6 +280,9 @@ CURVEFS_ERROR InodeCacheManagerImpl::CreateManageInode(
 
 CURVEFS_ERROR InodeCacheManagerImpl::DeleteInode(uint64_t inodeId) {
     NameLockGuard lock(nameLock_, std::to_string(inodeId));
+    if (leases_ != nullptr) {
+        leases_->Remove(inodeId);
+    }
     MetaStatusCode ret = metaClient_->DeleteInode(fsId_, inodeId);
     if (ret != MetaStatusCode::OK && ret != MetaStatusCode::NOT_FOUND) {
         LOG(ERROR) << "metaClient_ DeleteInode failed, MetaStatusCode = " << ret
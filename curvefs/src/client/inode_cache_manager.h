@@ -133,6 +133,11 @@ class InodeCacheManagerImpl : public InodeCacheManager,
         s3ChunkInfoMetric_ = std::make_shared<S3ChunkInfoMetric>();
         openFiles_ =  openFiles;
         deferSync_ = deferSync;
+        if (option_.inodeLeaseMs > 0) {
+            leases_ = std::make_shared<LRUCache<uint64_t, InodeLease>>(
+                option_.inodeLeaseCacheSize,
+                std::make_shared<CacheMetrics>("inode_lease"));
+        }
         return CURVEFS_ERROR::OK;
     }
 
@@ -166,7 +171,23 @@ class InodeCacheManagerImpl : public InodeCacheManager,
     CURVEFS_ERROR RefreshData(std::shared_ptr<InodeWrapper> &inode,  // NOLINT
                               bool streaming = true);
 
+    // An inode of regular file is kept with a lease after it's fetched,
+    // so reopening it doesn't fetch its s3 chunk info again:
+    //  - within the lease, it's used directly unless cto is enabled
+    //  - otherwise it's revalidated by the attribute from metaserver,
+    //    it's reused if the length, mtime and ctime are not changed
+    // Please use it with the name lock of the inode.
+    bool GetInodeFromLease(uint64_t inodeId,
+                           std::shared_ptr<InodeWrapper>* out);
+
+    void PutInodeLease(const std::shared_ptr<InodeWrapper>& inode);
+
  private:
+    struct InodeLease {
+        std::shared_ptr<InodeWrapper> inode;
+        uint64_t expireMs;
+    };
+
     std::shared_ptr<MetaServerClient> metaClient_;
     std::shared_ptr<S3ChunkInfoMetric> s3ChunkInfoMetric_;
 
@@ -179,6 +200,8 @@ class InodeCacheManagerImpl : public InodeCacheManager,
     curve::common::GenericNameLock<Mutex> asyncNameLock_;
 
     RefreshDataOption option_;
+
+    std::shared_ptr<LRUCache<uint64_t, InodeLease>> leases_;
 };
 
 class BatchGetInodeAttrAsyncDone : public BatchGetInodeAttrDone {
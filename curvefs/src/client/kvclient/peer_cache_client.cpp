@@ -0,0 +1,204 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-30
+ * Author: curve
+ */
+
+#include "curvefs/src/client/kvclient/peer_cache_client.h"
+
+#include <brpc/controller.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "curvefs/proto/peer_cache.pb.h"
+
+namespace curvefs {
+namespace client {
+
+using ::curve::common::LockGuard;
+
+bool PeerCacheClient::Init(const PeerCacheOption& option,
+                           const std::string& self,
+                           std::shared_ptr<PeerCacheStore> store,
+                           PeerFetcher fetcher) {
+    option_ = option;
+    self_ = self;
+    store_ = std::move(store);
+    fetcher_ = std::move(fetcher);
+    ring_.reset(new PeerCacheRing(option_.virtualNodes));
+
+    // the client itself is always a peer, even if it's not mounted yet
+    RefreshPeers();
+
+    running_.store(true);
+    refreshThread_ = std::thread(&PeerCacheClient::RefreshTask, this);
+    LOG(INFO) << "Init peer cache client success, self = " << self_;
+    return true;
+}
+
+void PeerCacheClient::UnInit() {
+    if (running_.exchange(false)) {
+        sleeper_.interrupt();
+        refreshThread_.join();
+    }
+}
+
+void PeerCacheClient::RefreshTask() {
+    auto interval = std::chrono::seconds(option_.refreshIntervalSec);
+    while (sleeper_.wait_for(interval)) {
+        RefreshPeers();
+    }
+}
+
+void PeerCacheClient::RefreshPeers() {
+    std::vector<std::string> peers;
+    if (!fetcher_(&peers)) {
+        LOG(WARNING) << "Fetch peers of peer cache failed, keep the old ones";
+        return;
+    }
+    peers.push_back(self_);
+
+    if (!ring_->Update(peers)) {
+        return;
+    }
+
+    peers = ring_->GetPeers();
+    LOG(INFO) << "Peers of peer cache changed, count = " << peers.size();
+
+    // drop the channels to the peers which have left
+    LockGuard lk(channelMtx_);
+    for (auto it = channels_.begin(); it != channels_.end();) {
+        if (std::find(peers.begin(), peers.end(), it->first) == peers.end()) {
+            it = channels_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::shared_ptr<brpc::Channel> PeerCacheClient::GetChannel(
+    const std::string& peer, std::string* errorlog) {
+    LockGuard lk(channelMtx_);
+    auto it = channels_.find(peer);
+    if (it != channels_.end()) {
+        return it->second;
+    }
+
+    auto channel = std::make_shared<brpc::Channel>();
+    brpc::ChannelOptions options;
+    options.timeout_ms = option_.rpcTimeoutMs;
+    // the block is read from s3 if the peer doesn't respond in time,
+    // there is no point to retry
+    options.max_retry = 0;
+    if (channel->Init(peer.c_str(), &options) != 0) {
+        *errorlog = "init channel to " + peer + " failed";
+        return nullptr;
+    }
+    channels_.emplace(peer, channel);
+    return channel;
+}
+
+bool PeerCacheClient::Set(const std::string& key, const char* value,
+                          const uint64_t value_len, std::string* errorlog) {
+    std::string peer;
+    if (!ring_->Locate(key, &peer)) {
+        *errorlog = "no peer";
+        return false;
+    }
+
+    if (peer == self_) {
+        store_->Put(key, value, value_len);
+        return true;
+    }
+
+    auto channel = GetChannel(peer, errorlog);
+    if (channel == nullptr) {
+        return false;
+    }
+
+    brpc::Controller cntl;
+    PutBlockRequest request;
+    PutBlockResponse response;
+    request.set_key(key);
+    cntl.request_attachment().append(value, value_len);
+    PeerCacheService_Stub stub(channel.get());
+    stub.PutBlock(&cntl, &request, &response, nullptr);
+    if (cntl.Failed()) {
+        *errorlog = cntl.ErrorText();
+        return false;
+    }
+    if (response.statuscode() != PEER_CACHE_OK) {
+        *errorlog = PeerCacheStatusCode_Name(response.statuscode());
+        return false;
+    }
+    return true;
+}
+
+bool PeerCacheClient::Get(const std::string& key, char* value,
+                          uint64_t offset, uint64_t length,
+                          std::string* errorlog) {
+    std::string peer;
+    if (!ring_->Locate(key, &peer)) {
+        *errorlog = "no peer";
+        return false;
+    }
+
+    if (peer == self_) {
+        if (!store_->Get(key, offset, length, value)) {
+            *errorlog = PeerCacheStatusCode_Name(PEER_CACHE_MISS);
+            return false;
+        }
+        return true;
+    }
+
+    auto channel = GetChannel(peer, errorlog);
+    if (channel == nullptr) {
+        return false;
+    }
+
+    brpc::Controller cntl;
+    GetBlockRequest request;
+    GetBlockResponse response;
+    request.set_key(key);
+    request.set_offset(offset);
+    request.set_length(length);
+    PeerCacheService_Stub stub(channel.get());
+    stub.GetBlock(&cntl, &request, &response, nullptr);
+    if (cntl.Failed()) {
+        *errorlog = cntl.ErrorText();
+        return false;
+    }
+    if (response.statuscode() != PEER_CACHE_OK) {
+        *errorlog = PeerCacheStatusCode_Name(response.statuscode());
+        return false;
+    }
+    if (cntl.response_attachment().size() != length) {
+        *errorlog = "unexpected length of block from " + peer;
+        return false;
+    }
+
+    cntl.response_attachment().copy_to(value, length);
+    return true;
+}
+
+}  // namespace client
+}  // namespace curvefs
@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-30
+ * Author: curve
+ */
+
+#ifndef CURVEFS_SRC_CLIENT_KVCLIENT_PEER_CACHE_CLIENT_H_
+#define CURVEFS_SRC_CLIENT_KVCLIENT_PEER_CACHE_CLIENT_H_
+
+#include <brpc/channel.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "curvefs/src/client/common/config.h"
+#include "curvefs/src/client/kvclient/kvclient.h"
+#include "curvefs/src/client/kvclient/peer_cache_ring.h"
+#include "curvefs/src/client/kvclient/peer_cache_store.h"
+#include "src/common/concurrent/concurrent.h"
+#include "src/common/interruptible_sleeper.h"
+
+namespace curvefs {
+namespace client {
+
+using ::curve::common::InterruptibleSleeper;
+using ::curvefs::client::common::PeerCacheOption;
+
+// fetch the peers ("host:port") of the fs, including this client itself
+using PeerFetcher = std::function<bool(std::vector<std::string>*)>;
+
+/**
+ * PeerCacheClient is a kvclient backed by the other clients of the same fs,
+ * every block is owned by one of the clients which is located on a
+ * consistent hashing ring, the owner keeps it in memory and serves it
+ * to the others by PeerCacheService.
+ *
+ * A miss or a failed rpc simply returns false, and the caller reads
+ * the block from s3 as before.
+ */
+class PeerCacheClient : public KVClient {
+ public:
+    PeerCacheClient() = default;
+    ~PeerCacheClient() { UnInit(); }
+
+    /**
+     * @param: self: the address of this client, it's served from |store|
+     *         directly instead of a rpc
+     */
+    bool Init(const PeerCacheOption& option, const std::string& self,
+              std::shared_ptr<PeerCacheStore> store, PeerFetcher fetcher);
+
+    void UnInit() override;
+
+    bool Set(const std::string& key, const char* value,
+             const uint64_t value_len, std::string* errorlog) override;
+
+    bool Get(const std::string& key, char* value, uint64_t offset,
+             uint64_t length, std::string* errorlog) override;
+
+ private:
+    std::shared_ptr<brpc::Channel> GetChannel(const std::string& peer,
+                                              std::string* errorlog);
+
+    void RefreshPeers();
+
+    void RefreshTask();
+
+ private:
+    PeerCacheOption option_;
+    std::string self_;
+    std::shared_ptr<PeerCacheStore> store_;
+    PeerFetcher fetcher_;
+    std::unique_ptr<PeerCacheRing> ring_;
+
+    curve::common::Mutex channelMtx_;
+    std::unordered_map<std::string, std::shared_ptr<brpc::Channel>> channels_;
+
+    std::atomic<bool> running_{false};
+    std::thread refreshThread_;
+    InterruptibleSleeper sleeper_;
+};
+
+}  // namespace client
+}  // namespace curvefs
+
+#endif  // CURVEFS_SRC_CLIENT_KVCLIENT_PEER_CACHE_CLIENT_H_
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-30
+ * Author: curve
+ */
+
+#include "curvefs/src/client/kvclient/peer_cache_ring.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace curvefs {
+namespace client {
+
+using ::curve::common::ReadLockGuard;
+using ::curve::common::WriteLockGuard;
+
+PeerCacheRing::PeerCacheRing(uint32_t virtualNodes)
+    : virtualNodes_(std::max<uint32_t>(virtualNodes, 1)) {}
+
+// FNV-1a with a final mix of murmur3, it's stable across processes and
+// machines, which std::hash doesn't promise
+uint64_t PeerCacheRing::Hash(const std::string& data) {
+    uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : data) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+bool PeerCacheRing::Update(std::vector<std::string> peers) {
+    std::sort(peers.begin(), peers.end());
+    peers.erase(std::unique(peers.begin(), peers.end()), peers.end());
+
+    std::map<uint64_t, std::string> ring;
+    for (const auto& peer : peers) {
+        for (uint32_t i = 0; i < virtualNodes_; i++) {
+            // on collision, the smaller peer wins on every client
+            ring.emplace(Hash(peer + "#" + std::to_string(i)), peer);
+        }
+    }
+
+    WriteLockGuard lk(rwLock_);
+    if (peers == peers_) {
+        return false;
+    }
+    peers_ = std::move(peers);
+    ring_ = std::move(ring);
+    return true;
+}
+
+bool PeerCacheRing::Locate(const std::string& key, std::string* peer) const {
+    uint64_t h = Hash(key);
+    ReadLockGuard lk(rwLock_);
+    if (ring_.empty()) {
+        return false;
+    }
+    auto it = ring_.lower_bound(h);
+    if (it == ring_.end()) {
+        it = ring_.begin();
+    }
+    *peer = it->second;
+    return true;
+}
+
+std::vector<std::string> PeerCacheRing::GetPeers() const {
+    ReadLockGuard lk(rwLock_);
+    return peers_;
+}
+
+}  // namespace client
+}  // namespace curvefs
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-30
+ * Author: curve
+ */
+
+#ifndef CURVEFS_SRC_CLIENT_KVCLIENT_PEER_CACHE_RING_H_
+#define CURVEFS_SRC_CLIENT_KVCLIENT_PEER_CACHE_RING_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "src/common/concurrent/rw_lock.h"
+
+namespace curvefs {
+namespace client {
+
+// PeerCacheRing maps block keys to the peers of a fs by consistent hashing,
+// every peer is placed on the ring |virtualNodes| times, so a joining or
+// leaving peer only moves about 1/n of the keys.
+//
+// The hash is computed by the ring itself instead of std::hash, because
+// all clients of a fs must agree on the owner of a key.
+class PeerCacheRing {
+ public:
+    explicit PeerCacheRing(uint32_t virtualNodes);
+
+    // Replace the peers on the ring, peer is "host:port".
+    // Return false if the peers are not changed.
+    bool Update(std::vector<std::string> peers);
+
+    // Return false if there is no peer on the ring
+    bool Locate(const std::string& key, std::string* peer) const;
+
+    std::vector<std::string> GetPeers() const;
+
+    static uint64_t Hash(const std::string& data);
+
+ private:
+    mutable curve::common::RWLock rwLock_;
+    uint32_t virtualNodes_;
+    std::vector<std::string> peers_;  // sorted
+    std::map<uint64_t, std::string> ring_;
+};
+
+}  // namespace client
+}  // namespace curvefs
+
+#endif  // CURVEFS_SRC_CLIENT_KVCLIENT_PEER_CACHE_RING_H_
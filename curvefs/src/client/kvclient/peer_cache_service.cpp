@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-30
+ * Author: curve
+ */
+
+#include "curvefs/src/client/kvclient/peer_cache_service.h"
+
+#include <brpc/closure_guard.h>
+#include <brpc/controller.h>
+
+#include <memory>
+#include <string>
+
+namespace curvefs {
+namespace client {
+
+void PeerCacheServiceImpl::GetBlock(
+    google::protobuf::RpcController* cntl_base,
+    const GetBlockRequest* request,
+    GetBlockResponse* response,
+    google::protobuf::Closure* done) {
+    brpc::ClosureGuard doneGuard(done);
+    brpc::Controller* cntl = static_cast<brpc::Controller*>(cntl_base);
+
+    uint64_t length = request->length();
+    if (length == 0 || length > store_->GetMaxBytes()) {
+        response->set_statuscode(PEER_CACHE_INVALID_PARAM);
+        return;
+    }
+
+    std::unique_ptr<char[]> buf(new char[length]);
+    if (!store_->Get(request->key(), request->offset(), length, buf.get())) {
+        response->set_statuscode(PEER_CACHE_MISS);
+        return;
+    }
+
+    cntl->response_attachment().append(buf.get(), length);
+    response->set_statuscode(PEER_CACHE_OK);
+}
+
+void PeerCacheServiceImpl::PutBlock(
+    google::protobuf::RpcController* cntl_base,
+    const PutBlockRequest* request,
+    PutBlockResponse* response,
+    google::protobuf::Closure* done) {
+    brpc::ClosureGuard doneGuard(done);
+    brpc::Controller* cntl = static_cast<brpc::Controller*>(cntl_base);
+
+    const std::string data = cntl->request_attachment().to_string();
+    if (data.empty()) {
+        response->set_statuscode(PEER_CACHE_INVALID_PARAM);
+        return;
+    }
+
+    store_->Put(request->key(), data.data(), data.size());
+    response->set_statuscode(PEER_CACHE_OK);
+}
+
+}  // namespace client
+}  // namespace curvefs
@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-30
+ * Author: curve
+ */
+
+#ifndef CURVEFS_SRC_CLIENT_KVCLIENT_PEER_CACHE_SERVICE_H_
+#define CURVEFS_SRC_CLIENT_KVCLIENT_PEER_CACHE_SERVICE_H_
+
+#include <memory>
+#include <utility>
+
+#include "curvefs/proto/peer_cache.pb.h"
+#include "curvefs/src/client/kvclient/peer_cache_store.h"
+
+namespace curvefs {
+namespace client {
+
+class PeerCacheServiceImpl : public PeerCacheService {
+ public:
+    explicit PeerCacheServiceImpl(std::shared_ptr<PeerCacheStore> store)
+        : store_(std::move(store)) {}
+
+    void GetBlock(google::protobuf::RpcController* cntl_base,
+                  const GetBlockRequest* request,
+                  GetBlockResponse* response,
+                  google::protobuf::Closure* done) override;
+
+    void PutBlock(google::protobuf::RpcController* cntl_base,
+                  const PutBlockRequest* request,
+                  PutBlockResponse* response,
+                  google::protobuf::Closure* done) override;
+
+ private:
+    std::shared_ptr<PeerCacheStore> store_;
+};
+
+}  // namespace client
+}  // namespace curvefs
+
+#endif  // CURVEFS_SRC_CLIENT_KVCLIENT_PEER_CACHE_SERVICE_H_
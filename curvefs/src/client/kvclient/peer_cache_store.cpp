@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-30
+ * Author: curve
+ */
+
+#include "curvefs/src/client/kvclient/peer_cache_store.h"
+
+#include <cstring>
+
+namespace curvefs {
+namespace client {
+
+using ::curve::common::LockGuard;
+
+void PeerCacheStore::Put(const std::string& key, const char* data,
+                         uint64_t length) {
+    if (length > maxBytes_) {
+        return;
+    }
+
+    LockGuard lk(mtx_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        bytes_ -= it->second->second.size();
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+
+    lru_.emplace_front(key, std::string(data, length));
+    index_.emplace(key, lru_.begin());
+    bytes_ += length;
+
+    while (bytes_ > maxBytes_) {
+        auto& victim = lru_.back();
+        bytes_ -= victim.second.size();
+        index_.erase(victim.first);
+        lru_.pop_back();
+    }
+}
+
+bool PeerCacheStore::Get(const std::string& key, uint64_t offset,
+                         uint64_t length, char* data) {
+    LockGuard lk(mtx_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        return false;
+    }
+
+    const std::string& block = it->second->second;
+    if (offset > block.size() || length > block.size() - offset) {
+        return false;
+    }
+
+    lru_.splice(lru_.begin(), lru_, it->second);
+    memcpy(data, block.data() + offset, length);
+    return true;
+}
+
+uint64_t PeerCacheStore::GetBytes() {
+    LockGuard lk(mtx_);
+    return bytes_;
+}
+
+size_t PeerCacheStore::Size() {
+    LockGuard lk(mtx_);
+    return index_.size();
+}
+
+}  // namespace client
+}  // namespace curvefs
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-30
+ * Author: curve
+ */
+
+#ifndef CURVEFS_SRC_CLIENT_KVCLIENT_PEER_CACHE_STORE_H_
+#define CURVEFS_SRC_CLIENT_KVCLIENT_PEER_CACHE_STORE_H_
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "src/common/concurrent/concurrent.h"
+
+namespace curvefs {
+namespace client {
+
+// PeerCacheStore keeps the blocks owned by this client in memory for the
+// peers of the fs, the least recently used blocks are evicted once the
+// total size exceeds |maxBytes|.
+class PeerCacheStore {
+ public:
+    explicit PeerCacheStore(uint64_t maxBytes) : maxBytes_(maxBytes) {}
+
+    void Put(const std::string& key, const char* data, uint64_t length);
+
+    // Copy [offset, offset + length) of the block to |data|,
+    // return false if the block is missing or shorter than the range
+    bool Get(const std::string& key, uint64_t offset, uint64_t length,
+             char* data);
+
+    uint64_t GetBytes();
+
+    uint64_t GetMaxBytes() const { return maxBytes_; }
+
+    size_t Size();
+
+ private:
+    using Entry = std::pair<std::string, std::string>;  // key, block
+
+    curve::common::Mutex mtx_;
+    uint64_t maxBytes_;
+    uint64_t bytes_ = 0;
+    std::list<Entry> lru_;  // most recently used comes first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+};
+
+}  // namespace client
+}  // namespace curvefs
+
+#endif  // CURVEFS_SRC_CLIENT_KVCLIENT_PEER_CACHE_STORE_H_
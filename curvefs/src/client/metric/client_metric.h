@@ -197,14 +197,34 @@ struct S3MultiManagerMetric {
     bvar::Adder<int64_t> writeDataCacheByte;
     bvar::Adder<int64_t> readDataCacheNum;
     bvar::Adder<int64_t> readDataCacheByte;
+    // blocks prefetched into disk cache, and how many of them are read
+    bvar::Adder<int64_t> prefetchBlockNum;
+    bvar::Adder<int64_t> prefetchHitBlockNum;
+    bvar::Adder<int64_t> prefetchInflightByte;
+    bvar::PassiveStatus<double> prefetchAccuracy;
+
+    static double GetPrefetchAccuracy(void* arg) {
+        auto* metric = static_cast<S3MultiManagerMetric*>(arg);
+        int64_t total = metric->prefetchBlockNum.get_value();
+        if (total <= 0) {
+            return 0;
+        }
+        return static_cast<double>(metric->prefetchHitBlockNum.get_value()) /
+               total;
+    }
 
-    S3MultiManagerMetric() {
+    S3MultiManagerMetric()
+        : prefetchAccuracy(GetPrefetchAccuracy, this) {
         fileManagerNum.expose_as(prefix, "file_manager_num");
         chunkManagerNum.expose_as(prefix, "chunk_manager_num");
         writeDataCacheNum.expose_as(prefix, "write_data_cache_num");
         writeDataCacheByte.expose_as(prefix, "write_data_cache_byte");
         readDataCacheNum.expose_as(prefix, "read_data_cache_num");
         readDataCacheByte.expose_as(prefix, "read_data_cache_byte");
+        prefetchBlockNum.expose_as(prefix, "prefetch_block_num");
+        prefetchHitBlockNum.expose_as(prefix, "prefetch_hit_block_num");
+        prefetchInflightByte.expose_as(prefix, "prefetch_inflight_byte");
+        prefetchAccuracy.expose_as(prefix, "prefetch_accuracy");
     }
 };
 
@@ -259,12 +279,15 @@ struct DiskCacheMetric {
     std::string fsName;
     InterfaceMetric writeS3;
     bvar::Status<uint64_t> diskUsedBytes;
+    bvar::Adder<uint64_t> admissionRejected;
 
     explicit DiskCacheMetric(const std::string &name = "")
         : fsName(!name.empty() ? name
                                : prefix + curve::common::ToHexString(this)),
           writeS3(prefix, fsName + "_write_s3"),
-          diskUsedBytes(prefix, fsName + "_diskcache_usedbytes", 0) {}
+          diskUsedBytes(prefix, fsName + "_diskcache_usedbytes", 0),
+          admissionRejected(prefix,
+                            fsName + "_diskcache_admission_rejected") {}
 };
 
 struct KVClientMetric {
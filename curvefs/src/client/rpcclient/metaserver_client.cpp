@@ -27,6 +27,7 @@
 #include <time.h>
 
 #include <cstddef>
+#include <iterator>
 #include <memory>
 #include <vector>
 #include <utility>
@@ -186,6 +187,21 @@ MetaStatusCode MetaServerClientImpl::ListDentry(uint32_t fsId, uint64_t inodeid,
                                                 const std::string &last,
                                                 uint32_t count, bool onlyDir,
                                                 std::list<Dentry> *dentryList) {
+    return ListDentryInternal(fsId, inodeid, last, count, onlyDir, dentryList,
+                              nullptr);
+}
+
+MetaStatusCode MetaServerClientImpl::ListDentryPlus(
+    uint32_t fsId, uint64_t inodeid, const std::string &last, uint32_t count,
+    std::list<Dentry> *dentryList, std::list<InodeAttr> *attrs) {
+    return ListDentryInternal(fsId, inodeid, last, count, false, dentryList,
+                              attrs);
+}
+
+MetaStatusCode MetaServerClientImpl::ListDentryInternal(
+    uint32_t fsId, uint64_t inodeid, const std::string &last, uint32_t count,
+    bool onlyDir, std::list<Dentry> *dentryList,
+    std::list<InodeAttr> *attrs) {
     auto task = RPCTask {
         (void)taskExecutorDone;
         metric_.listDentry.qps.count << 1;
@@ -202,6 +218,9 @@ MetaStatusCode MetaServerClientImpl::ListDentry(uint32_t fsId, uint64_t inodeid,
         request.set_count(count);
         request.set_onlydir(onlyDir);
         request.set_appliedindex(applyIndex);
+        if (attrs != nullptr) {
+            request.set_returnattr(true);
+        }
 
         curvefs::metaserver::MetaServerService_Stub stub(channel);
         stub.ListDentry(cntl, &request, &response, nullptr);
@@ -229,6 +248,11 @@ MetaStatusCode MetaServerClientImpl::ListDentry(uint32_t fsId, uint64_t inodeid,
             auto dentrys = response.dentrys();
             for_each(dentrys.begin(), dentrys.end(),
                      [&](Dentry &d) { dentryList->push_back(d); });
+            if (attrs != nullptr) {
+                auto *attr = response.mutable_attr();
+                std::move(attr->begin(), attr->end(),
+                          std::back_inserter(*attrs));
+            }
         } else {
             LOG(WARNING) << "ListDentry: fsId = " << fsId
                          << ", inodeid = " << inodeid << ", last = " << last
@@ -88,6 +88,14 @@ class MetaServerClient {
                                       bool onlyDir,
                                       std::list<Dentry> *dentryList) = 0;
 
+    // same as ListDentry, besides the attributes of inodes which belong to
+    // the partition of |inodeid| are also returned in |attrs|
+    virtual MetaStatusCode ListDentryPlus(uint32_t fsId, uint64_t inodeid,
+                                          const std::string &last,
+                                          uint32_t count,
+                                          std::list<Dentry> *dentryList,
+                                          std::list<InodeAttr> *attrs) = 0;
+
     virtual MetaStatusCode CreateDentry(const Dentry &dentry) = 0;
 
     virtual MetaStatusCode DeleteDentry(uint32_t fsId, uint64_t inodeid,
@@ -192,6 +200,11 @@ class MetaServerClientImpl : public MetaServerClient {
                               bool onlyDir,
                               std::list<Dentry> *dentryList) override;
 
+    MetaStatusCode ListDentryPlus(uint32_t fsId, uint64_t inodeid,
+                                  const std::string &last, uint32_t count,
+                                  std::list<Dentry> *dentryList,
+                                  std::list<InodeAttr> *attrs) override;
+
     MetaStatusCode CreateDentry(const Dentry &dentry) override;
 
     MetaStatusCode DeleteDentry(uint32_t fsId, uint64_t inodeid,
@@ -280,6 +293,12 @@ class MetaServerClientImpl : public MetaServerClient {
     void UpdateInodeAsync(const UpdateInodeRequest &request,
                           MetaServerClientDone *done);
 
+    MetaStatusCode ListDentryInternal(uint32_t fsId, uint64_t inodeid,
+                                      const std::string &last, uint32_t count,
+                                      bool onlyDir,
+                                      std::list<Dentry> *dentryList,
+                                      std::list<InodeAttr> *attrs);
+
     bool ParseS3MetaStreamBuffer(butil::IOBuf* buffer,
                                  uint64_t* chunkIndex,
                                  S3ChunkInfoList* list);
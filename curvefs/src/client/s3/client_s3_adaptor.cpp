@@ -45,6 +45,7 @@ S3ClientAdaptorImpl::Init(
     blockSize_ = option.blockSize;
     chunkSize_ = option.chunkSize;
     pageSize_ = option.pageSize;
+    pagePool_->Init(pageSize_, option.pagePoolMaxIdleByte);
     if (chunkSize_ % blockSize_ != 0) {
         LOG(ERROR) << "chunkSize:" << chunkSize_
                    << " is not integral multiple for the blockSize:"
@@ -52,6 +53,8 @@ S3ClientAdaptorImpl::Init(
         return CURVEFS_ERROR::INVALIDPARAM;
     }
     prefetchBlocks_ = option.prefetchBlocks;
+    prefetchMaxBlocks_ = option.prefetchMaxBlocks;
+    prefetchMaxInflightBytes_ = option.prefetchMaxInflightBytes;
     prefetchExecQueueNum_ = option.prefetchExecQueueNum;
     diskCacheType_ = option.diskCacheOpt.diskCacheType;
     memCacheNearfullRatio_ = option.nearfullRatio;
@@ -93,12 +96,15 @@ S3ClientAdaptorImpl::Init(
     LOG(INFO) << "S3ClientAdaptorImpl Init. block size:" << blockSize_
               << ", chunk size: " << chunkSize_
               << ", prefetchBlocks: " << prefetchBlocks_
+              << ", prefetchMaxBlocks: " << prefetchMaxBlocks_
+              << ", prefetchMaxInflightBytes: " << prefetchMaxInflightBytes_
               << ", prefetchExecQueueNum: " << prefetchExecQueueNum_
               << ", intervalSec: " << option.intervalSec
               << ", flushIntervalSec: " << option.flushIntervalSec
               << ", writeCacheMaxByte: " << option.writeCacheMaxByte
               << ", readCacheMaxByte: " << option.readCacheMaxByte
               << ", readCacheThreads: " << option.readCacheThreads
+              << ", pagePoolMaxIdleByte: " << option.pagePoolMaxIdleByte
               << ", nearfullRatio: " << option.nearfullRatio
               << ", baseSleepUs: " << option.baseSleepUs;
     // start chunk flush threads
@@ -340,6 +346,26 @@ int S3ClientAdaptorImpl::ExecAsyncDownloadTask(
     return 0;
 }
 
+bool S3ClientAdaptorImpl::AcquirePrefetchBytes(uint64_t len) {
+    if (prefetchMaxInflightBytes_ == 0) {
+        prefetchInflightBytes_.fetch_add(len, std::memory_order_relaxed);
+        return true;
+    }
+
+    uint64_t inflight = prefetchInflightBytes_.load(std::memory_order_relaxed);
+    do {
+        if (inflight + len > prefetchMaxInflightBytes_) {
+            return false;
+        }
+    } while (!prefetchInflightBytes_.compare_exchange_weak(
+        inflight, inflight + len, std::memory_order_relaxed));
+    return true;
+}
+
+void S3ClientAdaptorImpl::ReleasePrefetchBytes(uint64_t len) {
+    prefetchInflightBytes_.fetch_sub(len, std::memory_order_relaxed);
+}
+
 void S3ClientAdaptorImpl::InitMetrics(const std::string &fsName) {
     fsName_ = fsName;
     s3Metric_ = std::make_shared<S3Metric>(fsName);
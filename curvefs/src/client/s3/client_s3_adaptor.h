@@ -24,6 +24,7 @@
 
 #include <bthread/execution_queue.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -39,6 +40,7 @@
 #include "curvefs/src/client/s3/client_s3.h"
 #include "curvefs/src/client/s3/client_s3_cache_manager.h"
 #include "curvefs/src/client/s3/disk_cache_manager_impl.h"
+#include "curvefs/src/client/s3/page_pool.h"
 #include "src/common/wait_interval.h"
 namespace curvefs {
 namespace client {
@@ -163,6 +165,12 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
     uint32_t GetPrefetchBlocks() {
         return prefetchBlocks_;
     }
+    uint32_t GetPrefetchMaxBlocks() {
+        return prefetchMaxBlocks_;
+    }
+    // reserve |len| bytes for prefetching, fail if it exceeds the limit
+    bool AcquirePrefetchBytes(uint64_t len);
+    void ReleasePrefetchBytes(uint64_t len);
     uint32_t GetDiskCacheType() {
         return diskCacheType_;
     }
@@ -206,6 +214,9 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
     uint32_t GetPageSize() {
         return pageSize_;
     }
+    std::shared_ptr<PagePool> GetPagePool() {
+        return pagePool_;
+    }
     void InitMetrics(const std::string &fsName);
     void CollectMetrics(InterfaceMetric *interface, int count, uint64_t start);
     void SetDiskCache(DiskCacheType type) {
@@ -250,6 +261,9 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
     uint64_t blockSize_;
     uint64_t chunkSize_;
     uint32_t prefetchBlocks_;
+    uint32_t prefetchMaxBlocks_ = 0;
+    uint64_t prefetchMaxInflightBytes_ = 0;
+    std::atomic<uint64_t> prefetchInflightBytes_{0};
     uint32_t prefetchExecQueueNum_;
     std::string allocateServerEps_;
     uint32_t flushIntervalSec_;
@@ -275,6 +289,7 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
     std::vector<bthread::ExecutionQueueId<AsyncDownloadTask>>
       downloadTaskQueues_;
     uint32_t pageSize_;
+    std::shared_ptr<PagePool> pagePool_ = std::make_shared<PagePool>();
 
     int FlushChunkClosure(std::shared_ptr<FlushChunkCacheContext> context);
 
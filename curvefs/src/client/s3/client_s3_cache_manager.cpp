@@ -50,32 +50,30 @@ namespace client {
 
 void FsCacheManager::DataCacheNumInc() {
     g_s3MultiManagerMetric->writeDataCacheNum << 1;
-    VLOG(9) << "DataCacheNumInc() v: 1,wDataCacheNum:"
-            << wDataCacheNum_.load(std::memory_order_relaxed);
-    wDataCacheNum_.fetch_add(1, std::memory_order_relaxed);
+    uint64_t prev = wDataCacheNum_.fetch_add(1, std::memory_order_relaxed);
+    VLOG(9) << "DataCacheNumInc() v: 1,wDataCacheNum:" << prev;
 }
 
 void FsCacheManager::DataCacheNumFetchSub(uint64_t v) {
     g_s3MultiManagerMetric->writeDataCacheNum << -1 * v;
-    VLOG(9) << "DataCacheNumFetchSub() v:" << v << ",wDataCacheNum_:"
-            << wDataCacheNum_.load(std::memory_order_relaxed);
-    assert(wDataCacheNum_.load(std::memory_order_relaxed) >= v);
-    wDataCacheNum_.fetch_sub(v, std::memory_order_relaxed);
+    uint64_t prev = wDataCacheNum_.fetch_sub(v, std::memory_order_relaxed);
+    VLOG(9) << "DataCacheNumFetchSub() v:" << v << ",wDataCacheNum_:" << prev;
+    assert(prev >= v);
+    (void)prev;
 }
 
 void FsCacheManager::DataCacheByteInc(uint64_t v) {
     g_s3MultiManagerMetric->writeDataCacheByte << v;
-    VLOG(9) << "DataCacheByteInc() v:" << v << ",wDataCacheByte:"
-            << wDataCacheByte_.load(std::memory_order_relaxed);
-    wDataCacheByte_.fetch_add(v, std::memory_order_relaxed);
+    uint64_t prev = wDataCacheByte_.fetch_add(v, std::memory_order_relaxed);
+    VLOG(9) << "DataCacheByteInc() v:" << v << ",wDataCacheByte:" << prev;
 }
 
 void FsCacheManager::DataCacheByteDec(uint64_t v) {
     g_s3MultiManagerMetric->writeDataCacheByte << -1 * v;
-    VLOG(9) << "DataCacheByteDec() v:" << v << ",wDataCacheByte:"
-            << wDataCacheByte_.load(std::memory_order_relaxed);
-    assert(wDataCacheByte_.load(std::memory_order_relaxed) >= v);
-    wDataCacheByte_.fetch_sub(v, std::memory_order_relaxed);
+    uint64_t prev = wDataCacheByte_.fetch_sub(v, std::memory_order_relaxed);
+    VLOG(9) << "DataCacheByteDec() v:" << v << ",wDataCacheByte:" << prev;
+    assert(prev >= v);
+    (void)prev;
 }
 
 FileCacheManagerPtr FsCacheManager::FindFileCacheManager(uint64_t inodeId) {
@@ -125,65 +123,86 @@ void FsCacheManager::ReleaseFileCacheManager(uint64_t inodeId) {
 
 bool FsCacheManager::Set(DataCachePtr dataCache,
                          std::list<DataCachePtr>::iterator *outIter) {
-    std::lock_guard<std::mutex> lk(lruMtx_);
-    VLOG(3) << "lru current byte:" << lruByte_
+    VLOG(3) << "lru current byte:" << lruByte_.load(std::memory_order_relaxed)
             << ",lru max byte:" << readCacheMaxByte_
             << ", dataCache len:" << dataCache->GetLen();
     if (readCacheMaxByte_ == 0) {
         return false;
     }
+
+    LruShard* shard = GetLruShard(dataCache.get());
     // trim cache without consider dataCache's size, because its size is
     // expected to be very smaller than `readCacheMaxByte_`
-    if (lruByte_ >= readCacheMaxByte_) {
-        uint64_t retiredBytes = 0;
-        auto iter = lruReadDataCacheList_.end();
+    if (lruByte_.load(std::memory_order_relaxed) >= readCacheMaxByte_) {
+        TrimReadCache(shard);
+    }
+
+    std::lock_guard<std::mutex> lk(shard->mtx);
+    lruByte_.fetch_add(dataCache->GetActualLen(), std::memory_order_relaxed);
+    dataCache->SetReadCacheState(true);
+    shard->list.push_front(std::move(dataCache));
+    *outIter = shard->list.begin();
+    return true;
+}
+
+void FsCacheManager::TrimReadCache(LruShard* first) {
+    // evict from the shard being inserted first, and then the others in turn
+    // if it is not enough, only one shard lock is held at the same time
+    size_t begin = 0;
+    while (lruShards_[begin].get() != first) {
+        ++begin;
+    }
+
+    uint64_t retiredBytes = 0;
+    std::list<DataCachePtr> retired;
+    for (size_t i = 0; i < lruShards_.size(); i++) {
+        if (lruByte_.load(std::memory_order_relaxed) < readCacheMaxByte_) {
+            break;
+        }
 
-        while (lruByte_ >= readCacheMaxByte_) {
+        LruShard* shard = lruShards_[(begin + i) % lruShards_.size()].get();
+        std::lock_guard<std::mutex> lk(shard->mtx);
+        auto iter = shard->list.end();
+        while (iter != shard->list.begin() &&
+               lruByte_.load(std::memory_order_relaxed) >= readCacheMaxByte_) {
             --iter;
             auto &trim = *iter;
             trim->SetReadCacheState(false);
-            lruByte_ -= trim->GetActualLen();
+            lruByte_.fetch_sub(trim->GetActualLen(), std::memory_order_relaxed);
             retiredBytes += trim->GetActualLen();
         }
 
-        std::list<DataCachePtr> retired;
-        retired.splice(retired.end(), lruReadDataCacheList_, iter,
-                       lruReadDataCacheList_.end());
-
-        VLOG(3) << "lru release " << retiredBytes << " bytes, retired "
-                << retired.size() << " data cache";
-
-        releaseReadCache_.Release(&retired);
+        retired.splice(retired.end(), shard->list, iter, shard->list.end());
     }
 
-    lruByte_ += dataCache->GetActualLen();
-    dataCache->SetReadCacheState(true);
-    lruReadDataCacheList_.push_front(std::move(dataCache));
-    *outIter = lruReadDataCacheList_.begin();
-    return true;
+    VLOG(3) << "lru release " << retiredBytes << " bytes, retired "
+            << retired.size() << " data cache";
+
+    releaseReadCache_.Release(&retired);
 }
 
 void FsCacheManager::Get(std::list<DataCachePtr>::iterator iter) {
-    std::lock_guard<std::mutex> lk(lruMtx_);
+    LruShard* shard = GetLruShard(iter->get());
+    std::lock_guard<std::mutex> lk(shard->mtx);
 
     if (!(*iter)->InReadCache()) {
         return;
     }
 
-    lruReadDataCacheList_.splice(lruReadDataCacheList_.begin(),
-                                 lruReadDataCacheList_, iter);
+    shard->list.splice(shard->list.begin(), shard->list, iter);
 }
 
 bool FsCacheManager::Delete(std::list<DataCachePtr>::iterator iter) {
-    std::lock_guard<std::mutex> lk(lruMtx_);
+    LruShard* shard = GetLruShard(iter->get());
+    std::lock_guard<std::mutex> lk(shard->mtx);
 
     if (!(*iter)->InReadCache()) {
         return false;
     }
 
     (*iter)->SetReadCacheState(false);
-    lruByte_ -= (*iter)->GetActualLen();
-    lruReadDataCacheList_.erase(iter);
+    lruByte_.fetch_sub((*iter)->GetActualLen(), std::memory_order_relaxed);
+    shard->list.erase(iter);
     return true;
 }
 
@@ -548,15 +567,21 @@ FileCacheManager::ReadKVRequest(const std::vector<S3ReadRequest> &kvRequests,
     std::atomic<bool> isCanceled{false};
     std::atomic<int> retCode{0};
 
-    for (const auto &req : kvRequests) {
-        readTaskPool_->Enqueue([&]() {
+    std::vector<PrefetchWindow> windows(kvRequests.size());
+    if (s3ClientAdaptor_->HasDiskCache()) {
+        TrackPrefetchWindows(kvRequests, &windows);
+    }
+
+    for (size_t i = 0; i < kvRequests.size(); i++) {
+        readTaskPool_->Enqueue([&, i]() {
+            const auto &req = kvRequests[i];
             auto defer = absl::MakeCleanup([&]() { counter.DecrementCount(); });
             if (isCanceled) {
                 LOG(WARNING) << "kv request is canceled " << req.DebugString();
                 return;
             }
-            ProcessKVRequest(req, dataBuf, fileLen, cancelFlag, isCanceled,
-                             retCode);
+            ProcessKVRequest(req, dataBuf, fileLen, windows[i], cancelFlag,
+                             isCanceled, retCode);
         });
     }
 
@@ -564,8 +589,35 @@ FileCacheManager::ReadKVRequest(const std::vector<S3ReadRequest> &kvRequests,
     return toReadStatus(retCode.load());
 }
 
+void FileCacheManager::TrackPrefetchWindows(
+    const std::vector<S3ReadRequest> &kvRequests,
+    std::vector<PrefetchWindow> *windows) {
+    const uint64_t blockSize = s3ClientAdaptor_->GetBlockSize();
+    const uint32_t minBlocks = s3ClientAdaptor_->GetPrefetchBlocks();
+    const uint32_t maxBlocks = s3ClientAdaptor_->GetPrefetchMaxBlocks();
+
+    // requests are processed concurrently, so track them in offset order
+    std::vector<size_t> order(kvRequests.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        return kvRequests[lhs].offset < kvRequests[rhs].offset;
+    });
+
+    for (auto i : order) {
+        const auto &req = kvRequests[i];
+        uint64_t firstBlock = req.offset / blockSize;
+        uint64_t lastBlock =
+            (req.offset + std::max<uint64_t>(req.len, 1) - 1) / blockSize;
+        (*windows)[i] = prefetchTracker_.Access(firstBlock, lastBlock,
+                                                minBlocks, maxBlocks);
+    }
+}
+
 void FileCacheManager::ProcessKVRequest(const S3ReadRequest &req, char *dataBuf,
                                         uint64_t fileLen,
+                                        const PrefetchWindow &prefetchWindow,
                                         std::once_flag &cancelFlag,
                                         std::atomic<bool> &isCanceled,
                                         std::atomic<int> &retCode) {
@@ -580,8 +632,8 @@ void FileCacheManager::ProcessKVRequest(const S3ReadRequest &req, char *dataBuf,
     GetBlockLoc(req.offset, &chunkIndex, &chunkPos, &blockIndex, &blockPos);
 
     // prefetch
-    if (s3ClientAdaptor_->HasDiskCache()) {
-        PrefetchForBlock(req, fileLen, blockSize, chunkSize, blockIndex);
+    if (s3ClientAdaptor_->HasDiskCache() && prefetchWindow.count > 0) {
+        PrefetchForBlock(req, fileLen, blockSize, chunkSize, prefetchWindow);
     }
 
     // read request
@@ -611,6 +663,7 @@ void FileCacheManager::ProcessKVRequest(const S3ReadRequest &req, char *dataBuf,
                                             blockPos - objectOffset,
                                             currentReadLen)) {
                 VLOG(9) << "read " << name << " from local cache ok";
+                RecordPrefetchHit(name);
                 break;
             }
 
@@ -661,24 +714,33 @@ void FileCacheManager::ProcessKVRequest(const S3ReadRequest &req, char *dataBuf,
 void FileCacheManager::PrefetchForBlock(const S3ReadRequest &req,
                                         uint64_t fileLen, uint64_t blockSize,
                                         uint64_t chunkSize,
-                                        uint64_t startBlockIndex) {
-    uint32_t prefetchBlocks = s3ClientAdaptor_->GetPrefetchBlocks();
+                                        const PrefetchWindow &window) {
     uint32_t objectPrefix = s3ClientAdaptor_->GetObjectPrefix();
     std::vector<std::pair<std::string, uint64_t>> prefetchObjs;
 
-    uint64_t blockIndex = startBlockIndex;
-    for (uint32_t i = 0; i < prefetchBlocks; i++) {
+    // blocks of the window are prefetched within the S3ChunkInfo of |req|,
+    // the object of a block only holds the part written by the S3ChunkInfo
+    const uint64_t blocksPerChunk = chunkSize / blockSize;
+    const uint64_t chunkFirstBlock = window.start / blocksPerChunk *
+                                     blocksPerChunk;
+    const uint64_t infoBegin = req.chunkInfoOffset;
+    const uint64_t infoEnd = std::min(req.chunkInfoOffset + req.chunkInfoLen,
+                                      fileLen);
+    uint64_t blockIndex = window.start - chunkFirstBlock;
+    for (uint32_t i = 0; i < window.count; i++) {
+        uint64_t blockOffset = (chunkFirstBlock + blockIndex) * blockSize;
+        uint64_t objBegin = std::max(blockOffset, infoBegin);
+        uint64_t objEnd = std::min(blockOffset + blockSize, infoEnd);
+        if (objBegin >= objEnd) {
+            break;
+        }
         std::string name = curvefs::common::s3util::GenObjName(
             req.chunkId, blockIndex, req.compaction,
             req.fsId, req.inodeId, objectPrefix);
-        uint64_t maxReadLen = (blockIndex + 1) * blockSize;
-        uint64_t needReadLen =
-            maxReadLen > fileLen ? fileLen - blockIndex * blockSize : blockSize;
-
-        prefetchObjs.push_back(std::make_pair(name, needReadLen));
+        prefetchObjs.push_back(std::make_pair(name, objEnd - objBegin));
 
-        blockIndex++;
-        if (maxReadLen > fileLen || blockIndex >= chunkSize / blockSize) {
+        blockIndex += window.stride;
+        if (blockIndex >= blocksPerChunk) {
             break;
         }
     }
@@ -686,6 +748,16 @@ void FileCacheManager::PrefetchForBlock(const S3ReadRequest &req,
     PrefetchS3Objs(prefetchObjs);
 }
 
+void FileCacheManager::RecordPrefetchHit(const std::string &name) {
+    curve::common::LockGuard lg(downloadMtx_);
+    if (prefetchedObj_.erase(name) > 0) {
+        g_s3MultiManagerMetric->prefetchHitBlockNum << 1;
+    }
+}
+
+// the max number of prefetched objects recorded for accuracy per file
+static const size_t kMaxPrefetchedObj = 4096;
+
 class AsyncPrefetchCallback {
  public:
     AsyncPrefetchCallback(uint64_t inode, S3ClientAdaptorImpl *s3Client)
@@ -696,6 +768,9 @@ class AsyncPrefetchCallback {
         VLOG(9) << "prefetch end: " << context->key << ", len " << context->len
                 << "actual len: " << context->actualLen;
         std::unique_ptr<char[]> guard(context->buf);
+        s3Client_->ReleasePrefetchBytes(context->len);
+        g_s3MultiManagerMetric->prefetchInflightByte
+            << -static_cast<int64_t>(context->len);
         auto fileCache =
             s3Client_->GetFsCacheManager()->FindFileCacheManager(inode_);
 
@@ -708,11 +783,17 @@ class AsyncPrefetchCallback {
 
         if (context->retCode != 0) {
             LOG(WARNING) << "prefetch failed, key: " << context->key;
+            curve::common::LockGuard lg(fileCache->downloadMtx_);
+            fileCache->downloadingObj_.erase(context->key);
             return;
         }
 
-        int ret = s3Client_->GetDiskCacheManager()->WriteReadDirect(
-            context->key, context->buf, context->actualLen);
+        auto diskCacheManager = s3Client_->GetDiskCacheManager();
+        int ret = -1;
+        if (diskCacheManager->AdmitReadCache(context->key)) {
+            ret = diskCacheManager->WriteReadDirect(
+                context->key, context->buf, context->actualLen);
+        }
         if (ret < 0) {
             LOG_EVERY_SECOND(INFO)
                 << "write read directly failed, key: " << context->key;
@@ -720,6 +801,14 @@ class AsyncPrefetchCallback {
         {
             curve::common::LockGuard lg(fileCache->downloadMtx_);
             fileCache->downloadingObj_.erase(context->key);
+            if (ret >= 0) {
+                // it's only for metric, forget the old ones if the file
+                // never reads them
+                if (fileCache->prefetchedObj_.size() >= kMaxPrefetchedObj) {
+                    fileCache->prefetchedObj_.clear();
+                }
+                fileCache->prefetchedObj_.emplace(context->key);
+            }
         }
     }
 
@@ -744,6 +833,12 @@ void FileCacheManager::PrefetchS3Objs(
                     << ", size: " << downloadingObj_.size();
             continue;
         }
+        if (!s3ClientAdaptor_->AcquirePrefetchBytes(readLen)) {
+            VLOG(9) << "too many prefetching bytes, skip: " << name;
+            break;
+        }
+        g_s3MultiManagerMetric->prefetchBlockNum << 1;
+        g_s3MultiManagerMetric->prefetchInflightByte << readLen;
         VLOG(9) << "download start: " << name
                 << ", size: " << downloadingObj_.size();
         downloadingObj_.emplace(name);
@@ -777,6 +872,8 @@ void FileCacheManager::HandleReadRequest(
     S3ReadRequest s3Request;
     uint64_t s3ChunkInfoOffset = s3ChunkInfo.offset();
     uint64_t s3ChunkInfoLen = s3ChunkInfo.len();
+    s3Request.chunkInfoOffset = s3ChunkInfoOffset;
+    s3Request.chunkInfoLen = s3ChunkInfoLen;
     uint64_t fileOffset = request.index * chunkSize + request.chunkPos;
     uint64_t length = request.len;
     uint64_t bufOffset = request.bufOffset;
@@ -1767,7 +1864,7 @@ DataCache::DataCache(S3ClientAdaptorImpl *s3ClientAdaptor,
                      std::shared_ptr<KVClientManager> kvClientManager)
     : s3ClientAdaptor_(std::move(s3ClientAdaptor)),
       chunkCacheManager_(chunkCacheManager), status_(DataCacheStatus::Dirty),
-      inReadCache_(false) {
+      inReadCache_(false), pagePool_(s3ClientAdaptor->GetPagePool()) {
     uint64_t blockSize = s3ClientAdaptor->GetBlockSize();
     uint32_t pageSize = s3ClientAdaptor->GetPageSize();
     chunkPos_ = chunkPos;
@@ -1799,14 +1896,11 @@ DataCache::DataCache(S3ClientAdaptorImpl *s3ClientAdaptor,
                 m = blockLen;
             }
 
-            PageData *pageData = new PageData();
-            pageData->data = new char[pageSize];
-            memset(pageData->data, 0, pageSize);
+            PageData *pageData = pagePool_->Allocate(pageIndex);
             memcpy(pageData->data + pagePos, data + dataOffset, m);
             if (pagePos + m < pageSize) {
                 tailZeroLen = pageSize - pagePos - m;
             }
-            pageData->index = pageIndex;
             assert(pdMap.count(pageIndex) == 0);
             pdMap.emplace(pageIndex, pageData);
             pageIndex++;
@@ -1865,10 +1959,7 @@ void DataCache::CopyBufToDataCache(uint64_t dataCachePos, uint64_t len,
             if (pdMap.count(pageIndex)) {
                 pageData = pdMap[pageIndex];
             } else {
-                pageData = new PageData();
-                pageData->data = new char[pageSize];
-                memset(pageData->data, 0, pageSize);
-                pageData->index = pageIndex;
+                pageData = pagePool_->Allocate(pageIndex);
                 pdMap.emplace(pageIndex, pageData);
                 addLen += pageSize;
             }
@@ -1925,10 +2016,7 @@ void DataCache::AddDataBefore(uint64_t len, const char *data) {
             if (pdMap.count(pageIndex)) {
                 pageData = pdMap[pageIndex];
             } else {
-                pageData = new PageData();
-                pageData->data = new char[pageSize];
-                memset(pageData->data, 0, pageSize);
-                pageData->index = pageIndex;
+                pageData = pagePool_->Allocate(pageIndex);
                 pdMap.emplace(pageIndex, pageData);
             }
             memcpy(pageData->data + pagePos, data + dataOffset, m);
@@ -2173,7 +2261,7 @@ void DataCache::Truncate(uint64_t size) {
             if (pagePos == 0) {
                 if (pdMap.count(pageIndex)) {
                     pageData = pdMap[pageIndex];
-                    delete pageData->data;
+                    pagePool_->Release(pageData);
                     pdMap.erase(pageIndex);
                     actualLen_ -= pageSize;
                 }
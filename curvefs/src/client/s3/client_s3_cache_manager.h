@@ -23,12 +23,15 @@
 #define CURVEFS_SRC_CLIENT_S3_CLIENT_S3_CACHE_MANAGER_H_
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <set>
@@ -36,6 +39,8 @@
 #include "curvefs/proto/metaserver.pb.h"
 #include "curvefs/src/client/filesystem/error.h"
 #include "curvefs/src/client/s3/client_s3.h"
+#include "curvefs/src/client/s3/page_pool.h"
+#include "curvefs/src/client/s3/prefetch_tracker.h"
 #include "src/common/concurrent/concurrent.h"
 #include "src/common/concurrent/task_thread_pool.h"
 #include "curvefs/src/client/kvclient/kvclient_manager.h"
@@ -96,6 +101,10 @@ struct S3ReadRequest {
     uint64_t fsId;
     uint64_t inodeId;
     uint64_t compaction;
+    // file range written by the S3ChunkInfo, only blocks within it have
+    // objects of |chunkId|
+    uint64_t chunkInfoOffset;
+    uint64_t chunkInfoLen;
 
     std::string DebugString() const {
         std::ostringstream os;
@@ -121,10 +130,6 @@ struct ObjectChunkInfo {
     uint64_t objectOffset;  // s3 object's begin in the block
 };
 
-struct PageData {
-    uint64_t index;
-    char *data;
-};
 using PageDataMap = std::map<uint64_t, PageData *>;
 
 enum DataCacheStatus {
@@ -143,8 +148,7 @@ class DataCache : public std::enable_shared_from_this<DataCache> {
         for (; iter != dataMap_.end(); iter++) {
             auto pageIter = iter->second.begin();
             for (; pageIter != iter->second.end(); pageIter++) {
-                delete[] pageIter->second->data;
-                delete pageIter->second;
+                pagePool_->Release(pageIter->second);
             }
         }
     }
@@ -234,6 +238,9 @@ class DataCache : public std::enable_shared_from_this<DataCache> {
     std::atomic<int> status_;
     std::atomic<bool> inReadCache_;
     std::map<uint64_t, PageDataMap> dataMap_;  // first is block index
+    // pages are taken from and given back to it, pages moved to another
+    // data cache by merging are released by that data cache
+    std::shared_ptr<PagePool> pagePool_;
 
     std::shared_ptr<KVClientManager> kvClientManager_;
 };
@@ -429,10 +436,16 @@ class FileCacheManager {
     // thread function for ReadKVRequest
     void ProcessKVRequest(const S3ReadRequest &req, char *dataBuf,
                           uint64_t fileLen,
+                          const PrefetchWindow &prefetchWindow,
                           std::once_flag &cancelFlag,     // NOLINT
                           std::atomic<bool> &isCanceled,  // NOLINT
                           std::atomic<int> &retCode);     // NOLINT
 
+    // feed the access pattern tracker with requests in offset order,
+    // and get the prefetch window of each request
+    void TrackPrefetchWindows(const std::vector<S3ReadRequest> &kvRequests,
+                              std::vector<PrefetchWindow> *windows);
+
     // read kv request from local disk cache
     bool ReadKVRequestFromLocalCache(const std::string &name, char *databuf,
                                      uint64_t offset, uint64_t len);
@@ -449,10 +462,13 @@ class FileCacheManager {
     int HandleReadS3NotExist(uint32_t retry,
                              const std::shared_ptr<InodeWrapper> &inodeWrapper);
 
-    // prefetch for block
+    // prefetch blocks in |window| for block
     void PrefetchForBlock(const S3ReadRequest &req, uint64_t fileLen,
-                         uint64_t blockSize, uint64_t chunkSize,
-                         uint64_t startBlockIndex);
+                          uint64_t blockSize, uint64_t chunkSize,
+                          const PrefetchWindow &window);
+
+    // record a read of object |name| from disk cache for prefetch accuracy
+    void RecordPrefetchHit(const std::string &name);
 
  private:
     friend class AsyncPrefetchCallback;
@@ -465,6 +481,9 @@ class FileCacheManager {
     S3ClientAdaptorImpl *s3ClientAdaptor_;
     curve::common::Mutex downloadMtx_;
     std::set<std::string> downloadingObj_;
+    // prefetched objects which are not read yet
+    std::unordered_set<std::string> prefetchedObj_;
+    PrefetchTracker prefetchTracker_;
 
     std::shared_ptr<KVClientManager> kvClientManager_;
     std::shared_ptr<TaskThreadPool<>> readTaskPool_;
@@ -475,15 +494,21 @@ class FsCacheManager {
     FsCacheManager(S3ClientAdaptorImpl *s3ClientAdaptor,
                    uint64_t readCacheMaxByte, uint64_t writeCacheMaxByte,
                    uint32_t readCacheThreads,
-                   std::shared_ptr<KVClientManager> kvClientManager)
+                   std::shared_ptr<KVClientManager> kvClientManager,
+                   uint32_t readCacheShards = 1)
         : lruByte_(0), wDataCacheNum_(0), wDataCacheByte_(0),
           readCacheMaxByte_(readCacheMaxByte),
           writeCacheMaxByte_(writeCacheMaxByte),
           s3ClientAdaptor_(s3ClientAdaptor), isWaiting_(false),
           kvClientManager_(std::move(kvClientManager)) {
+        readCacheShards = std::max(readCacheShards, 1u);
+        for (uint32_t i = 0; i < readCacheShards; i++) {
+            lruShards_.emplace_back(new LruShard());
+        }
         readTaskPool_->Start(readCacheThreads);
     }
-    FsCacheManager() = default;
+    // used by tests and mocks, read cache still has one shard
+    FsCacheManager() { lruShards_.emplace_back(new LruShard()); }
     virtual ~FsCacheManager() { readTaskPool_->Stop(); }
     virtual FileCacheManagerPtr FindFileCacheManager(uint64_t inodeId);
     virtual FileCacheManagerPtr FindOrCreateFileCacheManager(uint64_t fsId,
@@ -535,8 +560,7 @@ class FsCacheManager {
     }
 
     uint64_t GetLruByte() {
-        std::lock_guard<std::mutex> lk(lruMtx_);
-        return lruByte_;
+        return lruByte_.load(std::memory_order_relaxed);
     }
 
     void SetFileCacheManagerForTest(uint64_t inodeId,
@@ -573,14 +597,30 @@ class FsCacheManager {
         std::thread t_;
     };
 
+ private:
+    // The read cache lru is split into shards by the data cache, so readers
+    // of different data caches don't contend on one lock. |lruByte_| is
+    // shared by all shards, and eviction starts from the shard being
+    // inserted, so the lru order is kept per shard only.
+    struct LruShard {
+        std::mutex mtx;
+        std::list<DataCachePtr> list;
+    };
+
+    LruShard* GetLruShard(const DataCache* dataCache) const {
+        size_t hash = std::hash<const DataCache*>()(dataCache);
+        return lruShards_[(hash >> 4) % lruShards_.size()].get();
+    }
+
+    void TrimReadCache(LruShard* first);
+
  private:
     std::unordered_map<uint64_t, FileCacheManagerPtr>
         fileCacheManagerMap_;  // first is inodeid
     RWLock rwLock_;
-    std::mutex lruMtx_;
 
-    std::list<DataCachePtr> lruReadDataCacheList_;
-    uint64_t lruByte_;
+    std::vector<std::unique_ptr<LruShard>> lruShards_;
+    std::atomic<uint64_t> lruByte_;
     std::atomic<uint64_t> wDataCacheNum_;
     std::atomic<uint64_t> wDataCacheByte_;
     uint64_t readCacheMaxByte_;
@@ -88,6 +88,9 @@ int DiskCacheManager::Init(std::shared_ptr<S3Client> client,
     maxFileNums_ = option.diskCacheOpt.maxFileNums;
     cmdTimeoutSec_ = option.diskCacheOpt.cmdTimeoutSec;
     objectPrefix_ = option.objectPrefix;
+    if (option.diskCacheOpt.admissionFilter) {
+        admission_.reset(new TinyLfuAdmission(maxFileNums_));
+    }
     cacheWrite_->Init(client_, posixWrapper_, cacheDir_, objectPrefix_,
         option.diskCacheOpt.asyncLoadPeriodMs, cachedObjName_);
     cacheRead_->Init(posixWrapper_, cacheDir_, objectPrefix_);
@@ -132,6 +135,7 @@ int DiskCacheManager::Init(std::shared_ptr<S3Client> client,
               << ", cmdTimeoutSec is: " << cmdTimeoutSec_
               << ", safeRatio is: " << safeRatio_
               << ", fullRatio is: " << fullRatio_
+              << ", admissionFilter is: " << (admission_ != nullptr)
               << ", disk used bytes: " << GetDiskUsedbytes();
     return 0;
 }
@@ -164,7 +168,31 @@ void DiskCacheManager::AddCache(const std::string &name) {
     VLOG(9) << "cache size is: " << cachedObjName_->Size();
 }
 
+bool DiskCacheManager::AdmitReadCache(const std::string &name) {
+    if (admission_ == nullptr || IsDiskCacheSafe()) {
+        return true;
+    }
+
+    std::string victim;
+    if (!cachedObjName_->GetBack(&victim)) {
+        return true;
+    }
+
+    if (admission_->Admit(name, victim)) {
+        return true;
+    }
+    VLOG(9) << "obj is not admitted, name = " << name
+            << ", victim = " << victim;
+    if (metric_.get() != nullptr) {
+        metric_->admissionRejected << 1;
+    }
+    return false;
+}
+
 bool DiskCacheManager::IsCached(const std::string &name) {
+    if (admission_ != nullptr) {
+        admission_->Record(name);
+    }
     if (!cachedObjName_->IsCached(name)) {
         VLOG(9) << "not cached, name = " << name;
         return false;
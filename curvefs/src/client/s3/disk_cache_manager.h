@@ -40,6 +40,7 @@
 #include "curvefs/src/client/s3/client_s3.h"
 #include "curvefs/src/client/s3/disk_cache_write.h"
 #include "curvefs/src/client/s3/disk_cache_read.h"
+#include "curvefs/src/client/s3/tinylfu_admission.h"
 #include "curvefs/src/client/common/config.h"
 namespace curvefs {
 namespace client {
@@ -75,6 +76,13 @@ class DiskCacheManager {
      */
     void AddCache(const std::string &name);
 
+    /**
+     * @brief whether to cache an obj read from s3, always true if the
+     *        disk cache is safe or the admission filter is disabled
+     * @param[in] name obj name
+     */
+    virtual bool AdmitReadCache(const std::string &name);
+
     int CreateDir();
     std::string GetCacheReadFullDir();
     std::string GetCacheWriteFullDir();
@@ -184,6 +192,8 @@ class DiskCacheManager {
     std::shared_ptr<DiskCacheRead> cacheRead_;
 
     std::shared_ptr<SglLRUCache<std::string>> cachedObjName_;
+    // nullptr if diskCache.admissionFilter is false
+    std::unique_ptr<TinyLfuAdmission> admission_;
 
     std::shared_ptr<S3Client> client_;
     std::shared_ptr<PosixWrapper> posixWrapper_;
@@ -181,6 +181,10 @@ bool DiskCacheManagerImpl::IsCached(const std::string name) {
     return diskCacheManager_->IsCached(name);
 }
 
+bool DiskCacheManagerImpl::AdmitReadCache(const std::string &name) {
+    return diskCacheManager_->AdmitReadCache(name);
+}
+
 bool DiskCacheManagerImpl::IsDiskCacheFull() {
     return diskCacheManager_->IsDiskCacheFull();
 }
@@ -93,6 +93,12 @@ class DiskCacheManagerImpl {
      * @return cached: true, not cached : < 0
      */
     bool IsCached(const std::string name);
+    /**
+     * @brief whether to cache an obj downloaded from s3
+     * @param[in] name obj name
+     * @return admitted: true, rejected by the admission filter: false
+     */
+    virtual bool AdmitReadCache(const std::string &name);
     /**
      * @brief read obj
      * @param[in] name obj name
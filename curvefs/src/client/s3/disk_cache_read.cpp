@@ -55,14 +55,7 @@ int DiskCacheRead::ReadDiskFile(const std::string name, char *buf,
                    << ", errno = " << errno;
         return fd;
     }
-    off_t seekPos = posixWrapper_->lseek(fd, offset, SEEK_SET);
-    if (seekPos < 0) {
-        LOG(ERROR) << "lseek disk file error. file = " << name
-                   << ", errno = " << errno;
-        posixWrapper_->close(fd);
-        return seekPos;
-    }
-    ssize_t readLen = posixWrapper_->read(fd, buf, length);
+    ssize_t readLen = posixWrapper_->pread(fd, buf, length, offset);
     if (readLen < 0) {
         LOG(ERROR) << "read disk error, ret = " << readLen
                    << ", errno = " << errno << ", file = " << name;
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-28
+ * Author: curve
+ */
+
+#include "curvefs/src/client/s3/page_pool.h"
+
+#include <cstring>
+
+namespace curvefs {
+namespace client {
+
+using ::curve::common::LockGuard;
+
+PagePool::~PagePool() {
+    LockGuard lk(mtx_);
+    FreeIdlePages();
+}
+
+void PagePool::Init(uint32_t pageSize, uint64_t maxIdleBytes) {
+    LockGuard lk(mtx_);
+    FreeIdlePages();
+    pageSize_ = pageSize;
+    maxIdlePages_ = pageSize == 0 ? 0 : maxIdleBytes / pageSize;
+    idle_.reserve(maxIdlePages_);
+}
+
+PageData* PagePool::Allocate(uint64_t index) {
+    PageData* page = nullptr;
+    {
+        LockGuard lk(mtx_);
+        if (!idle_.empty()) {
+            page = idle_.back();
+            idle_.pop_back();
+        }
+    }
+
+    if (page == nullptr) {
+        page = new PageData();
+        page->data = new char[pageSize_];
+    }
+    memset(page->data, 0, pageSize_);
+    page->index = index;
+    inuseBytes_.fetch_add(pageSize_, std::memory_order_relaxed);
+    return page;
+}
+
+void PagePool::Release(PageData* page) {
+    inuseBytes_.fetch_sub(pageSize_, std::memory_order_relaxed);
+    {
+        LockGuard lk(mtx_);
+        if (idle_.size() < maxIdlePages_) {
+            idle_.push_back(page);
+            return;
+        }
+    }
+
+    delete[] page->data;
+    delete page;
+}
+
+uint64_t PagePool::GetIdleBytes() {
+    LockGuard lk(mtx_);
+    return idle_.size() * pageSize_;
+}
+
+void PagePool::FreeIdlePages() {
+    for (auto* page : idle_) {
+        delete[] page->data;
+        delete page;
+    }
+    idle_.clear();
+}
+
+}  // namespace client
+}  // namespace curvefs
@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-28
+ * Author: curve
+ */
+
+#ifndef CURVEFS_SRC_CLIENT_S3_PAGE_POOL_H_
+#define CURVEFS_SRC_CLIENT_S3_PAGE_POOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "src/common/concurrent/concurrent.h"
+
+namespace curvefs {
+namespace client {
+
+struct PageData {
+    uint64_t index;
+    char *data;
+};
+
+// PagePool recycles the pages of data caches, so writing and evicting data
+// caches doesn't malloc and free a page buffer every time.
+//
+// At most |maxIdleBytes| of released pages are kept for reuse, the others
+// are freed at once.
+class PagePool {
+ public:
+    PagePool() = default;
+
+    ~PagePool();
+
+    PagePool(const PagePool&) = delete;
+    PagePool& operator=(const PagePool&) = delete;
+
+    // Idle pages of the previous page size are freed
+    void Init(uint32_t pageSize, uint64_t maxIdleBytes);
+
+    // Return a zeroed page
+    PageData* Allocate(uint64_t index);
+
+    void Release(PageData* page);
+
+    uint32_t GetPageSize() const { return pageSize_; }
+
+    uint64_t GetIdleBytes();
+
+    uint64_t GetInuseBytes() const {
+        return inuseBytes_.load(std::memory_order_relaxed);
+    }
+
+ private:
+    void FreeIdlePages();
+
+ private:
+    uint32_t pageSize_ = 0;
+    size_t maxIdlePages_ = 0;
+    curve::common::Mutex mtx_;
+    std::vector<PageData*> idle_;
+    std::atomic<uint64_t> inuseBytes_{0};
+};
+
+}  // namespace client
+}  // namespace curvefs
+
+#endif  // CURVEFS_SRC_CLIENT_S3_PAGE_POOL_H_
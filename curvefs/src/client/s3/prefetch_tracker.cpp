@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-27
+ * Author: curve
+ */
+
+#include "curvefs/src/client/s3/prefetch_tracker.h"
+
+#include <algorithm>
+
+namespace curvefs {
+namespace client {
+
+using ::curve::common::LockGuard;
+
+PrefetchWindow PrefetchTracker::Access(uint64_t firstBlock,
+                                       uint64_t lastBlock,
+                                       uint32_t minBlocks,
+                                       uint32_t maxBlocks) {
+    maxBlocks = std::max(minBlocks, maxBlocks);
+    auto grow = [&](uint32_t window) {
+        if (window < minBlocks) {
+            return minBlocks;
+        }
+        return std::min(window * 2, maxBlocks);
+    };
+
+    LockGuard lk(mtx_);
+    PrefetchWindow window;
+    window.start = firstBlock;
+    if (!accessed_) {
+        accessed_ = true;
+        lastFirst_ = firstBlock;
+        lastLast_ = lastBlock;
+        window_ = minBlocks;
+        window.count = window_;
+        return window;
+    }
+
+    // still reading the same block, which has been prefetched
+    if (firstBlock == lastFirst_) {
+        lastLast_ = std::max(lastLast_, lastBlock);
+        return window;
+    }
+
+    if (firstBlock > lastFirst_ && firstBlock <= lastLast_ + 1) {
+        pattern_ = AccessPattern::SEQUENTIAL;
+        stride_ = 1;
+        window_ = grow(window_);
+    } else if (firstBlock > lastFirst_ && stride_ > 1 &&
+               firstBlock - lastFirst_ == stride_) {
+        pattern_ = AccessPattern::STRIDED;
+        window_ = grow(window_);
+    } else {
+        // maybe the first step of a strided access
+        pattern_ = AccessPattern::RANDOM;
+        stride_ = firstBlock > lastFirst_ ? firstBlock - lastFirst_ : 0;
+        window_ = 0;
+    }
+
+    lastFirst_ = firstBlock;
+    lastLast_ = lastBlock;
+    window.stride = std::max<uint64_t>(stride_, 1);
+    window.count = window_;
+    return window;
+}
+
+AccessPattern PrefetchTracker::GetPattern() {
+    LockGuard lk(mtx_);
+    return pattern_;
+}
+
+}  // namespace client
+}  // namespace curvefs
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-27
+ * Author: curve
+ */
+
+#ifndef CURVEFS_SRC_CLIENT_S3_PREFETCH_TRACKER_H_
+#define CURVEFS_SRC_CLIENT_S3_PREFETCH_TRACKER_H_
+
+#include <cstdint>
+
+#include "src/common/concurrent/concurrent.h"
+
+namespace curvefs {
+namespace client {
+
+enum class AccessPattern {
+    UNKNOWN = 0,
+    SEQUENTIAL = 1,
+    STRIDED = 2,
+    RANDOM = 3,
+};
+
+// PrefetchWindow describes the blocks to prefetch:
+//   start, start + stride, ..., start + (count - 1) * stride
+struct PrefetchWindow {
+    uint64_t start = 0;
+    uint64_t stride = 1;
+    uint32_t count = 0;
+};
+
+// PrefetchTracker detects the access pattern of a file by the blocks it
+// reads, and scales the prefetch window accordingly:
+//  - sequential and strided access doubles the window on every new block,
+//    up to |maxBlocks|
+//  - random access prefetches nothing, because the blocks prefetched will
+//    hardly be read
+//  - the first access of a file prefetches |minBlocks| like before
+class PrefetchTracker {
+ public:
+    PrefetchTracker() = default;
+
+    PrefetchWindow Access(uint64_t firstBlock, uint64_t lastBlock,
+                          uint32_t minBlocks, uint32_t maxBlocks);
+
+    AccessPattern GetPattern();
+
+ private:
+    curve::common::Mutex mtx_;
+    bool accessed_ = false;
+    uint64_t lastFirst_ = 0;
+    uint64_t lastLast_ = 0;
+    uint64_t stride_ = 0;
+    uint32_t window_ = 0;
+    AccessPattern pattern_ = AccessPattern::UNKNOWN;
+};
+
+}  // namespace client
+}  // namespace curvefs
+
+#endif  // CURVEFS_SRC_CLIENT_S3_PREFETCH_TRACKER_H_
@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-29
+ * Author: curve
+ */
+
+#include "curvefs/src/client/s3/tinylfu_admission.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace curvefs {
+namespace client {
+
+using ::curve::common::LockGuard;
+
+constexpr uint32_t TinyLfuAdmission::kDepth;
+constexpr uint8_t TinyLfuAdmission::kMaxCount;
+
+namespace {
+
+const uint64_t kMinWidth = 1024;
+const uint64_t kMaxWidth = 1ULL << 24;
+
+}  // namespace
+
+TinyLfuAdmission::TinyLfuAdmission(uint64_t expectedItems)
+    : width_(kMinWidth), additions_(0) {
+    while (width_ < expectedItems && width_ < kMaxWidth) {
+        width_ <<= 1;
+    }
+    sampleSize_ = 10 * width_;
+    table_.resize(kDepth * width_, 0);
+}
+
+uint64_t TinyLfuAdmission::IndexOf(uint64_t hash, uint32_t row) const {
+    // derive one hash per row by mixing the key hash with the row number
+    uint64_t h = hash + (row + 1) * 0x9E3779B97F4A7C15ULL;
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    return row * width_ + (h & (width_ - 1));
+}
+
+uint32_t TinyLfuAdmission::EstimateLocked(uint64_t hash) const {
+    uint32_t count = kMaxCount;
+    for (uint32_t row = 0; row < kDepth; row++) {
+        count = std::min<uint32_t>(count, table_[IndexOf(hash, row)]);
+    }
+    return count;
+}
+
+void TinyLfuAdmission::Record(const std::string& key) {
+    uint64_t hash = std::hash<std::string>()(key);
+
+    LockGuard lk(mtx_);
+    bool added = false;
+    for (uint32_t row = 0; row < kDepth; row++) {
+        uint8_t& counter = table_[IndexOf(hash, row)];
+        if (counter < kMaxCount) {
+            counter++;
+            added = true;
+        }
+    }
+
+    if (added && ++additions_ >= sampleSize_) {
+        Reset();
+    }
+}
+
+uint32_t TinyLfuAdmission::Estimate(const std::string& key) {
+    uint64_t hash = std::hash<std::string>()(key);
+
+    LockGuard lk(mtx_);
+    return EstimateLocked(hash);
+}
+
+bool TinyLfuAdmission::Admit(const std::string& candidate,
+                             const std::string& victim) {
+    uint64_t candidateHash = std::hash<std::string>()(candidate);
+    uint64_t victimHash = std::hash<std::string>()(victim);
+
+    LockGuard lk(mtx_);
+    return EstimateLocked(candidateHash) > EstimateLocked(victimHash);
+}
+
+void TinyLfuAdmission::Reset() {
+    for (auto& counter : table_) {
+        counter >>= 1;
+    }
+    additions_ /= 2;
+}
+
+}  // namespace client
+}  // namespace curvefs
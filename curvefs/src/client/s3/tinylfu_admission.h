@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-29
+ * Author: curve
+ */
+
+#ifndef CURVEFS_SRC_CLIENT_S3_TINYLFU_ADMISSION_H_
+#define CURVEFS_SRC_CLIENT_S3_TINYLFU_ADMISSION_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/common/concurrent/concurrent.h"
+
+namespace curvefs {
+namespace client {
+
+// TinyLfuAdmission estimates how often objects are accessed with a
+// count-min sketch, and only admits a new object into a full cache if it is
+// accessed more often than the object it would evict. So objects read once
+// by a scan don't flush the hot objects out of the cache.
+//
+// Counters saturate at 15 and are halved every |10 * expectedItems|
+// records, so the popularity of objects fades out over time.
+class TinyLfuAdmission {
+ public:
+    explicit TinyLfuAdmission(uint64_t expectedItems);
+
+    void Record(const std::string& key);
+
+    uint32_t Estimate(const std::string& key);
+
+    bool Admit(const std::string& candidate, const std::string& victim);
+
+ private:
+    static constexpr uint32_t kDepth = 4;
+    static constexpr uint8_t kMaxCount = 15;
+
+    uint64_t IndexOf(uint64_t hash, uint32_t row) const;
+
+    uint32_t EstimateLocked(uint64_t hash) const;
+
+    void Reset();
+
+ private:
+    curve::common::Mutex mtx_;
+    uint64_t width_;
+    uint64_t sampleSize_;
+    uint64_t additions_;
+    std::vector<uint8_t> table_;
+};
+
+}  // namespace client
+}  // namespace curvefs
+
+#endif  // CURVEFS_SRC_CLIENT_S3_TINYLFU_ADMISSION_H_
@@ -30,7 +30,9 @@
 #include <deque>
 #include <list>
 #include <memory>
+#include <set>
 #include <utility>
+#include <vector>
 
 #include "curvefs/src/client/common/common.h"
 #include "curvefs/src/client/inode_wrapper.h"
@@ -91,6 +93,10 @@ bool WarmupManagerS3Impl::AddWarmupFile(fuse_ino_t key, const std::string &path,
 
 void WarmupManagerS3Impl::UnInit() {
     bgFetchStop_.store(true, std::memory_order_release);
+    // let the tasks waiting for bandwidth go
+    if (throttle_ != nullptr) {
+        throttle_->Stop();
+    }
     if (initbgFetchThread_) {
         bgFetchThread_.join();
     }
@@ -118,6 +124,14 @@ void WarmupManagerS3Impl::UnInit() {
 
 void WarmupManagerS3Impl::Init(const FuseClientOption &option) {
     WarmupManager::Init(option);
+    if (option.warmupBandwidthLimitMB > 0) {
+        curve::common::ReadWriteThrottleParams params;
+        params.bpsTotal.limit = option.warmupBandwidthLimitMB * 1024 * 1024;
+        throttle_ = absl::make_unique<curve::common::Throttle>();
+        throttle_->UpdateThrottleParams(params);
+        LOG(INFO) << "warmup bandwidth limit "
+                  << option.warmupBandwidthLimitMB << " MB/s";
+    }
     bgFetchStop_.store(false, std::memory_order_release);
     bgFetchThread_ = Thread(&WarmupManagerS3Impl::BackGroundFetch, this);
     initbgFetchThread_ = true;
@@ -520,6 +534,9 @@ void WarmupManagerS3Impl::WarmUpAllObjs(
                     continue;
                 }
             }
+            if (throttle_ != nullptr) {
+                throttle_->Add(true, readLen);
+            }
             char *cacheS3 = new char[readLen];
             memset(cacheS3, 0, readLen);
             auto context = std::make_shared<GetObjectAsyncContext>();
@@ -598,10 +615,11 @@ void WarmupManagerS3Impl::ScanCleanFetchS3ObjectsPool() {
 
 void WarmupManagerS3Impl::ScanCleanWarmupProgress() {
     // clean done warmupProgress
-    ReadLockGuard lock(inode2ProgressMutex_);
+    WriteLockGuard lock(inode2ProgressMutex_);
     for (auto iter = inode2Progress_.begin(); iter != inode2Progress_.end();) {
         if (ProgressDone(iter->first)) {
-            VLOG(9) << "warmup key: " << iter->first << " done!";
+            LOG(INFO) << "warmup key: " << iter->first << " done, "
+                      << iter->second.ToString();
             iter = inode2Progress_.erase(iter);
         } else {
             ++iter;
@@ -610,23 +628,62 @@ void WarmupManagerS3Impl::ScanCleanWarmupProgress() {
 }
 
 void WarmupManagerS3Impl::ScanWarmupInodes() {
-    // file need warmup
-    WriteLockGuard lock(warmupInodesDequeMutex_);
-    if (!warmupInodesDeque_.empty()) {
-        WarmupInodes inodes = warmupInodesDeque_.front();
-        for (auto const &iter : inodes.GetReadAheadFiles()) {
-            VLOG(9) << "BackGroundFetch: key: " << inodes.GetKey()
-                    << " inode:" << iter;
-            FetchDataEnqueue(inodes.GetKey(), iter);
+    // file need warmup, all the tasks are handled in one scan, so the
+    // directories walked in parallel don't wait for each other.
+    // the tasks are swapped out first, so dentry fetchers aren't blocked by
+    // the BatchGetInodeAttr rpc. ProgressDone is only checked by this
+    // thread after the tasks are enqueued, so it won't see them missing.
+    std::deque<WarmupInodes> pending;
+    {
+        WriteLockGuard lock(warmupInodesDequeMutex_);
+        pending.swap(warmupInodesDeque_);
+    }
+    for (const auto &inodes : pending) {
+        FetchDataEnqueueBySize(inodes);
+    }
+}
+
+void WarmupManagerS3Impl::FetchDataEnqueueBySize(const WarmupInodes &inodes) {
+    fuse_ino_t key = inodes.GetKey();
+    std::set<uint64_t> inodeIds(inodes.GetReadAheadFiles().begin(),
+                                inodes.GetReadAheadFiles().end());
+    std::list<InodeAttr> attrs;
+    CURVEFS_ERROR ret = inodeManager_->BatchGetInodeAttr(&inodeIds, &attrs);
+    if (ret != CURVEFS_ERROR::OK) {
+        LOG(WARNING) << "BatchGetInodeAttr fail, ret = " << ret
+                     << ", warmup key = " << key;
+        attrs.clear();
+    }
+
+    std::vector<std::pair<uint64_t, fuse_ino_t>> files;  // length, inode
+    files.reserve(attrs.size());
+    for (const auto &attr : attrs) {
+        if (inodes.GetReadAheadFiles().count(attr.inodeid()) == 0) {
+            continue;
         }
-        warmupInodesDeque_.pop_front();
+        inodeIds.erase(attr.inodeid());
+        if (attr.length() > 0) {
+            files.emplace_back(attr.length(), attr.inodeid());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    for (const auto &file : files) {
+        VLOG(9) << "BackGroundFetch: key: " << key << " inode:" << file.second
+                << " length: " << file.first;
+        FetchDataEnqueue(key, file.second);
+    }
+    // the inodes whose length is unknown come last
+    for (auto ino : inodeIds) {
+        VLOG(9) << "BackGroundFetch: key: " << key << " inode:" << ino;
+        FetchDataEnqueue(key, ino);
     }
 }
 
 void WarmupManagerS3Impl::ScanWarmupFilelist() {
     // Use a write lock to ensure that all parsing tasks are added.
     WriteLockGuard lock(warmupFilelistDequeMutex_);
-    if (!warmupFilelistDeque_.empty()) {
+    while (!warmupFilelistDeque_.empty()) {
         WarmupFilelist warmupFilelist = warmupFilelistDeque_.front();
         VLOG(9) << "warmup ino: " << warmupFilelist.GetKey()
                 << " len is: " << warmupFilelist.GetFileLen();
@@ -689,7 +746,7 @@ void WarmupManagerS3Impl::PutObjectToCache(fuse_ino_t key,
     }
     int ret;
     // update progress
-    iter->second.FinishedPlusOne();
+    iter->second.FinishedPlusOne(len);
     switch (iter->second.GetStorageType()) {
     case curvefs::client::common::WarmupStorageType::kWarmupStorageTypeDisk:
         ret = s3Adaptor_->GetDiskCacheManager()->WriteReadDirect(filename, data,
@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <deque>
 #include <functional>
@@ -49,6 +50,7 @@
 #include "curvefs/src/client/s3/client_s3_cache_manager.h"
 #include "src/common/concurrent/concurrent.h"
 #include "src/common/concurrent/rw_lock.h"
+#include "src/common/throttle.h"
 #include "curvefs/src/common/task_thread_pool.h"
 #include "curvefs/src/client/metric/client_metric.h"
 
@@ -109,11 +111,13 @@ class WarmupProgress {
  public:
     explicit WarmupProgress(WarmupStorageType type = curvefs::client::common::
                                 WarmupStorageType::kWarmupStorageTypeUnknown)
-        : total_(0), finished_(0), storageType_(type) {}
+        : total_(0), finished_(0), finishedBytes_(0), storageType_(type),
+          startTime_(std::chrono::steady_clock::now()) {}
 
     WarmupProgress(const WarmupProgress &wp)
         : total_(wp.total_), finished_(wp.finished_),
-          storageType_(wp.storageType_) {}
+          finishedBytes_(wp.finishedBytes_), storageType_(wp.storageType_),
+          startTime_(wp.startTime_) {}
 
     void AddTotal(uint64_t add) {
         std::lock_guard<std::mutex> lock(totalMutex_);
@@ -123,12 +127,15 @@ class WarmupProgress {
     WarmupProgress &operator=(const WarmupProgress &wp) {
         total_ = wp.total_;
         finished_ = wp.finished_;
+        finishedBytes_ = wp.finishedBytes_;
+        startTime_ = wp.startTime_;
         return *this;
     }
 
-    void FinishedPlusOne() {
+    void FinishedPlusOne(uint64_t bytes = 0) {
         std::lock_guard<std::mutex> lock(finishedMutex_);
         ++finished_;
+        finishedBytes_ += bytes;
     }
 
     uint64_t GetTotal() {
@@ -141,23 +148,46 @@ class WarmupProgress {
         return finished_;
     }
 
+    uint64_t GetFinishedBytes() {
+        std::lock_guard<std::mutex> lock(finishedMutex_);
+        return finishedBytes_;
+    }
+
+    // average throughput since the warmup task was added
+    uint64_t GetBytesPerSecond() {
+        std::lock_guard<std::mutex> lock(finishedMutex_);
+        return BytesPerSecondLocked();
+    }
+
     std::string ToString() {
         std::lock_guard<std::mutex> lockT(totalMutex_);
         std::lock_guard<std::mutex> lockF(finishedMutex_);
         return "total:" + std::to_string(total_) +
-               ",finished:" + std::to_string(finished_);
+               ",finished:" + std::to_string(finished_) +
+               ",finishedBytes:" + std::to_string(finishedBytes_) +
+               ",bytesPerSecond:" + std::to_string(BytesPerSecondLocked());
     }
 
     WarmupStorageType GetStorageType() {
         return storageType_;
     }
 
+ private:
+    uint64_t BytesPerSecondLocked() const {
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - startTime_)
+                           .count();
+        return elapsed <= 0 ? 0 : finishedBytes_ * 1000 / elapsed;
+    }
+
  private:
     uint64_t total_;
     std::mutex totalMutex_;
     uint64_t finished_;
+    uint64_t finishedBytes_;
     std::mutex finishedMutex_;
     WarmupStorageType storageType_;
+    std::chrono::steady_clock::time_point startTime_;
 };
 
 class WarmupManager {
@@ -407,6 +437,10 @@ class WarmupManagerS3Impl : public WarmupManager {
 
     void ScanWarmupInodes();
 
+    // enqueue the files in the ascending order of their length, so more
+    // files are ready to read early, empty files are skipped
+    void FetchDataEnqueueBySize(const WarmupInodes &inodes);
+
     void ScanWarmupFilelist();
 
     void AddFetchDentryTask(fuse_ino_t key, std::function<void()> task);
@@ -441,6 +475,9 @@ class WarmupManagerS3Impl : public WarmupManager {
     mutable RWLock inode2FetchS3ObjectsPoolMutex_;
 
     curvefs::client::metric::WarmupManagerS3Metric warmupS3Metric_;
+
+    // limit the bandwidth of warmup, leave the rest to foreground reads
+    std::unique_ptr<curve::common::Throttle> throttle_;
 };
 
 }  // namespace warmup
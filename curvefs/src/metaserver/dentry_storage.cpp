@@ -26,12 +26,14 @@
 #include <memory>
 #include <algorithm>
 
+#include "absl/types/optional.h"
 #include "src/common/string_util.h"
 #include "curvefs/src/metaserver/dentry_storage.h"
 
 namespace curvefs {
 namespace metaserver {
 
+using ::curve::common::NameLockGuard;
 using ::curve::common::ReadLockGuard;
 using ::curve::common::WriteLockGuard;
 using ::curve::common::StringStartWith;
@@ -101,15 +103,20 @@ void DentryVector::Filter(uint64_t maxTxId, BTree* btree) {
     }
 }
 
-void DentryVector::Confirm(uint64_t* count) {
-    if (nPendingDel_ > *count + nPendingAdd_) {
-        LOG(ERROR) << "there are multi delete, count = " << *count
-                   << ", nPendingAdd = " << nPendingAdd_
-                   << ", nPendingDel = " << nPendingDel_;
-        *count = 0;
-        return;
-    }
-    *count = *count + nPendingAdd_ - nPendingDel_;
+void DentryVector::Confirm(std::atomic<uint64_t>* count) {
+    uint64_t current = count->load(std::memory_order_relaxed);
+    uint64_t next;
+    do {
+        if (nPendingDel_ > current + nPendingAdd_) {
+            LOG(ERROR) << "there are multi delete, count = " << current
+                       << ", nPendingAdd = " << nPendingAdd_
+                       << ", nPendingDel = " << nPendingDel_;
+            next = 0;
+        } else {
+            next = current + nPendingAdd_ - nPendingDel_;
+        }
+    } while (!count->compare_exchange_weak(current, next,
+                                           std::memory_order_relaxed));
 }
 
 DentryList::DentryList(std::vector<Dentry>* list,
@@ -160,10 +167,31 @@ bool DentryList::IsFull() {
     return limit_ != 0 && size_ >= limit_;
 }
 
+// Lock for mutating one dentry, the memory storage can't be written
+// concurrently, so fallback to the exclusive table lock for it
+class DentryStorage::DentryLockGuard {
+ public:
+    DentryLockGuard(DentryStorage* storage, const std::string& skey) {
+        if (storage->keyLocking_) {
+            tableLock_.emplace(storage->rwLock_);
+            keyLock_.emplace(storage->keyLock_, skey);
+        } else {
+            exclusiveLock_.emplace(storage->rwLock_);
+        }
+    }
+
+ private:
+    absl::optional<ReadLockGuard> tableLock_;
+    absl::optional<NameLockGuard> keyLock_;
+    absl::optional<WriteLockGuard> exclusiveLock_;
+};
+
 DentryStorage::DentryStorage(std::shared_ptr<KVStorage> kvStorage,
                              std::shared_ptr<NameGenerator> nameGenerator,
                              uint64_t nDentry)
-    : kvStorage_(kvStorage),
+    : keyLocking_(kvStorage->Type() !=
+                  KVStorage::STORAGE_TYPE::MEMORY_STORAGE),
+      kvStorage_(kvStorage),
       table4Dentry_(nameGenerator->GetDentryTableName()),
       nDentry_(nDentry),
       conv_() {}
@@ -243,7 +271,8 @@ MetaStatusCode DentryStorage::Find(const Dentry& in,
 }
 
 MetaStatusCode DentryStorage::Insert(const Dentry& dentry) {
-    WriteLockGuard lg(rwLock_);
+    std::string skey = DentryKey(dentry);
+    DentryLockGuard lg(this, skey);
 
     Dentry out;
     DentryVec vec;
@@ -260,7 +289,6 @@ MetaStatusCode DentryStorage::Insert(const Dentry& dentry) {
     // rc == MetaStatusCode::NOT_FOUND
     DentryVector vector(&vec);
     vector.Insert(dentry);
-    std::string skey = DentryKey(dentry);
     Status s = kvStorage_->SSet(table4Dentry_, skey, vec);
     if (!s.ok()) {
         LOG(ERROR) << "Insert dentry failed, status = " << s.ToString();
@@ -271,11 +299,11 @@ MetaStatusCode DentryStorage::Insert(const Dentry& dentry) {
 }
 
 MetaStatusCode DentryStorage::Insert(const DentryVec& vec, bool merge) {
-    WriteLockGuard lg(rwLock_);
+    std::string skey = DentryKey(vec.dentrys(0));
+    DentryLockGuard lg(this, skey);
 
     Status s;
     DentryVec oldVec;
-    std::string skey = DentryKey(vec.dentrys(0));
     if (merge) {  // for old version dumpfile (v1)
         s = kvStorage_->SGet(table4Dentry_, skey, &oldVec);
         if (s.IsNotFound()) {
@@ -297,7 +325,8 @@ MetaStatusCode DentryStorage::Insert(const DentryVec& vec, bool merge) {
 }
 
 MetaStatusCode DentryStorage::Delete(const Dentry& dentry) {
-    WriteLockGuard lg(rwLock_);
+    std::string skey = DentryKey(dentry);
+    DentryLockGuard lg(this, skey);
 
     Dentry out;
     DentryVec vec;
@@ -311,7 +340,6 @@ MetaStatusCode DentryStorage::Delete(const Dentry& dentry) {
     Status s;
     DentryVector vector(&vec);
     vector.Delete(out);
-    std::string skey = DentryKey(dentry);
     if (vec.dentrys_size() == 0) {
         s = kvStorage_->SDel(table4Dentry_, skey);
     } else {
@@ -405,13 +433,13 @@ MetaStatusCode DentryStorage::List(const Dentry& dentry,
 }
 
 MetaStatusCode DentryStorage::HandleTx(TX_OP_TYPE type, const Dentry& dentry) {
-    WriteLockGuard lg(rwLock_);
+    std::string skey = DentryKey(dentry);
+    DentryLockGuard lg(this, skey);
 
     Status s;
     Dentry out;
     DentryVec vec;
     DentryVector vector(&vec);
-    std::string skey = DentryKey(dentry);
     MetaStatusCode rc = MetaStatusCode::OK;
     switch (type) {
         case TX_OP_TYPE::PREPARE:
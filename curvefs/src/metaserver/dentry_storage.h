@@ -23,6 +23,7 @@
 #ifndef CURVEFS_SRC_METASERVER_DENTRY_STORAGE_H_
 #define CURVEFS_SRC_METASERVER_DENTRY_STORAGE_H_
 
+#include <atomic>
 #include <list>
 #include <string>
 #include <vector>
@@ -30,6 +31,7 @@
 #include <functional>
 
 #include "absl/container/btree_set.h"
+#include "src/common/concurrent/name_lock.h"
 #include "src/common/concurrent/rw_lock.h"
 #include "curvefs/proto/metaserver.pb.h"
 #include "curvefs/src/metaserver/storage/storage.h"
@@ -38,6 +40,7 @@
 namespace curvefs {
 namespace metaserver {
 
+using ::curve::common::NameLock;
 using ::curve::common::RWLock;
 using ::curvefs::metaserver::storage::Iterator;
 using ::curvefs::metaserver::storage::NameGenerator;
@@ -67,7 +70,7 @@ class DentryVector {
 
     void Filter(uint64_t maxTxId, BTree* btree);
 
-    void Confirm(uint64_t* count);
+    void Confirm(std::atomic<uint64_t>* count);
 
  private:
     DentryVec* vec_;
@@ -136,6 +139,8 @@ class DentryStorage {
     MetaStatusCode Clear();
 
  private:
+    class DentryLockGuard;
+
     std::string DentryKey(const Dentry& entry);
 
     bool CompressDentry(DentryVec* vec, BTree* dentrys);
@@ -146,10 +151,15 @@ class DentryStorage {
                         bool compress);
 
  private:
+    // |rwLock_| is held exclusively by operations on the whole table,
+    // mutations of a single dentry hold it shared and serialize on the
+    // dentry's key via |keyLock_| if the storage supports concurrent writes
     RWLock rwLock_;
+    NameLock keyLock_;
+    bool keyLocking_;
     std::shared_ptr<KVStorage> kvStorage_;
     std::string table4Dentry_;
-    uint64_t nDentry_;
+    std::atomic<uint64_t> nDentry_;
     Converter conv_;
 };
 
@@ -36,6 +36,7 @@
 
 using ::curve::common::TimeUtility;
 using ::curve::common::NameLockGuard;
+using ::curvefs::metaserver::storage::Key4S3ChunkInfoList;
 using ::google::protobuf::util::MessageDifferencer;
 
 namespace curvefs {
@@ -277,11 +278,37 @@ MetaStatusCode InodeManager::DeleteInode(uint32_t fsId, uint64_t inodeId) {
         // get attr success
         --(*type2InodeNum_)[attr.type()];
     }
+    fragmentIndex_.Erase(inodeId);
     VLOG(6) << "DeleteInode success, fsId = " << fsId
             << ", inodeId = " << inodeId;
     return MetaStatusCode::OK;
 }
 
+MetaStatusCode InodeManager::RebuildS3FragmentIndex() {
+    auto iterator = inodeStorage_->GetAllS3ChunkInfoList();
+    if (iterator->Status() != 0) {
+        LOG(ERROR) << "Get all s3chunkinfo list failed";
+        return MetaStatusCode::STORAGE_INTERNAL_ERROR;
+    }
+
+    // the number of chunk infos is recorded in the key, so the value of
+    // each list needn't be decoded
+    Converter conv;
+    Key4S3ChunkInfoList key;
+    for (iterator->SeekToFirst(); iterator->Valid(); iterator->Next()) {
+        if (!conv.ParseFromString(iterator->Key(), &key)) {
+            LOG(ERROR) << "Parse s3chunkinfo list key failed, key = "
+                       << iterator->Key();
+            return MetaStatusCode::PARSE_FROM_STRING_FAILED;
+        }
+        fragmentIndex_.Update(key.inodeId, key.size, 0);
+    }
+
+    VLOG(3) << "Rebuild s3 fragment index success, fragmented inodes: "
+            << fragmentIndex_.Size();
+    return MetaStatusCode::OK;
+}
+
 MetaStatusCode InodeManager::UpdateInode(const UpdateInodeRequest& request) {
     VLOG(9) << "update inode, fsid: " << request.fsid()
             << ", inodeid: " << request.inodeid();
@@ -299,6 +326,9 @@ MetaStatusCode InodeManager::UpdateInode(const UpdateInodeRequest& request) {
 
     bool needUpdate = false;
     bool needAddTrash = false;
+    const bool truncated = old.type() == FsFileType::TYPE_S3 &&
+                           request.has_length() &&
+                           request.length() < old.length();
 
 #define UPDATE_INODE(param)                  \
     if (request.has_##param()) {            \
@@ -356,6 +386,10 @@ MetaStatusCode InodeManager::UpdateInode(const UpdateInodeRequest& request) {
         --(*type2InodeNum_)[old.type()];
     }
 
+    if (truncated) {
+        fragmentIndex_.MarkTruncated(old.inodeid());
+    }
+
     const S3ChunkInfoMap &map2add = request.s3chunkinfoadd();
     const S3ChunkInfoList *list2add;
     VLOG(9) << "UpdateInode inode " << old.inodeid() << " map2add size "
@@ -371,6 +405,7 @@ MetaStatusCode InodeManager::UpdateInode(const UpdateInodeRequest& request) {
                        << ", retCode=" << rc;
             return rc;
         }
+        fragmentIndex_.Update(old.inodeid(), list2add->s3chunks_size(), 0);
     }
 
     // update extent in request
@@ -423,6 +458,9 @@ MetaStatusCode InodeManager::GetOrModifyS3ChunkInfo(
                        << ", inodeId=" << inodeId << ", retCode=" << rc;
             return rc;
         }
+        fragmentIndex_.Update(
+            inodeId, list2add->s3chunks_size(),
+            list2del == nullptr ? 0 : list2del->s3chunks_size());
         deleted.insert(chunkIndex);
     }
 
@@ -441,6 +479,7 @@ MetaStatusCode InodeManager::GetOrModifyS3ChunkInfo(
                        << ", inodeId=" << inodeId << ", retCode=" << rc;
             return rc;
         }
+        fragmentIndex_.Update(inodeId, 0, list2del->s3chunks_size());
     }
 
     // return if needed
@@ -32,6 +32,7 @@
 #include <list>
 #include "curvefs/proto/metaserver.pb.h"
 #include "curvefs/src/metaserver/inode_storage.h"
+#include "curvefs/src/metaserver/s3fragment_index.h"
 #include "curvefs/src/metaserver/trash.h"
 #include "src/common/concurrent/name_lock.h"
 
@@ -110,6 +111,15 @@ class InodeManager {
 
     bool GetInodeIdList(std::list<uint64_t>* inodeIdList);
 
+    S3FragmentIndex* GetS3FragmentIndex() {
+        return &fragmentIndex_;
+    }
+
+    // Seed the s3 fragment index from the s3 chunk info table, it's used
+    // after the partition is recovered from a storage checkpoint, because no
+    // chunk info list is replayed in that case.
+    MetaStatusCode RebuildS3FragmentIndex();
+
     // Update one or more volume extent slice
     MetaStatusCode UpdateVolumeExtent(uint32_t fsId,
                                       uint64_t inodeId,
@@ -148,6 +158,8 @@ class InodeManager {
     FileType2InodeNumMap* type2InodeNum_;
 
     NameLock inodeLock_;
+
+    S3FragmentIndex fragmentIndex_;
 };
 
 }  // namespace metaserver
@@ -31,6 +31,7 @@
 #include "curvefs/proto/metaserver.pb.h"
 #include "curvefs/src/metaserver/storage/status.h"
 #include "curvefs/src/metaserver/inode_storage.h"
+#include "curvefs/src/metaserver/s3chunkinfo_codec.h"
 #include "curvefs/src/metaserver/storage/converter.h"
 
 namespace curvefs {
@@ -338,11 +339,13 @@ MetaStatusCode InodeStorage::AddS3ChunkInfoList(
     Key4S3ChunkInfoList key(fsId, inodeId, chunkIndex,
                             firstChunkId, lastChunkId, size);
     std::string skey = conv_.SerializeToString(key);
+    PackedS3ChunkInfoList packed;
+    S3ChunkInfoListCodec::Encode(*list2add, &packed);
     Status s;
     if (txn) {
-        s = txn->SSet(table4S3ChunkInfo_, skey, *list2add);
+        s = txn->SSet(table4S3ChunkInfo_, skey, packed);
     } else {
-        s = kvStorage_->SSet(table4S3ChunkInfo_, skey, *list2add);
+        s = kvStorage_->SSet(table4S3ChunkInfo_, skey, packed);
     }
     return s.ok() ? MetaStatusCode::OK :
                     MetaStatusCode::STORAGE_INTERNAL_ERROR;
@@ -465,30 +468,17 @@ MetaStatusCode InodeStorage::PaddingInodeS3ChunkInfo(int32_t fsId,
         return MetaStatusCode::STORAGE_INTERNAL_ERROR;
     }
 
-    auto merge = [](const S3ChunkInfoList& from, S3ChunkInfoList* to) {
-        for (int i = 0; i < from.s3chunks_size(); i++) {
-            auto chunkinfo = to->add_s3chunks();
-            chunkinfo->CopyFrom(from.s3chunks(i));
-        }
-    };
-
+    // lists are decoded and appended to the result directly
     Key4S3ChunkInfoList key;
-    S3ChunkInfoList list;
     for (iterator->SeekToFirst(); iterator->Valid(); iterator->Next()) {
         std::string skey = iterator->Key();
-        std::string svalue = iterator->Value();
         if (!conv_.ParseFromString(skey, &key)) {
             return MetaStatusCode::PARSE_FROM_STRING_FAILED;
-        } else if (!iterator->ParseFromValue(&list)) {
-            return MetaStatusCode::PARSE_FROM_STRING_FAILED;
         }
 
-        uint64_t chunkIndex = key.chunkIndex;
-        auto iter = m->find(chunkIndex);
-        if (iter == m->end()) {
-            m->insert({chunkIndex, list});
-        } else {
-            merge(list, &iter->second);
+        auto* list = &(*m)[key.chunkIndex];
+        if (!S3ChunkInfoListCodec::ParseFromString(iterator->Value(), list)) {
+            return MetaStatusCode::PARSE_FROM_STRING_FAILED;
         }
     }
 
@@ -594,6 +594,8 @@ void Metaserver::InitStorage() {
     LOG_IF(FATAL, !conf_->GetUInt64Value(
         "storage.s3_meta_inside_inode.limit_size",
         &options.s3MetaLimitSizeInsideInode));
+    conf_->GetValueFatalIfFail("storage.load_concurrency",
+                               &options.loadConcurrency);
 
     if (options.type == "rocksdb") {
         storage::ParseRocksdbOptions(conf_.get());
@@ -25,6 +25,8 @@
 #include <glog/logging.h>
 #include <sys/types.h>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <thread>  // NOLINT
 #include <unordered_map>
@@ -40,6 +42,7 @@
 #include "curvefs/src/metaserver/recycle_cleaner.h"
 #include "curvefs/src/metaserver/recycle_manager.h"
 #include "curvefs/src/metaserver/resource_statistic.h"
+#include "curvefs/src/metaserver/s3chunkinfo_codec.h"
 #include "curvefs/src/metaserver/storage/config.h"
 #include "curvefs/src/metaserver/storage/converter.h"
 #include "curvefs/src/metaserver/storage/memory_storage.h"
@@ -91,7 +94,8 @@ bool MetaStoreImpl::Load(const std::string &pathname) {
     WriteLockGuard writeLockGuard(rwLock_);
     MetaStoreFStream fstream(&partitionMap_, kvStorage_,
                              copysetNode_->GetPoolId(),
-                             copysetNode_->GetCopysetId());
+                             copysetNode_->GetCopysetId(),
+                             storageOptions_.loadConcurrency);
 
     const std::string metadata = pathname + "/" + kMetaDataFilename;
 
@@ -136,10 +140,52 @@ bool MetaStoreImpl::Load(const std::string &pathname) {
         return false;
     }
 
+    // nothing but partitions are replayed from a V3 dump file, in-memory
+    // state derived from storage has to be rebuilt here
+    if (!RebuildPartitions()) {
+        LOG(ERROR) << "Failed to rebuild partitions";
+        return false;
+    }
+
     startCompacts();
     return true;
 }
 
+bool MetaStoreImpl::RebuildPartitions() {
+    std::vector<std::shared_ptr<Partition>> partitions;
+    partitions.reserve(partitionMap_.size());
+    for (const auto &part : partitionMap_) {
+        partitions.push_back(part.second);
+    }
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    auto rebuild = [&]() {
+        for (size_t i = next++; i < partitions.size() && !failed.load();
+             i = next++) {
+            if (!partitions[i]->RebuildAfterRecover()) {
+                LOG(ERROR) << "Failed to rebuild partition "
+                           << partitions[i]->GetPartitionId();
+                failed.store(true);
+            }
+        }
+    };
+
+    const size_t concurrency = std::min<size_t>(
+        std::max<uint32_t>(storageOptions_.loadConcurrency, 1),
+        partitions.size());
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < concurrency; i++) {
+        workers.emplace_back(rebuild);
+    }
+    rebuild();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    return !failed.load();
+}
+
 void MetaStoreImpl::SaveBackground(const std::string &path,
                                    DumpFileClosure *child,
                                    OnSnapshotSaveDoneClosure *done) {
@@ -429,8 +475,25 @@ MetaStatusCode MetaStoreImpl::ListDentry(const ListDentryRequest *request,
     auto rc =
         partition->ListDentry(dentry, &dentrys, request->count(), onlyDir);
     response->set_statuscode(rc);
-    if (rc == MetaStatusCode::OK && !dentrys.empty()) {
-        *response->mutable_dentrys() = {dentrys.begin(), dentrys.end()};
+    if (rc != MetaStatusCode::OK || dentrys.empty()) {
+        return rc;
+    }
+
+    *response->mutable_dentrys() = {dentrys.begin(), dentrys.end()};
+    if (request->has_returnattr() && request->returnattr()) {
+        // only inodes in this partition are returned, the others are
+        // fetched by client with BatchGetInodeAttr
+        InodeAttr attr;
+        for (const auto& item : dentrys) {
+            uint64_t inodeId = item.inodeid();
+            if (!partition->IsInodeBelongs(fsId, inodeId)) {
+                continue;
+            }
+            if (partition->GetInodeAttr(fsId, inodeId, &attr) ==
+                MetaStatusCode::OK) {
+                response->add_attr()->Swap(&attr);
+            }
+        }
     }
     return rc;
 }
@@ -757,6 +820,8 @@ MetaStatusCode MetaStoreImpl::SendS3ChunkInfoByStream(
     butil::IOBuf buffer;
     Key4S3ChunkInfoList key;
     Converter conv;
+    S3ChunkInfoList list;
+    std::string value;
     for (iterator->SeekToFirst(); iterator->Valid(); iterator->Next()) {
         std::string skey = iterator->Key();
         if (!conv.ParseFromString(skey, &key)) {
@@ -765,7 +830,15 @@ MetaStatusCode MetaStoreImpl::SendS3ChunkInfoByStream(
 
         VLOG(9) << "Key4S3ChunkInfoList=" << skey;
 
-        PrepareStreamBuffer(&buffer, key.chunkIndex, iterator->Value());
+        // the list is persisted in compact form, but client expects
+        // a serialized S3ChunkInfoList
+        list.Clear();
+        if (!S3ChunkInfoListCodec::ParseFromString(iterator->Value(), &list) ||
+            !list.SerializeToString(&value)) {
+            return MetaStatusCode::PARSE_FROM_STRING_FAILED;
+        }
+
+        PrepareStreamBuffer(&buffer, key.chunkIndex, value);
         if (!connection->Write(buffer)) {
             LOG(ERROR) << "Stream write failed in server-side";
             return MetaStatusCode::RPC_STREAM_ERROR;
@@ -287,6 +287,12 @@ class MetaStoreImpl : public MetaStore {
     // REQUIRES: rwLock_ is held with write permission
     bool ClearInternal();
 
+    // Rebuild in-memory state of all partitions after the storage is
+    // recovered from checkpoint, at most |storage.load_concurrency|
+    // partitions are rebuilt concurrently
+    // REQUIRES: rwLock_ is held with write permission
+    bool RebuildPartitions();
+
  private:
     RWLock rwLock_;  // protect partitionMap_
     std::shared_ptr<KVStorage> kvStorage_;
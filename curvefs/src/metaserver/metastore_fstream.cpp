@@ -20,18 +20,26 @@
  * Author: Jingli Chen (Wine93)
  */
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <functional>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <utility>
 
+#include "absl/memory/memory.h"
 #include "curvefs/proto/common.pb.h"
 #include "curvefs/proto/metaserver.pb.h"
 #include "curvefs/src/metaserver/metastore_fstream.h"
+#include "curvefs/src/metaserver/s3chunkinfo_codec.h"
 #include "curvefs/src/metaserver/storage/converter.h"
 #include "curvefs/src/metaserver/storage/storage_fstream.h"
 #include "curvefs/src/metaserver/copyset/utils.h"
+#include "src/common/concurrent/task_thread_pool.h"
 
 namespace curvefs {
 namespace metaserver {
@@ -44,6 +52,7 @@ using ::curvefs::metaserver::storage::ENTRY_TYPE;
 using ::curvefs::metaserver::storage::IteratorWrapper;
 using ::curvefs::metaserver::storage::LoadFromFile;
 using ::curvefs::metaserver::storage::SaveToFile;
+using ::curve::common::TaskThreadPool;
 
 using ContainerType = std::unordered_map<std::string, std::string>;
 using STORAGE_TYPE = ::curvefs::metaserver::storage::KVStorage::STORAGE_TYPE;
@@ -54,12 +63,130 @@ using Key4S3ChunkInfoList = ::curvefs::metaserver::storage::Key4S3ChunkInfoList;
 
 using ::curvefs::metaserver::storage::Key4VolumeExtentSlice;
 
+namespace {
+
+// Replay entries of different partitions concurrently.
+// All entries of one partition are replayed by the same worker in the order
+// they were submitted, so the per-partition semantic is the same as loading
+// serially. Entries are handed over to workers in batches to amortize the
+// cost of queue operations.
+//
+// NOTE: only legacy (V1/V2) dump files benefit from it, a V3 dump file
+// contains nothing but partitions and pending transactions, the other
+// metadata is restored from the storage checkpoint, see
+// `MetaStoreImpl::RebuildPartitions` for the parallel part of that path.
+class PartitionParallelLoader {
+ public:
+    using Handler = std::function<bool(uint8_t version, ENTRY_TYPE entryType,
+                                       uint32_t partitionId,
+                                       const std::string &key,
+                                       const std::string &value)>;
+
+    PartitionParallelLoader(uint32_t concurrency, Handler handler)
+        : handler_(std::move(handler)), batches_(concurrency), inflight_(0),
+          failed_(false) {
+        for (uint32_t i = 0; i < concurrency; i++) {
+            workers_.emplace_back(new TaskThreadPool<>());
+            workers_.back()->Start(1, kMaxInflightBatchPerWorker);
+        }
+    }
+
+    ~PartitionParallelLoader() {
+        Wait();
+        for (auto &worker : workers_) {
+            worker->Stop();
+        }
+    }
+
+    bool Submit(uint8_t version, ENTRY_TYPE entryType, uint32_t partitionId,
+                const std::string &key, const std::string &value) {
+        if (failed_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        auto index = partitionId % workers_.size();
+        auto &batch = batches_[index];
+        batch.push_back(Entry{version, entryType, partitionId, key, value});
+        if (batch.size() >= kBatchSize) {
+            Flush(index);
+        }
+        return true;
+    }
+
+    // Flush all pending batches and wait until they are replayed
+    bool Wait() {
+        for (size_t i = 0; i < batches_.size(); i++) {
+            Flush(i);
+        }
+
+        std::unique_lock<std::mutex> lk(mtx_);
+        cond_.wait(lk, [this]() { return inflight_ == 0; });
+        return !failed_.load(std::memory_order_relaxed);
+    }
+
+ private:
+    struct Entry {
+        uint8_t version;
+        ENTRY_TYPE entryType;
+        uint32_t partitionId;
+        std::string key;
+        std::string value;
+    };
+
+    void Flush(size_t index) {
+        if (batches_[index].empty()) {
+            return;
+        }
+
+        auto batch = std::make_shared<std::vector<Entry>>();
+        batch->swap(batches_[index]);
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            ++inflight_;
+        }
+
+        workers_[index]->Enqueue([this, batch]() {
+            for (const auto &entry : *batch) {
+                if (failed_.load(std::memory_order_relaxed)) {
+                    break;
+                }
+                if (!handler_(entry.version, entry.entryType,
+                              entry.partitionId, entry.key, entry.value)) {
+                    failed_.store(true, std::memory_order_relaxed);
+                }
+            }
+
+            std::lock_guard<std::mutex> lk(mtx_);
+            if (--inflight_ == 0) {
+                cond_.notify_all();
+            }
+        });
+    }
+
+ private:
+    static constexpr size_t kBatchSize = 1024;
+    static constexpr int kMaxInflightBatchPerWorker = 64;
+
+    Handler handler_;
+    std::vector<std::unique_ptr<TaskThreadPool<>>> workers_;
+    std::vector<std::vector<Entry>> batches_;
+
+    std::mutex mtx_;
+    std::condition_variable cond_;
+    uint64_t inflight_;
+    std::atomic<bool> failed_;
+};
+
+}  // namespace
+
 MetaStoreFStream::MetaStoreFStream(PartitionMap *partitionMap,
                                    std::shared_ptr<KVStorage> kvStorage,
-                                   PoolId poolId, CopysetId copysetId)
+                                   PoolId poolId, CopysetId copysetId,
+                                   uint32_t loadConcurrency)
     : partitionMap_(partitionMap), kvStorage_(std::move(kvStorage)),
       conv_(std::make_shared<Converter>()), poolId_(poolId),
-      copysetId_(copysetId) {}
+      copysetId_(copysetId),
+      loadConcurrency_(std::max<uint32_t>(loadConcurrency, 1)) {}
 
 std::shared_ptr<Partition>
 MetaStoreFStream::GetPartition(uint32_t partitionId) {
@@ -189,7 +316,7 @@ bool MetaStoreFStream::LoadInodeS3ChunkInfoList(uint32_t partitionId,
     if (!conv_->ParseFromString(key, &key4list)) {
         LOG(ERROR) << "Decode Key4S3ChunkInfoList failed";
         return false;
-    } else if (!conv_->ParseFromString(value, &list)) {
+    } else if (!S3ChunkInfoListCodec::ParseFromString(value, &list)) {
         LOG(ERROR) << "Decode S3ChunkInfoList failed";
         return false;
     }
@@ -326,6 +453,30 @@ MetaStoreFStream::NewVolumeExtentListIterator(Partition *partition) {
                                              partitionId, std::move(iterator));
 }
 
+bool MetaStoreFStream::LoadEntry(uint8_t version, ENTRY_TYPE entryType,
+                                 uint32_t partitionId, const std::string &key,
+                                 const std::string &value) {
+    switch (entryType) {
+    case ENTRY_TYPE::PARTITION:
+        return LoadPartition(partitionId, key, value);
+    case ENTRY_TYPE::INODE:
+        return LoadInode(partitionId, key, value);
+    case ENTRY_TYPE::DENTRY:
+        return LoadDentry(version, partitionId, key, value);
+    case ENTRY_TYPE::PENDING_TX:
+        return LoadPendingTx(partitionId, key, value);
+    case ENTRY_TYPE::S3_CHUNK_INFO_LIST:
+        return LoadInodeS3ChunkInfoList(partitionId, key, value);
+    case ENTRY_TYPE::VOLUME_EXTENT:
+        return LoadVolumeExtentList(partitionId, key, value);
+    case ENTRY_TYPE::UNKNOWN:
+        break;
+    }
+
+    LOG(ERROR) << "Load failed, unknown entry type";
+    return false;
+}
+
 bool MetaStoreFStream::Load(const std::string &pathname, uint8_t *version) {
     uint64_t totalPartition = 0;
     uint64_t totalInode = 0;
@@ -334,44 +485,72 @@ bool MetaStoreFStream::Load(const std::string &pathname, uint8_t *version) {
     uint64_t totalVolumeExtent = 0;
     uint64_t totalPendingTx = 0;
 
+    // workers are started on the first entry of a legacy dump file, there
+    // is nothing worth replaying concurrently in a V3 dump file
+    std::unique_ptr<PartitionParallelLoader> loader;
     auto callback = [&](uint8_t version, ENTRY_TYPE entryType,
                         uint32_t partitionId, const std::string &key,
                         const std::string &value) -> bool {
+        if (loader == nullptr && loadConcurrency_ > 1 &&
+            version <= storage::kDumpFileV2) {
+            loader = absl::make_unique<PartitionParallelLoader>(
+                loadConcurrency_,
+                [this](uint8_t version, ENTRY_TYPE entryType,
+                       uint32_t partitionId, const std::string &key,
+                       const std::string &value) {
+                    return LoadEntry(version, entryType, partitionId, key,
+                                     value);
+                });
+        }
+
         switch (entryType) {
         case ENTRY_TYPE::PARTITION:
             ++totalPartition;
+            // partition map is modified, all pending entries must be
+            // replayed before it, usually partitions are at the head of
+            // dumpfile, so there is nothing to wait
+            if (loader != nullptr && !loader->Wait()) {
+                return false;
+            }
             return LoadPartition(partitionId, key, value);
         case ENTRY_TYPE::INODE:
             ++totalInode;
-            return LoadInode(partitionId, key, value);
+            break;
         case ENTRY_TYPE::DENTRY:
             ++totalDentry;
-            return LoadDentry(version, partitionId, key, value);
+            break;
         case ENTRY_TYPE::PENDING_TX:
             ++totalPendingTx;
-            return LoadPendingTx(partitionId, key, value);
+            break;
         case ENTRY_TYPE::S3_CHUNK_INFO_LIST:
             ++totalS3ChunkInfoList;
-            return LoadInodeS3ChunkInfoList(partitionId, key, value);
+            break;
         case ENTRY_TYPE::VOLUME_EXTENT:
             ++totalVolumeExtent;
-            return LoadVolumeExtentList(partitionId, key, value);
-        case ENTRY_TYPE::UNKNOWN:
             break;
+        case ENTRY_TYPE::UNKNOWN:
+            LOG(ERROR) << "Load failed, unknown entry type";
+            return false;
         }
 
-        LOG(ERROR) << "Load failed, unknown entry type";
-        return false;
+        if (loader != nullptr) {
+            return loader->Submit(version, entryType, partitionId, key, value);
+        }
+        return LoadEntry(version, entryType, partitionId, key, value);
     };
 
     auto ret = LoadFromFile(pathname, version, callback);
+    if (loader != nullptr) {
+        ret = loader->Wait() && ret;
+    }
 
     std::ostringstream oss;
     oss << "total partition: " << totalPartition
         << ", total inode: " << totalInode << ", total dentry: " << totalDentry
         << ", total s3chunkinfolist: " << totalS3ChunkInfoList
         << ", total volumeextent: " << totalVolumeExtent
-        << ", total pendingtx: " << totalPendingTx;
+        << ", total pendingtx: " << totalPendingTx
+        << ", load concurrency: " << loadConcurrency_;
 
     if (ret) {
         LOG(INFO) << "Metastore "
@@ -30,6 +30,7 @@
 #include "curvefs/src/metaserver/storage/storage.h"
 #include "curvefs/src/metaserver/storage/iterator.h"
 #include "curvefs/src/metaserver/storage/dumpfile.h"
+#include "curvefs/src/metaserver/storage/storage_fstream.h"
 #include "curvefs/src/metaserver/common/types.h"
 
 #ifndef CURVEFS_SRC_METASERVER_METASTORE_FSTREAM_H_
@@ -42,6 +43,7 @@ using ::curvefs::metaserver::Partition;
 using ::curvefs::metaserver::storage::KVStorage;
 using ::curvefs::metaserver::storage::MergeIterator;
 using ::curvefs::metaserver::storage::DumpFileClosure;
+using ::curvefs::metaserver::storage::ENTRY_TYPE;
 using PartitionMap = std::map<uint32_t, std::shared_ptr<Partition>>;
 
 class MetaStoreFStream {
@@ -49,7 +51,8 @@ class MetaStoreFStream {
     MetaStoreFStream(PartitionMap* partitionMap,
                      std::shared_ptr<KVStorage> kvStorage,
                      PoolId poolId,
-                     CopysetId copysetId);
+                     CopysetId copysetId,
+                     uint32_t loadConcurrency = 1);
 
     bool Load(const std::string& pathname, uint8_t* version);
 
@@ -57,6 +60,12 @@ class MetaStoreFStream {
               DumpFileClosure* done = nullptr);
 
  private:
+    bool LoadEntry(uint8_t version,
+                   ENTRY_TYPE entryType,
+                   uint32_t partitionId,
+                   const std::string& key,
+                   const std::string& value);
+
     bool LoadPartition(uint32_t partitionId,
                        const std::string& key,
                        const std::string& value);
@@ -108,6 +117,10 @@ class MetaStoreFStream {
 
     PoolId poolId_ = 0;
     CopysetId copysetId_ = 0;
+
+    // number of workers which replay entries of different partitions
+    // concurrently, 1 means replay all entries in the loading thread
+    uint32_t loadConcurrency_ = 1;
 };
 
 }  // namespace metaserver
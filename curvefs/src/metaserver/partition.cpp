@@ -523,5 +523,16 @@ void Partition::CancelS3Compact() {
     S3CompactManager::GetInstance().Cancel(partitionInfo_.partitionid());
 }
 
+bool Partition::RebuildAfterRecover() {
+    auto rc = inodeManager_->RebuildS3FragmentIndex();
+    if (rc != MetaStatusCode::OK) {
+        LOG(ERROR) << "Rebuild s3 fragment index failed, partitionId = "
+                   << partitionInfo_.partitionid()
+                   << ", retCode = " << MetaStatusCode_Name(rc);
+        return false;
+    }
+    return true;
+}
+
 }  // namespace metaserver
 }  // namespace curvefs
@@ -165,6 +165,10 @@ class Partition {
 
     void CancelS3Compact();
 
+    // rebuild in-memory state which is not kept in storage,
+    // called after the storage is recovered from checkpoint
+    bool RebuildAfterRecover();
+
     std::string GetInodeTablename();
 
     std::string GetDentryTablename();
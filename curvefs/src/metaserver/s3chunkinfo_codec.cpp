@@ -0,0 +1,131 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-22
+ * Author: curve
+ */
+
+#include "curvefs/src/metaserver/s3chunkinfo_codec.h"
+
+#include <glog/logging.h>
+
+namespace curvefs {
+namespace metaserver {
+
+void S3ChunkInfoListCodec::Encode(const S3ChunkInfoList& list,
+                                  PackedS3ChunkInfoList* packed) {
+    const int count = list.s3chunks_size();
+    packed->Clear();
+    packed->set_count(count);
+    packed->mutable_chunkiddelta()->Reserve(count);
+    packed->mutable_offsetdelta()->Reserve(count);
+    packed->mutable_len()->Reserve(count);
+    packed->mutable_size()->Reserve(count);
+
+    bool hasCompaction = false;
+    bool hasZero = false;
+    uint64_t prevChunkId = 0;
+    uint64_t prevOffset = 0;
+    for (const auto& info : list.s3chunks()) {
+        // unsigned subtraction wraps around, and it will be restored by
+        // the unsigned addition in decoding
+        packed->add_chunkiddelta(
+            static_cast<int64_t>(info.chunkid() - prevChunkId));
+        packed->add_offsetdelta(
+            static_cast<int64_t>(info.offset() - prevOffset));
+        packed->add_len(info.len());
+        packed->add_size(info.size());
+        hasCompaction = hasCompaction || info.compaction() != 0;
+        hasZero = hasZero || info.zero();
+        prevChunkId = info.chunkid();
+        prevOffset = info.offset();
+    }
+
+    if (hasCompaction) {
+        packed->mutable_compaction()->Reserve(count);
+        for (const auto& info : list.s3chunks()) {
+            packed->add_compaction(info.compaction());
+        }
+    }
+
+    if (hasZero) {
+        packed->mutable_zero()->Reserve(count);
+        for (const auto& info : list.s3chunks()) {
+            packed->add_zero(info.zero());
+        }
+    }
+}
+
+bool S3ChunkInfoListCodec::Decode(const PackedS3ChunkInfoList& packed,
+                                  S3ChunkInfoList* list) {
+    const int count = packed.count();
+    if (packed.chunkiddelta_size() != count ||
+        packed.offsetdelta_size() != count ||
+        packed.len_size() != count || packed.size_size() != count ||
+        (packed.compaction_size() != 0 && packed.compaction_size() != count) ||
+        (packed.zero_size() != 0 && packed.zero_size() != count)) {
+        LOG(ERROR) << "Invalid packed s3chunkinfo list, count = " << count;
+        return false;
+    }
+
+    const bool hasCompaction = packed.compaction_size() != 0;
+    const bool hasZero = packed.zero_size() != 0;
+    auto* chunks = list->mutable_s3chunks();
+    chunks->Reserve(chunks->size() + count);
+
+    uint64_t chunkId = 0;
+    uint64_t offset = 0;
+    for (int i = 0; i < count; i++) {
+        chunkId += static_cast<uint64_t>(packed.chunkiddelta(i));
+        offset += static_cast<uint64_t>(packed.offsetdelta(i));
+
+        auto* info = chunks->Add();
+        info->set_chunkid(chunkId);
+        info->set_compaction(hasCompaction ? packed.compaction(i) : 0);
+        info->set_offset(offset);
+        info->set_len(packed.len(i));
+        info->set_size(packed.size(i));
+        info->set_zero(hasZero ? packed.zero(i) : false);
+    }
+
+    return true;
+}
+
+bool S3ChunkInfoListCodec::ParseFromString(const std::string& value,
+                                           S3ChunkInfoList* list) {
+    PackedS3ChunkInfoList packed;
+    if (packed.ParseFromString(value)) {
+        return Decode(packed, list);
+    }
+
+    // persisted by older versions
+    S3ChunkInfoList old;
+    if (!old.ParseFromString(value)) {
+        return false;
+    }
+
+    if (list->s3chunks_size() == 0) {
+        list->Swap(&old);
+    } else {
+        list->MergeFrom(old);
+    }
+    return true;
+}
+
+}  // namespace metaserver
+}  // namespace curvefs
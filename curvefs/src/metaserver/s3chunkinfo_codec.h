@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-22
+ * Author: curve
+ */
+
+#ifndef CURVEFS_SRC_METASERVER_S3CHUNKINFO_CODEC_H_
+#define CURVEFS_SRC_METASERVER_S3CHUNKINFO_CODEC_H_
+
+#include <string>
+
+#include "curvefs/proto/metaserver.pb.h"
+
+namespace curvefs {
+namespace metaserver {
+
+// Convert S3ChunkInfoList from/to the compact form which is persisted
+// in the s3 chunk info table, see `PackedS3ChunkInfoList` for its layout.
+class S3ChunkInfoListCodec {
+ public:
+    static void Encode(const S3ChunkInfoList& list,
+                       PackedS3ChunkInfoList* packed);
+
+    // Decode |packed| and append its entries to |list|
+    static bool Decode(const PackedS3ChunkInfoList& packed,
+                       S3ChunkInfoList* list);
+
+    // Parse a persisted value and append its entries to |list|,
+    // the value may be a `PackedS3ChunkInfoList` or a `S3ChunkInfoList`
+    // which persisted by older versions
+    static bool ParseFromString(const std::string& value,
+                                S3ChunkInfoList* list);
+};
+
+}  // namespace metaserver
+}  // namespace curvefs
+
+#endif  // CURVEFS_SRC_METASERVER_S3CHUNKINFO_CODEC_H_
@@ -298,6 +298,9 @@ int CompactInodeJob::ReadFullChunk(
                     std::chrono::seconds(retryInterval));
                 continue;
             }
+            if (opts_->throttle != nullptr) {
+                opts_->throttle->Add(true, buf.size());
+            }
             for (const auto& req : reqs) {
                 readContent[req->reqIndex] = buf.substr(req->off, req->len);
             }
@@ -359,6 +362,9 @@ int CompactInodeJob::WriteFullChunk(
             newOff + chunkLen - 1, offRoundDown + (index + 1) * blockSize - 1);
         VLOG(9) << "s3compact: put " << objName << ", [" << s3objBegin << "-"
                 << s3objEnd << "]";
+        if (opts_->throttle != nullptr) {
+            opts_->throttle->Add(false, s3objEnd - s3objBegin + 1);
+        }
         ret = ctx.s3adapter->PutObject(
             aws_key,
             fullChunk.substr(s3objBegin - newOff, s3objEnd - s3objBegin + 1));
@@ -373,10 +379,12 @@ int CompactInodeJob::WriteFullChunk(
 }
 
 bool CompactInodeJob::CompactPrecheck(const struct S3CompactTask& task,
-                                             Inode* inode) {
+                                             Inode* inode, bool* retry) {
+    *retry = false;
     // am i copysetnode leader?
     if (!task.copysetNodeWrapper->IsLeaderTerm()) {
         VLOG(6) << "s3compact: i am not the leader, finish";
+        *retry = true;
         return false;
     }
 
@@ -387,6 +395,7 @@ bool CompactInodeJob::CompactPrecheck(const struct S3CompactTask& task,
         LOG(WARNING) << "s3compact: GetInode fail, inodeKey = "
                      << task.inodeKey.fsId << "," << task.inodeKey.inodeId
                      << ", ret = " << MetaStatusCode_Name(ret);
+        *retry = (ret != MetaStatusCode::NOT_FOUND);
         return false;
     }
 
@@ -452,7 +461,7 @@ S3Adapter* CompactInodeJob::SetupS3Adapter(uint64_t fsId,
     return s3adapter;
 }
 
-void CompactInodeJob::CompactChunk(
+bool CompactInodeJob::CompactChunk(
     const struct S3CompactCtx& compactCtx, uint64_t index, const Inode& inode,
     std::unordered_map<uint64_t, std::vector<std::string>>* objsAddedMap,
     ::google::protobuf::Map<uint64_t, S3ChunkInfoList>* s3ChunkInfoAdd,
@@ -475,7 +484,7 @@ void CompactInodeJob::CompactChunk(
     if (validList.empty()) {
         // chunk is not valid, just delete this chunk
         s3ChunkInfoRemove->insert({index, s3chunkinfolist});
-        return;
+        return true;
     }
     // 1.2  first read full chunk
     struct S3NewChunkInfo newChunkInfo;
@@ -485,7 +494,7 @@ void CompactInodeJob::CompactChunk(
         LOG(WARNING) << "s3compact: ReadFullChunk failed, index " << index;
         opts_->s3infoCache->InvalidateS3Info(
             compactCtx.fsId);  // maybe s3info changed?
-        return;
+        return false;
     }
     VLOG(6) << "s3compact: finish read full chunk, size: " << fullChunk.size();
     VLOG(6) << "s3compact: new s3chunk info will be id:"
@@ -499,7 +508,7 @@ void CompactInodeJob::CompactChunk(
         opts_->s3infoCache->InvalidateS3Info(
             compactCtx.fsId);  // maybe s3info changed?
         DeleteObjs(objsAdded, compactCtx.s3adapter);
-        return;
+        return false;
     }
     VLOG(6) << "s3compact: finish write full chunk";
     // 1.4 record add/delete
@@ -517,6 +526,7 @@ void CompactInodeJob::CompactChunk(
     s3ChunkInfoAdd->insert({index, std::move(toAddList)});
     // to remove
     s3ChunkInfoRemove->insert({index, s3chunkinfolist});
+    return true;
 }
 
 void CompactInodeJob::DeleteObjsOfS3ChunkInfoList(
@@ -542,13 +552,14 @@ void CompactInodeJob::DeleteObjsOfS3ChunkInfoList(
     }
 }
 
-void CompactInodeJob::CompactChunks(const S3CompactTask& task) {
+bool CompactInodeJob::CompactChunks(const S3CompactTask& task) {
     VLOG(6) << "s3compact: try to compact, fsId: " << task.inodeKey.fsId
             << " , inodeId: " << task.inodeKey.inodeId;
 
     // full inode including s3 info
     Inode inode;
-    if (!CompactPrecheck(task, &inode)) return;
+    bool retry = false;
+    if (!CompactPrecheck(task, &inode, &retry)) return !retry;
     uint64_t fsId = inode.fsid();
     uint64_t inodeId = inode.inodeid();
 
@@ -561,14 +572,14 @@ void CompactInodeJob::CompactChunks(const S3CompactTask& task) {
     uint32_t objectPrefix;
     S3Adapter* s3adapter = SetupS3Adapter(task.inodeKey.fsId, &s3adapterIndex,
                                         &blockSize, &chunkSize, &objectPrefix);
-    if (s3adapter == nullptr) return;
+    if (s3adapter == nullptr) return false;
     // need compact?
     std::vector<uint64_t> needCompact =
         GetNeedCompact(inode.s3chunkinfomap(), inode.length(), chunkSize);
     if (needCompact.empty()) {
         VLOG(6) << "s3compact: no need to compact " << inode.inodeid();
         opts_->s3adapterManager->ReleaseS3Adapter(s3adapterIndex);
-        return;
+        return true;
     }
 
     // 1. read full chunk & write new objs, each chunk one by one
@@ -582,15 +593,16 @@ void CompactInodeJob::CompactChunks(const S3CompactTask& task) {
     std::vector<uint64_t> indexToDelete;
     VLOG(6) << "s3compact: begin to compact fsId:" << fsId
             << ", inodeId:" << inodeId;
+    bool allCompacted = true;
     for (const auto& index : needCompact) {
         // s3chunklist order: from small chunkid to big chunkid
-        CompactChunk(compactCtx, index, inode, &objsAddedMap, &s3ChunkInfoAdd,
-                     &s3ChunkInfoRemove);
+        allCompacted &= CompactChunk(compactCtx, index, inode, &objsAddedMap,
+                                     &s3ChunkInfoAdd, &s3ChunkInfoRemove);
     }
     if (s3ChunkInfoAdd.empty() && s3ChunkInfoRemove.empty()) {
         VLOG(6) << "s3compact: do nothing to metadata";
         opts_->s3adapterManager->ReleaseS3Adapter(s3adapterIndex);
-        return;
+        return allCompacted;
     }
 
     // 2. update inode
@@ -598,7 +610,7 @@ void CompactInodeJob::CompactChunks(const S3CompactTask& task) {
     if (!task.copysetNodeWrapper->IsValid()) {
         VLOG(6) << "s3compact: invalid copysetNode";
         opts_->s3adapterManager->ReleaseS3Adapter(s3adapterIndex);
-        return;
+        return false;
     }
     std::vector<int> s3ChunkInfoRemoveIndex;
     s3ChunkInfoRemoveIndex.reserve(s3ChunkInfoRemove.size());
@@ -616,7 +628,7 @@ void CompactInodeJob::CompactChunks(const S3CompactTask& task) {
             DeleteObjs(item.second, s3adapter);
         }
         opts_->s3adapterManager->ReleaseS3Adapter(s3adapterIndex);
-        return;
+        return false;
     }
     VLOG(6) << "s3compact: finish update inode";
 
@@ -629,6 +641,7 @@ void CompactInodeJob::CompactChunks(const S3CompactTask& task) {
     VLOG(6) << "s3compact: finish delete objs";
     opts_->s3adapterManager->ReleaseS3Adapter(s3adapterIndex);
     VLOG(6) << "s3compact: compact successfully";
+    return allCompacted;
 }
 
 }  // namespace metaserver
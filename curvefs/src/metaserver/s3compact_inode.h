@@ -169,7 +169,9 @@ class CompactInodeJob {
         const ::google::protobuf::Map<uint64_t, S3ChunkInfoList>&
             s3chunkinfoMap,
         uint64_t inodeLen, uint64_t chunkSize);
-    bool CompactPrecheck(const struct S3CompactTask& task, Inode* inode);
+    // |retry| is set if the inode should be compacted again later
+    bool CompactPrecheck(const struct S3CompactTask& task, Inode* inode,
+                         bool* retry);
     S3Adapter* SetupS3Adapter(uint64_t fsid, uint64_t* s3adapterIndex,
                               uint64_t* blockSize, uint64_t* chunkSize,
                               uint32_t* objectPrefix);
@@ -194,7 +196,7 @@ class CompactInodeJob {
                        const struct S3NewChunkInfo& newChunkInfo,
                        const std::string& fullChunk,
                        std::vector<std::string>* objsAdded);
-    void CompactChunk(
+    bool CompactChunk(
         const struct S3CompactCtx& compactCtx, uint64_t index,
         const Inode& inode,
         std::unordered_map<uint64_t, std::vector<std::string>>* objsAddedMap,
@@ -203,8 +205,9 @@ class CompactInodeJob {
 
     void DeleteObjsOfS3ChunkInfoList(const struct S3CompactCtx& ctx,
                                      const S3ChunkInfoList& s3chunkinfolist);
-    // func bind with task
-    void CompactChunks(const S3CompactTask& task);
+    // func bind with task, return false if the inode is not compacted and
+    // should be compacted again later
+    bool CompactChunks(const S3CompactTask& task);
 };
 
 }  // namespace metaserver
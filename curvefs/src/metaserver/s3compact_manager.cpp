@@ -116,6 +116,8 @@ void S3CompactWorkQueueOption::Init(std::shared_ptr<Configuration> conf) {
     conf->GetValueFatalIfFail("s3compactwq.s3_read_max_retry", &s3ReadMaxRetry);
     conf->GetValueFatalIfFail("s3compactwq.s3_read_retry_interval",
                               &s3ReadRetryInterval);
+    conf->GetValueFatalIfFail("s3compactwq.s3_bandwidth_limit_mb",
+                              &s3BandwidthLimitMB);
 }
 
 void S3CompactManager::Init(std::shared_ptr<Configuration> conf) {
@@ -144,6 +146,16 @@ void S3CompactManager::Init(std::shared_ptr<Configuration> conf) {
         workerOptions_.s3ReadRetryInterval = opts_.s3ReadRetryInterval;
         workerOptions_.sleepMS = opts_.enqueueSleepMS;
 
+        if (opts_.s3BandwidthLimitMB > 0) {
+            curve::common::ReadWriteThrottleParams params;
+            params.bpsTotal.limit = opts_.s3BandwidthLimitMB * 1024 * 1024;
+            throttle_ = absl::make_unique<curve::common::Throttle>();
+            throttle_->UpdateThrottleParams(params);
+            workerOptions_.throttle = throttle_.get();
+            LOG(INFO) << "s3compact: bandwidth limit "
+                      << opts_.s3BandwidthLimitMB << " MB/s";
+        }
+
         inited_ = true;
     } else {
         LOG(INFO) << "s3compact: not enabled";
@@ -204,6 +216,10 @@ void S3CompactManager::Stop() {
     }
 
     workerContext_.cond.notify_all();
+    if (throttle_ != nullptr) {
+        // wake up workers blocked by the bandwidth budget
+        throttle_->Stop();
+    }
     for (auto& worker : workers_) {
         worker->Stop();
     }
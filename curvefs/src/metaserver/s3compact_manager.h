@@ -35,6 +35,7 @@
 #include "src/common/configuration.h"
 #include "src/common/interruptible_sleeper.h"
 #include "src/common/s3_adapter.h"
+#include "src/common/throttle.h"
 #include "curvefs/src/metaserver/s3compact_worker.h"
 
 namespace curvefs {
@@ -80,6 +81,8 @@ struct S3CompactWorkQueueOption {
     uint64_t s3infocacheSize;
     uint64_t s3ReadMaxRetry;
     uint64_t s3ReadRetryInterval;
+    // bandwidth budget in MB/s shared by all workers, 0 means unlimited
+    uint64_t s3BandwidthLimitMB;
 
     void Init(std::shared_ptr<Configuration> conf);
 };
@@ -89,6 +92,7 @@ class S3CompactManager {
     S3CompactWorkQueueOption opts_;
     std::unique_ptr<S3InfoCache> s3infoCache_;
     std::unique_ptr<S3AdapterManager> s3adapterManager_;
+    std::unique_ptr<curve::common::Throttle> throttle_;
 
     S3CompactWorkerContext workerContext_;
     S3CompactWorkerOptions workerOptions_;
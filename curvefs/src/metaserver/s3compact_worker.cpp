@@ -29,6 +29,7 @@
 #include <mutex>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "absl/cleanup/cleanup.h"
 #include "curvefs/src/common/threading.h"
@@ -39,6 +40,13 @@
 namespace curvefs {
 namespace metaserver {
 
+namespace {
+
+// max inodes taken from the fragment index in one round
+constexpr size_t kMaxInodesPerRound = 1024;
+
+}  // namespace
+
 S3CompactWorker::S3CompactWorker(S3CompactManager* manager,
                                  S3CompactWorkerContext* context,
                                  S3CompactWorkerOptions* options)
@@ -109,7 +117,7 @@ void S3CompactWorker::CleanupCompact(bool again) {
     s3Compact_.reset();
 }
 
-bool S3CompactWorker::CompactInodes(const std::list<uint64_t>& inodes,
+bool S3CompactWorker::CompactInodes(const std::vector<uint64_t>& inodes,
                                     copyset::CopysetNode* node) {
     if (inodes.empty()) {
         VLOG(1) << "inode list is empty";
@@ -119,8 +127,18 @@ bool S3CompactWorker::CompactInodes(const std::list<uint64_t>& inodes,
 
     const auto fsId = s3Compact_->partitionInfo.fsid();
     const auto pid = s3Compact_->partitionInfo.partitionid();
+    auto* index = s3Compact_->inodeManager->GetS3FragmentIndex();
 
-    for (auto ino : inodes) {
+    // inodes not compacted in this round are put back into the index
+    size_t next = 0;
+    auto putback = absl::MakeCleanup([&]() {
+        for (; next < inodes.size(); ++next) {
+            index->Finish(inodes[next], false);
+        }
+    });
+
+    for (; next < inodes.size(); ++next) {
+        const auto ino = inodes[next];
         if (!sleeper.wait_for(std::chrono::milliseconds(options_->sleepMS))) {
             return false;
         }
@@ -150,7 +168,7 @@ bool S3CompactWorker::CompactInodes(const std::list<uint64_t>& inodes,
         };
 
         CompactInodeJob job(options_);
-        job.CompactChunks(task);
+        index->Finish(ino, job.CompactChunks(task));
     }
 
     return true;
@@ -176,14 +194,6 @@ void S3CompactWorker::CompactWorker() {
         });
 
         const auto pid = s3Compact_->partitionInfo.partitionid();
-        std::list<uint64_t> inodes;
-        if (!s3Compact_->inodeManager->GetInodeIdList(&inodes)) {
-            compactAgain = false;
-            LOG(WARNING) << "Fail to GetInodeIdList for compact, partitionid: "
-                         << pid << ", stop compact for this partition";
-            continue;
-        }
-
         if (s3Compact_->copysetNode == nullptr) {
             compactAgain = false;
             LOG(WARNING) << "Copyset node is invalid, poolid: "
@@ -195,6 +205,23 @@ void S3CompactWorker::CompactWorker() {
             continue;
         }
 
+        if (!s3Compact_->copysetNode->IsLeaderTerm()) {
+            VLOG(1) << "Current copyset " << s3Compact_->copysetNode->Name()
+                    << " isn't leader, skip this around compaction for "
+                       "partition `"
+                    << pid << "`";
+            sleeper.wait_for(std::chrono::milliseconds(options_->sleepMS));
+            continue;
+        }
+
+        // only the worst fragmented inodes are compacted, the others are
+        // left in the index until they get worse
+        std::vector<uint64_t> inodes;
+        s3Compact_->inodeManager->GetS3FragmentIndex()->Take(
+            options_->fragmentThreshold + 1, kMaxInodesPerRound, &inodes);
+        VLOG(1) << "Take " << inodes.size()
+                << " fragmented inodes to compact, partitionid: " << pid;
+
         compactAgain = CompactInodes(inodes, s3Compact_->copysetNode.get());
     }
 
@@ -29,10 +29,12 @@
 #include <map>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "curvefs/src/metaserver/s3compact.h"
 #include "src/common/interruptible_sleeper.h"
+#include "src/common/throttle.h"
 
 namespace curvefs {
 namespace metaserver {
@@ -58,16 +60,20 @@ struct S3CompactWorkerContext {
 };
 
 struct S3CompactWorkerOptions {
-    S3AdapterManager* s3adapterManager;
-    S3InfoCache* s3infoCache;
+    S3AdapterManager* s3adapterManager = nullptr;
+    S3InfoCache* s3infoCache = nullptr;
 
-    uint64_t maxChunksPerCompact;
-    uint64_t fragmentThreshold;
-    uint64_t s3ReadMaxRetry;
-    uint64_t s3ReadRetryInterval;
+    uint64_t maxChunksPerCompact = 0;
+    uint64_t fragmentThreshold = 0;
+    uint64_t s3ReadMaxRetry = 0;
+    uint64_t s3ReadRetryInterval = 0;
 
     // sleep interval in ms between compacting two inodes
-    uint64_t sleepMS;
+    uint64_t sleepMS = 0;
+
+    // bandwidth budget of s3 reads and writes issued by all workers,
+    // nullptr means unlimited
+    curve::common::Throttle* throttle = nullptr;
 };
 
 // S3CompactWorker compacts one partition at once
@@ -92,7 +98,7 @@ class S3CompactWorker {
     bool WaitCompact();
 
     // Return whether compact current partition again
-    bool CompactInodes(const std::list<uint64_t>& inodes,
+    bool CompactInodes(const std::vector<uint64_t>& inodes,
                        copyset::CopysetNode* node);
 
     void CleanupCompact(bool again);
@@ -0,0 +1,150 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-24
+ * Author: curve
+ */
+
+#include "curvefs/src/metaserver/s3fragment_index.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace curvefs {
+namespace metaserver {
+
+constexpr uint64_t S3FragmentIndex::kTruncatedScore;
+
+void S3FragmentIndex::Update(uint64_t inodeId, uint64_t added,
+                             uint64_t removed) {
+    if (added == 0 && removed == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = scores_.find(inodeId);
+    if (it == scores_.end()) {
+        if (added > removed) {
+            scores_.emplace(inodeId,
+                            std::min(added - removed, kTruncatedScore - 1));
+        }
+        return;
+    }
+
+    uint64_t& score = it->second;
+    if (score == kTruncatedScore) {
+        return;
+    }
+
+    score = (kTruncatedScore - 1 - score < added) ? kTruncatedScore - 1
+                                                   : score + added;
+    score = (score > removed) ? score - removed : 0;
+    if (score == 0) {
+        scores_.erase(it);
+    }
+}
+
+void S3FragmentIndex::MarkTruncated(uint64_t inodeId) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    scores_[inodeId] = kTruncatedScore;
+}
+
+void S3FragmentIndex::Erase(uint64_t inodeId) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    scores_.erase(inodeId);
+    taken_.erase(inodeId);
+}
+
+void S3FragmentIndex::Take(uint64_t minScore, size_t limit,
+                           std::vector<uint64_t>* inodes) {
+    inodes->clear();
+    if (limit == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    std::vector<std::pair<uint64_t, uint64_t>> candidates;  // score, inode
+    for (const auto& item : scores_) {
+        if (item.second >= minScore) {
+            candidates.emplace_back(item.second, item.first);
+        }
+    }
+
+    auto worse = [](const std::pair<uint64_t, uint64_t>& lhs,
+                    const std::pair<uint64_t, uint64_t>& rhs) {
+        return lhs.first > rhs.first;
+    };
+    if (candidates.size() > limit) {
+        std::nth_element(candidates.begin(), candidates.begin() + limit,
+                         candidates.end(), worse);
+        candidates.resize(limit);
+    }
+    std::sort(candidates.begin(), candidates.end(), worse);
+
+    inodes->reserve(candidates.size());
+    for (const auto& item : candidates) {
+        inodes->push_back(item.second);
+        scores_.erase(item.second);
+        taken_[item.second] = item.first;
+    }
+}
+
+void S3FragmentIndex::Finish(uint64_t inodeId, bool compacted) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto taken = taken_.find(inodeId);
+    if (taken == taken_.end()) {
+        // erased meanwhile, e.g. inode is deleted
+        return;
+    }
+
+    const uint64_t previous = taken->second;
+    taken_.erase(taken);
+    if (compacted) {
+        return;
+    }
+
+    // chunk infos appended while the inode was taken are counted again
+    // from zero, so add them up with the previous score
+    auto it = scores_.find(inodeId);
+    if (it == scores_.end()) {
+        scores_.emplace(inodeId, previous);
+        return;
+    }
+
+    uint64_t& score = it->second;
+    if (score == kTruncatedScore || previous == kTruncatedScore) {
+        score = kTruncatedScore;
+        return;
+    }
+    score = (kTruncatedScore - 1 - score < previous) ? kTruncatedScore - 1
+                                                      : score + previous;
+}
+
+uint64_t S3FragmentIndex::GetScore(uint64_t inodeId) const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = scores_.find(inodeId);
+    return it == scores_.end() ? 0 : it->second;
+}
+
+size_t S3FragmentIndex::Size() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return scores_.size();
+}
+
+}  // namespace metaserver
+}  // namespace curvefs
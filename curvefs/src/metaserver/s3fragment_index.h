@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-24
+ * Author: curve
+ */
+
+#ifndef CURVEFS_SRC_METASERVER_S3FRAGMENT_INDEX_H_
+#define CURVEFS_SRC_METASERVER_S3FRAGMENT_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace curvefs {
+namespace metaserver {
+
+// S3FragmentIndex records how fragmented the s3 chunk info of each inode in
+// a partition is, so s3 compaction can pick the worst inodes directly
+// instead of walking all inodes of the partition.
+//
+// The score of an inode is the number of s3 chunk infos appended to it since
+// it was taken by compaction last time. Truncated inodes have the highest
+// score, because their tail objects can be deleted without any rewrite.
+//
+// Inodes handed out by `Take` are parked until the compaction reports back
+// through `Finish`, so an inode whose compaction did not happen (lost
+// leadership, s3 error, canceled) is put back with its score instead of
+// being forgotten.
+//
+// The index is kept in memory only, it is seeded from the s3 chunk info
+// table by `InodeManager::RebuildS3FragmentIndex` after the partition is
+// recovered.
+class S3FragmentIndex {
+ public:
+    static constexpr uint64_t kTruncatedScore = UINT64_MAX;
+
+    void Update(uint64_t inodeId, uint64_t added, uint64_t removed);
+
+    void MarkTruncated(uint64_t inodeId);
+
+    void Erase(uint64_t inodeId);
+
+    // Take at most |limit| inodes whose score is not less than |minScore|
+    // out of the index, the worst inode comes first.
+    void Take(uint64_t minScore, size_t limit, std::vector<uint64_t>* inodes);
+
+    // Report the result of a taken inode, its score is dropped if it was
+    // compacted, otherwise it is merged back into the index.
+    void Finish(uint64_t inodeId, bool compacted);
+
+    uint64_t GetScore(uint64_t inodeId) const;
+
+    size_t Size() const;
+
+ private:
+    mutable std::mutex mtx_;
+    std::unordered_map<uint64_t, uint64_t> scores_;
+    // inodes taken by compaction and not finished yet
+    std::unordered_map<uint64_t, uint64_t> taken_;
+};
+
+}  // namespace metaserver
+}  // namespace curvefs
+
+#endif  // CURVEFS_SRC_METASERVER_S3FRAGMENT_INDEX_H_
@@ -55,6 +55,10 @@ struct StorageOptions {
     // misc config item
     uint64_t s3MetaLimitSizeInsideInode;
 
+    // number of threads which replay legacy dump files or rebuild
+    // partitions after checkpoint recovery concurrently on loading
+    uint32_t loadConcurrency = 1;
+
     curve::fs::LocalFileSystem* localFileSystem = nullptr;
 };
 
@@ -26,6 +26,7 @@
 #include <iostream>
 #include <unordered_map>
 
+#include "absl/memory/memory.h"
 #include "src/common/timeutility.h"
 #include "curvefs/src/metaserver/storage/utils.h"
 #include "curvefs/src/metaserver/storage/storage.h"
@@ -33,6 +34,7 @@
 #include "curvefs/src/metaserver/storage/rocksdb_perf.h"
 #include "curvefs/src/metaserver/storage/rocksdb_storage.h"
 #include "curvefs/src/metaserver/storage/rocksdb_options.h"
+#include "rocksdb/comparator.h"
 #include "rocksdb/utilities/checkpoint.h"
 #include "src/fs/local_filesystem.h"
 
@@ -79,14 +81,14 @@ RocksDBStorage::RocksDBStorage(StorageOptions options)
 }
 
 RocksDBStorage::RocksDBStorage(const RocksDBStorage& storage,
-                               ROCKSDB_NAMESPACE::Transaction* txn)
+                               std::unique_ptr<WriteBatchWithIndex> batch)
     : inited_(storage.inited_),
       options_(storage.options_),
       db_(storage.db_),
       txnDB_(storage.txnDB_),
       handles_(storage.handles_),
       InTransaction_(true),
-      txn_(txn),
+      batch_(std::move(batch)),
       dbOptions_(storage.dbOptions_),
       dbTransOptions_(storage.dbTransOptions_),
       dbWriteOptions_(storage.dbWriteOptions_),
@@ -212,8 +214,10 @@ Status RocksDBStorage::Get(const std::string& name,
     auto handle = GetColumnFamilyHandle(ordered);
     {
         RocksDBPerfGuard guard(OP_GET);
-        s = InTransaction_ ? txn_->Get(dbReadOptions_, handle, ikey, &svalue) :
-                             db_->Get(dbReadOptions_, handle, ikey, &svalue);
+        s = InTransaction_ ?
+            batch_->GetFromBatchAndDB(db_, dbReadOptions_, handle, ikey,
+                                      &svalue) :
+            db_->Get(dbReadOptions_, handle, ikey, &svalue);
     }
     if (s.ok() && !value->ParseFromString(svalue)) {
         return Status::ParsedFailed();
@@ -236,7 +240,7 @@ Status RocksDBStorage::Set(const std::string& name,
     std::string ikey = ToInternalKey(name, key, ordered);
     RocksDBPerfGuard guard(OP_PUT);
     ROCKSDB_NAMESPACE::Status s = InTransaction_ ?
-        txn_->Put(handle, ikey, svalue) :
+        batch_->Put(handle, ikey, svalue) :
         db_->Put(dbWriteOptions_, handle, ikey, svalue);
     return ToStorageStatus(s);
 }
@@ -252,7 +256,7 @@ Status RocksDBStorage::Del(const std::string& name,
     auto handle = GetColumnFamilyHandle(ordered);
     RocksDBPerfGuard guard(OP_DELETE);
     ROCKSDB_NAMESPACE::Status s = InTransaction_ ?
-        txn_->Delete(handle, ikey) :
+        batch_->Delete(handle, ikey) :
         db_->Delete(dbWriteOptions_, handle, ikey);
     return ToStorageStatus(s);
 }
@@ -311,43 +315,42 @@ Status RocksDBStorage::Clear(const std::string& name, bool ordered) {
 }
 
 std::shared_ptr<StorageTransaction> RocksDBStorage::BeginTransaction() {
-    RocksDBPerfGuard guard(OP_BEGIN_TRANSACTION);
-    ROCKSDB_NAMESPACE::Transaction* txn =
-        txnDB_->BeginTransaction(dbWriteOptions_);
-    if (nullptr == txn) {
+    if (!inited_) {
         return nullptr;
     }
-    return std::make_shared<RocksDBStorage>(*this, txn);
+
+    RocksDBPerfGuard guard(OP_BEGIN_TRANSACTION);
+    // overwrite_key must be true, otherwise the iterator which merges
+    // batch and db will return multiple entries for one key
+    auto batch = absl::make_unique<WriteBatchWithIndex>(
+        ROCKSDB_NAMESPACE::BytewiseComparator(), 0, /*overwrite_key*/ true);
+    return std::make_shared<RocksDBStorage>(*this, std::move(batch));
 }
 
 Status RocksDBStorage::Commit() {
-    if (!InTransaction_ || nullptr == txn_) {
+    if (!InTransaction_ || nullptr == batch_) {
         return Status::NotSupported();
     }
 
     RocksDBPerfGuard guard(OP_COMMIT_TRANSACTION);
-    ROCKSDB_NAMESPACE::Status s = txn_->Commit();
+    ROCKSDB_NAMESPACE::Status s =
+        db_->Write(dbWriteOptions_, batch_->GetWriteBatch());
     if (!s.ok()) {
         LOG(ERROR) << "RocksDBStorage commit transaction failed"
                    << ", status=" << s.ToString();
     }
-    delete txn_;
+    batch_.reset();
     return ToStorageStatus(s);
 }
 
 Status RocksDBStorage::Rollback()  {
-    if (!InTransaction_ || nullptr == txn_) {
+    if (!InTransaction_ || nullptr == batch_) {
         return Status::NotSupported();
     }
 
     RocksDBPerfGuard guard(OP_ROLLBACK_TRANSACTION);
-    ROCKSDB_NAMESPACE::Status s = txn_->Rollback();
-    if (!s.ok()) {
-        LOG(ERROR) << "RocksDBStorage rollback transaction failed"
-                   << ", status=" << s.ToString();
-    }
-    delete txn_;
-    return ToStorageStatus(s);
+    batch_.reset();
+    return Status::OK();
 }
 
 StorageOptions RocksDBStorage::GetStorageOptions() const {
@@ -39,6 +39,7 @@
 #include "rocksdb/utilities/transaction.h"
 #include "rocksdb/utilities/transaction_db.h"
 #include "rocksdb/utilities/table_properties_collectors.h"
+#include "rocksdb/utilities/write_batch_with_index.h"
 #include "src/common/concurrent/rw_lock.h"
 #include "curvefs/src/metaserver/storage/utils.h"
 #include "curvefs/src/metaserver/storage/storage.h"
@@ -59,6 +60,7 @@ using ROCKSDB_NAMESPACE::ColumnFamilyDescriptor;
 using ROCKSDB_NAMESPACE::BlockBasedTableOptions;
 using ROCKSDB_NAMESPACE::Transaction;
 using ROCKSDB_NAMESPACE::TransactionDB;
+using ROCKSDB_NAMESPACE::WriteBatchWithIndex;
 using ROCKSDB_NAMESPACE::NewLRUCache;
 using ROCKSDB_NAMESPACE::NewBloomFilterPolicy;
 using ROCKSDB_NAMESPACE::NewFixedPrefixTransform;
@@ -67,13 +69,20 @@ using STORAGE_TYPE = KVStorage::STORAGE_TYPE;
 
 // NOTE: The HSize() and SSize() is an expensive operation for rocksdb storage,
 // you should only invoke it in test cases.
+//
+// Transaction is implemented by an indexed write batch instead of rocksdb's
+// pessimistic transaction, the callers already serialize the mutations of
+// one table by their own lock, so the row locks are pure overhead.
+// All mutations of a transaction are visible to itself and committed by
+// one atomic write (WAL is disabled, raft log plays the role of WAL).
 class RocksDBStorage : public KVStorage, public StorageTransaction {
  public:
     RocksDBStorage();
 
     explicit RocksDBStorage(StorageOptions options);
 
-    RocksDBStorage(const RocksDBStorage& storage, Transaction* txn);
+    RocksDBStorage(const RocksDBStorage& storage,
+                   std::unique_ptr<WriteBatchWithIndex> batch);
 
     bool Open() override;
 
@@ -197,7 +206,7 @@ class RocksDBStorage : public KVStorage, public StorageTransaction {
 
     // only for transaction
     bool InTransaction_;
-    Transaction* txn_ = nullptr;
+    std::unique_ptr<WriteBatchWithIndex> batch_;
 
     // db options
     rocksdb::DBOptions dbOptions_;
@@ -289,22 +298,15 @@ class RocksDBStorageIterator : public Iterator {
         RocksDBPerfGuard guard(OP_GET_SNAPSHOT);
         if (status_ == 0) {
             readOptions_ = storage_->dbReadOptions_;
-            if (storage_->InTransaction_) {
-                readOptions_.snapshot = storage_->txn_->GetSnapshot();
-            } else {
-                readOptions_.snapshot = storage_->db_->GetSnapshot();
-            }
+            readOptions_.snapshot = storage_->db_->GetSnapshot();
         }
     }
 
     ~RocksDBStorageIterator() {
         RocksDBPerfGuard guard(OP_CLEAR_SNAPSHOT);
         if (status_ == 0) {
-            if (storage_->InTransaction_) {
-                storage_->txn_->ClearSnapshot();
-            } else {
-                storage_->db_->ReleaseSnapshot(readOptions_.snapshot);
-            }
+            iter_.reset();
+            storage_->db_->ReleaseSnapshot(readOptions_.snapshot);
         }
     }
 
@@ -328,7 +330,9 @@ class RocksDBStorageIterator : public Iterator {
         {
             RocksDBPerfGuard guard(OP_GET_ITERATOR);
             if (storage_->InTransaction_) {
-                iter_.reset(storage_->txn_->GetIterator(readOptions_, handler));
+                // merge uncommitted mutations of transaction with db
+                iter_.reset(storage_->batch_->NewIteratorWithBase(
+                    handler, storage_->db_->NewIterator(readOptions_, handler)));
             } else {
                 iter_.reset(storage_->db_->NewIterator(readOptions_, handler));
             }
@@ -26,6 +26,7 @@
 namespace curvefs {
 namespace metaserver {
 
+using curve::common::LockGuard;
 using curve::common::ReadLockGuard;
 using curve::common::WriteLockGuard;
 
@@ -112,6 +113,8 @@ MetaStatusCode TxManager::HandleRenameTx(const std::vector<Dentry>& dentrys) {
         return rc;
     }
 
+    LockGuard lg(handleTxMutex_);
+
     // Handle pending TX
     RenameTx pendingTx;
     if (FindPendingTx(&pendingTx)) {
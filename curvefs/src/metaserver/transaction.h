@@ -27,6 +27,7 @@
 #include <memory>
 #include <unordered_map>
 
+#include "src/common/concurrent/concurrent.h"
 #include "src/common/concurrent/rw_lock.h"
 #include "curvefs/src/metaserver/dentry_storage.h"
 
@@ -86,6 +87,10 @@ class TxManager {
  private:
     RWLock rwLock_;
 
+    // dentrys are no longer mutated under one partition lock, this makes
+    // resolving the pending tx and preparing the new one atomic
+    curve::common::Mutex handleTxMutex_;
+
     std::shared_ptr<DentryStorage> storage_;
 
     RenameTx EMPTY_TX, pendingTx_;
@@ -24,7 +24,9 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <ostream>
 #include <sstream>
 #include <utility>
@@ -45,9 +47,10 @@ FreeExtents::FreeExtents(const uint64_t off, const uint64_t len)
       maxExtentSize_(0),
       available_(len),
       extents_(),
+      sizes_(),
       blocks_() {
     if (len != 0) {
-        extents_.emplace(off, maxLength_);
+        InsertExtent(off, maxLength_);
     }
 }
 
@@ -58,6 +61,7 @@ FreeExtents::FreeExtents(const uint64_t maxExtentSize)
       maxExtentSize_(maxExtentSize),
       available_(0),
       extents_(),
+      sizes_(),
       blocks_() {}
 
 FreeExtents::FreeExtents(const uint64_t maxExtentSize,
@@ -69,6 +73,7 @@ FreeExtents::FreeExtents(const uint64_t maxExtentSize,
       maxExtentSize_(maxExtentSize),
       available_(0),
       extents_(),
+      sizes_(),
       blocks_() {}
 
 uint64_t FreeExtents::AllocInternal(const uint64_t size,
@@ -79,109 +84,92 @@ uint64_t FreeExtents::AllocInternal(const uint64_t size,
     }
 
     uint64_t need = size;
-    std::map<uint64_t, uint64_t>::const_iterator iter;
+    std::map<uint64_t, uint64_t>::iterator iter;
 
     // 1. find extents that satisfy hint.leftOffset
     if (hint.leftOffset != AllocateHint::INVALID_OFFSET) {
-        iter = extents_.lower_bound(hint.leftOffset);
-
-        if (iter != extents_.end() && iter->first == hint.leftOffset) {
+        iter = extents_.find(hint.leftOffset);
+        if (iter != extents_.end()) {
             if (iter->second >= need) {
-                exts->emplace_back(iter->first, need);
-
-                if (iter->second == need) {
-                    extents_.erase(iter);
-                } else {
-                    auto newOff = iter->first + need;
-                    auto newLen = iter->second - need;
-                    extents_.erase(iter);
-                    extents_.emplace(newOff, newLen);
-                }
-
+                AllocFromExtent(iter, need, exts);
                 return size;
-            } else {
-                need -= iter->second;
-                exts->emplace_back(iter->first, iter->second);
-
-                extents_.erase(iter);
             }
+
+            need -= iter->second;
+            AllocFromExtent(iter, iter->second, exts);
         }
     }
 
     // 2. find extents that satisfy hint.rightOffset
     if (hint.rightOffset != AllocateHint::INVALID_OFFSET &&
         hint.rightOffset >= need) {
-        iter = extents_.lower_bound(hint.rightOffset - need);
-        if (iter != extents_.end() &&
-            iter->first == (hint.rightOffset - need)) {
+        iter = extents_.find(hint.rightOffset - need);
+        if (iter != extents_.end()) {
             if (iter->second >= need) {
-                exts->emplace_back(iter->first, need);
-
-                if (iter->second == need) {
-                    extents_.erase(iter);
-                } else {
-                    auto newOff = iter->first + need;
-                    auto newLen = iter->second - need;
-                    extents_.erase(iter);
-                    extents_.emplace(newOff, newLen);
-                }
-
+                AllocFromExtent(iter, need, exts);
                 return size;
-            } else {
-                need -= iter->second;
-                exts->emplace_back(iter->first, iter->second);
-
-                extents_.erase(iter);
             }
+
+            need -= iter->second;
+            AllocFromExtent(iter, iter->second, exts);
         }
     }
 
     // both leftOffset and rightOffset aren't satisfied
-    // first loop find a extent that satisfy needed size
-    iter = extents_.begin();
-    while (iter != extents_.end()) {
-        if (iter->second >= need) {
-            exts->emplace_back(iter->first, need);
-
-            // modify this extents
-            if (iter->second == need) {
-                extents_.erase(iter);
-            } else {
-                auto newOff = iter->first + need;
-                auto newLen = iter->second - need;
-                extents_.erase(iter);
-                extents_.emplace(newOff, newLen);
-            }
-
-            return size;
-        } else {
-            ++iter;
-        }
+    // find the smallest extent that satisfy needed size, so large extents
+    // are kept for large allocations
+    auto best = sizes_.lower_bound(std::make_pair(need, uint64_t{0}));
+    if (best != sizes_.end()) {
+        AllocFromExtent(extents_.find(best->second), need, exts);
+        return size;
     }
 
-    // second loop consume all existing extent
+    // no extent is large enough, consume existing extents one by one
     iter = extents_.begin();
     while (need > 0 && iter != extents_.end()) {
-        if (iter->second <= need) {
-            need -= iter->second;
-            exts->emplace_back(iter->first, iter->second);
+        auto len = std::min(need, iter->second);
+        auto next = std::next(iter);
+        AllocFromExtent(iter, len, exts);
+        need -= len;
+        iter = next;
+    }
 
-            // remove this extent
-            iter = extents_.erase(iter);
-        } else {  // iter->second > need
-            exts->emplace_back(iter->first, need);
+    return size - need;
+}
 
-            auto newOff = iter->first + need;
-            auto newLen = iter->second - need;
+void FreeExtents::AllocFromExtent(std::map<uint64_t, uint64_t>::iterator iter,
+                                  const uint64_t size,
+                                  std::vector<Extent>* exts) {
+    exts->emplace_back(iter->first, size);
 
-            extents_.erase(iter);
-            extents_.emplace(newOff, newLen);
+    const auto newOff = iter->first + size;
+    const auto newLen = iter->second - size;
+    EraseExtent(iter);
+    if (newLen != 0) {
+        InsertExtent(newOff, newLen);
+    }
+}
 
-            return size;
-        }
+std::map<uint64_t, uint64_t>::iterator FreeExtents::InsertExtent(
+    const uint64_t off, const uint64_t len) {
+    auto r = extents_.emplace(off, len);
+    if (r.second) {
+        sizes_.emplace(len, off);
     }
+    return r.first;
+}
 
-    return size - need;
+std::map<uint64_t, uint64_t>::iterator FreeExtents::EraseExtent(
+    std::map<uint64_t, uint64_t>::iterator iter) {
+    sizes_.erase(std::make_pair(iter->second, iter->first));
+    return extents_.erase(iter);
+}
+
+void FreeExtents::ResizeExtent(std::map<uint64_t, uint64_t>::iterator iter,
+                               const uint64_t len) {
+    sizes_.erase(std::make_pair(iter->second, iter->first));
+    iter->second = len;
+    sizes_.emplace(len, iter->first);
 }
 
 uint64_t FreeExtents::AvailableBlocks(std::map<uint64_t, uint64_t>* blocks) {
@@ -216,9 +204,9 @@ void FreeExtents::DeAllocInternal(const uint64_t off, const uint64_t len) {
     assert((length_ == 0) ||
            (off >= startOffset_ && off + len <= startOffset_ + length_));
 
-    if (available_ == 0) {
+    if (available_ == 0 || extents_.empty()) {
         // FIXME: off/len may need recycle to blocks
-        extents_.emplace(off, len);
+        InsertExtent(off, len);
         return;
     }
 
@@ -229,22 +217,21 @@ void FreeExtents::DeAllocInternal(const uint64_t off, const uint64_t len) {
         --iter;
     }
     if ((iter->first + iter->second) == off) {
-        iter->second += len;
+        ResizeExtent(iter, iter->second + len);
         curIter = iter;
     } else {
         // TODO(wuhanqing): should tackle iter->first + iter->second > off ?
-        auto r = extents_.emplace(off, len);
-        curIter = r.first;
+        curIter = InsertExtent(off, len);
     }
 
     // try merge with right extent
     const auto endOff = curIter->first + curIter->second;
-    iter = extents_.lower_bound(endOff);
-    if (iter != extents_.end() && iter->first == endOff) {
-        curIter->second += iter->second;
+    iter = extents_.find(endOff);
+    if (iter != extents_.end()) {
+        ResizeExtent(curIter, curIter->second + iter->second);
 
         // erase current iterator
-        extents_.erase(iter);
+        EraseExtent(iter);
     }
 
     // split it if it's big enough
@@ -256,21 +243,21 @@ void FreeExtents::DeAllocInternal(const uint64_t off, const uint64_t len) {
             }
 
             blocks_.emplace(curIter->first, curIter->second);
-            extents_.erase(curIter);
+            EraseExtent(curIter);
             return;
         } else {
             auto start = curIter->first;
             auto end = start + curIter->second;
-            extents_.erase(curIter);
+            EraseExtent(curIter);
 
             auto alignStart = align_up(start, maxExtentSize_);
             auto alignEnd = align_down(end, maxExtentSize_);
 
             if (start != alignStart) {
-                extents_.emplace(start, alignStart - start);
+                InsertExtent(start, alignStart - start);
             }
             if (end != alignEnd) {
-                extents_.emplace(alignEnd, end - alignEnd);
+                InsertExtent(alignEnd, end - alignEnd);
             }
 
             while (alignStart < alignEnd) {
@@ -290,13 +277,13 @@ void FreeExtents::MarkUsedInternal(const uint64_t off, const uint64_t len) {
 
     auto iter = extents_.lower_bound(off);
     if (iter != extents_.end() && iter->first == off) {
-        if (iter->first == off && iter->second == len) {
-            extents_.erase(iter);
+        if (iter->second == len) {
+            EraseExtent(iter);
         } else {
             auto newOff = iter->first + len;
             auto newLen = iter->second - len;
-            extents_.erase(iter);
-            extents_.emplace(newOff, newLen);
+            EraseExtent(iter);
+            InsertExtent(newOff, newLen);
         }
     } else {
         if (iter != extents_.begin()) {
@@ -304,19 +291,13 @@ void FreeExtents::MarkUsedInternal(const uint64_t off, const uint64_t len) {
         }
 
         if ((iter->first + iter->second) == (off + len)) {
-            auto newOff = iter->first;
-            auto newLen = iter->second - len;
-            extents_.erase(iter);
-            extents_.emplace(newOff, newLen);
+            ResizeExtent(iter, iter->second - len);
         } else {
             // [off, len] is in the middle of [iter->first, iter->second]
-            auto leftOff = iter->first;
-            auto leftLen = off - iter->first;
             auto rightOff = off + len;
             auto rightLen = (iter->first + iter->second) - rightOff;
-            extents_.erase(iter);
-            extents_.emplace(leftOff, leftLen);
-            extents_.emplace(rightOff, rightLen);
+            ResizeExtent(iter, off - iter->first);
+            InsertExtent(rightOff, rightLen);
         }
     }
 }
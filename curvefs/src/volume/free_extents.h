@@ -25,6 +25,8 @@
 
 #include <cstdint>
 #include <map>
+#include <set>
+#include <utility>
 #include <vector>
 #include <cassert>
 
@@ -118,6 +120,19 @@ class FreeExtents {
 
     void MarkUsedInternal(const uint64_t off, const uint64_t len);
 
+    // keep |extents_| and |sizes_| consistent
+    std::map<uint64_t, uint64_t>::iterator InsertExtent(const uint64_t off,
+                                                        const uint64_t len);
+    std::map<uint64_t, uint64_t>::iterator EraseExtent(
+        std::map<uint64_t, uint64_t>::iterator iter);
+    void ResizeExtent(std::map<uint64_t, uint64_t>::iterator iter,
+                      const uint64_t len);
+
+    // allocate |size| from the front of extent |iter|
+    void AllocFromExtent(std::map<uint64_t, uint64_t>::iterator iter,
+                         const uint64_t size,
+                         std::vector<Extent>* exts);
+
  private:
     const uint64_t startOffset_;
     const uint64_t length_;
@@ -125,7 +140,10 @@ class FreeExtents {
     const uint64_t maxExtentSize_;
     uint64_t available_;
 
+    // free extents indexed by offset, for merging and hint allocation
     std::map<uint64_t, uint64_t> extents_;
+    // the same extents indexed by <length, offset>, for best-fit allocation
+    std::set<std::pair<uint64_t, uint64_t>> sizes_;
     std::map<uint64_t, uint64_t> blocks_;
 };
 
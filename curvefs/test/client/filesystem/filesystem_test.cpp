@@ -248,8 +248,8 @@ TEST_F(FileSystemTest, ReadDir_Basic) {
     fi.fh = handler->fh;
 
     // CASE 1: readdir success
-    EXPECT_CALL_RETURN_ListDentry(*builder.GetDentryManager(),
-                                  CURVEFS_ERROR::OK);
+    EXPECT_CALL_RETURN_ListDentryPlus(*builder.GetDentryManager(),
+                                      CURVEFS_ERROR::OK);
     EXPECT_CALL_RETURN_BatchGetInodeAttrAsync(*builder.GetInodeManager(),
                                               CURVEFS_ERROR::OK);
 
@@ -287,15 +287,16 @@ TEST_F(FileSystemTest, ReadDir_CheckEntries) {
 
     // CASE 1: check entries
     {
-        EXPECT_CALL_INVOKE_ListDentry(*builder.GetDentryManager(),
+        EXPECT_CALL_INVOKE_ListDentryPlus(*builder.GetDentryManager(),
             [&](uint64_t parent,
                 std::list<Dentry>* dentries,
-                uint32_t limit,
-                bool only,
-                uint32_t nlink) -> CURVEFS_ERROR {
+                std::map<uint64_t, InodeAttr>* attrs,
+                uint32_t limit) -> CURVEFS_ERROR {
                 for (auto ino = 100; ino <= 102; ino++) {
                     dentries->push_back(MkDentry(ino, StrFormat("f%d", ino)));
                 }
+                // attribute returned together with dentry
+                attrs->emplace(101, MkAttr(101, AttrOption().mtime(123, 101)));
                 return CURVEFS_ERROR::OK;
             });
 
@@ -303,6 +304,7 @@ TEST_F(FileSystemTest, ReadDir_CheckEntries) {
             [&](uint64_t parentId,
                 std::set<uint64_t>* inos,
                 std::map<uint64_t, InodeAttr>* attrs) -> CURVEFS_ERROR {
+                EXPECT_EQ(*inos, (std::set<uint64_t>{100, 102}));
                 for (const auto& ino : *inos) {
                     auto attr = MkAttr(ino, AttrOption().mtime(123, ino));
                     attrs->emplace(ino, attr);
@@ -106,8 +106,8 @@ TEST_F(RPCClientTest, ReadDir_Basic) {
 
     // CASE 1: ok
     {
-        EXPECT_CALL_RETURN_ListDentry(*builder.GetDentryManager(),
-                                      CURVEFS_ERROR::OK);
+        EXPECT_CALL_RETURN_ListDentryPlus(*builder.GetDentryManager(),
+                                          CURVEFS_ERROR::OK);
         EXPECT_CALL_RETURN_BatchGetInodeAttrAsync(*builder.GetInodeManager(),
                                                   CURVEFS_ERROR::OK);
 
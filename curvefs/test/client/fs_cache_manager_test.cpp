@@ -23,6 +23,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <thread>
+#include <vector>
+
 #include "curvefs/src/client/s3/client_s3_adaptor.h"
 #include "curvefs/src/client/s3/client_s3_cache_manager.h"
 #include "src/common/concurrent/count_down_event.h"
@@ -158,6 +161,71 @@ TEST_F(FsCacheManagerTest, test_lru_set_and_delete) {
     }
 }
 
+TEST_F(FsCacheManagerTest, test_sharded_lru) {
+    uint64_t dataCacheByte = 128ull * 1024;  // 128KiB
+    char *buf = new char[dataCacheByte];
+    auto fsCacheManager = std::make_shared<FsCacheManager>(
+        s3ClientAdaptor_, maxReadCacheByte_, maxReadCacheByte_, 1, nullptr, 4);
+    std::list<DataCachePtr>::iterator outIter;
+
+    for (size_t i = 0; i < maxReadCacheByte_ / dataCacheByte; ++i) {
+        ASSERT_TRUE(fsCacheManager->Set(
+            std::make_shared<DataCache>(s3ClientAdaptor_,
+                                        mockChunkCacheManager_, 0,
+                                        dataCacheByte, buf, nullptr),
+            &outIter));
+    }
+    ASSERT_EQ(maxReadCacheByte_, fsCacheManager->GetLruByte());
+
+    // lru byte is limited globally, whichever shard the data cache goes to
+    {
+        const uint32_t expectCallTimes = 1;
+        curve::common::CountDownEvent counter(expectCallTimes);
+
+        EXPECT_CALL(*mockChunkCacheManager_, ReleaseReadDataCache(_))
+            .Times(expectCallTimes)
+            .WillRepeatedly(Invoke([&counter](uint64_t) { counter.Signal(); }));
+        ASSERT_TRUE(fsCacheManager->Set(
+            std::make_shared<DataCache>(s3ClientAdaptor_,
+                                        mockChunkCacheManager_, 0,
+                                        dataCacheByte, buf, nullptr),
+            &outIter));
+        counter.Wait();
+    }
+    ASSERT_EQ(maxReadCacheByte_, fsCacheManager->GetLruByte());
+
+    fsCacheManager->Get(outIter);
+    ASSERT_TRUE(fsCacheManager->Delete(outIter));
+    ASSERT_EQ(maxReadCacheByte_ - dataCacheByte,
+              fsCacheManager->GetLruByte());
+
+    // concurrent insertions to different shards
+    EXPECT_CALL(*mockChunkCacheManager_, ReleaseReadDataCache(_))
+        .WillRepeatedly(Return());
+    const int threadNum = 8;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadNum; ++i) {
+        threads.emplace_back([&]() {
+            std::list<DataCachePtr>::iterator iter;
+            for (int j = 0; j < 64; ++j) {
+                fsCacheManager->Set(
+                    std::make_shared<DataCache>(s3ClientAdaptor_,
+                                                mockChunkCacheManager_, 0,
+                                                dataCacheByte, buf, nullptr),
+                    &iter);
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    ASSERT_LE(fsCacheManager->GetLruByte(),
+              maxReadCacheByte_ + threadNum * dataCacheByte);
+
+    fsCacheManager.reset();
+    delete[] buf;
+}
+
 TEST_F(FsCacheManagerTest, test_fsSync_ok) {
     uint64_t inodeId = 1;
     auto fileCache = std::make_shared<MockFileCacheManager>();
@@ -74,16 +74,22 @@ class MockDiskCacheManager2 : public DiskCacheManager {
 
 class MockDiskCacheManagerImpl : public DiskCacheManagerImpl {
  public:
-    MockDiskCacheManagerImpl() : DiskCacheManagerImpl() {}
+    MockDiskCacheManagerImpl() : DiskCacheManagerImpl() {
+        ON_CALL(*this, AdmitReadCache(::testing::_))
+            .WillByDefault(::testing::Return(true));
+    }
     MockDiskCacheManagerImpl(std::shared_ptr<DiskCacheManager> diskCacheManager,
                              std::shared_ptr<S3Client> client)
         : DiskCacheManagerImpl(std::move(diskCacheManager), std::move(client)) {
+        ON_CALL(*this, AdmitReadCache(::testing::_))
+            .WillByDefault(::testing::Return(true));
     }
     ~MockDiskCacheManagerImpl() {}
 
     MOCK_METHOD1(UploadWriteCacheByInode, int(const std::string &inode));
     MOCK_METHOD1(ClearReadCache, int(const std::list<std::string> &files));
     MOCK_METHOD1(IsCached, bool(const std::string));
+    MOCK_METHOD1(AdmitReadCache, bool(const std::string &name));
 };
 
 }  // namespace client
@@ -62,6 +62,10 @@ class MockMetaServerClient : public MetaServerClient {
             const std::string &last, uint32_t count, bool onlyDir,
             std::list<Dentry> *dentryList));
 
+    MOCK_METHOD6(ListDentryPlus, MetaStatusCode(uint32_t fsId,
+            uint64_t inodeid, const std::string &last, uint32_t count,
+            std::list<Dentry> *dentryList, std::list<InodeAttr> *attrs));
+
     MOCK_METHOD1(CreateDentry, MetaStatusCode(const Dentry &dentry));
 
     MOCK_METHOD4(DeleteDentry, MetaStatusCode(
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-28
+ * Author: curve
+ */
+
+#include "curvefs/src/client/s3/page_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+namespace curvefs {
+namespace client {
+
+TEST(PagePoolTest, ReuseReleasedPage) {
+    const uint32_t pageSize = 4096;
+    PagePool pool;
+    pool.Init(pageSize, 2 * pageSize);
+
+    PageData* page = pool.Allocate(1);
+    ASSERT_EQ(1, page->index);
+    ASSERT_EQ(pageSize, pool.GetInuseBytes());
+    memset(page->data, 'a', pageSize);
+    char* data = page->data;
+
+    pool.Release(page);
+    ASSERT_EQ(0, pool.GetInuseBytes());
+    ASSERT_EQ(pageSize, pool.GetIdleBytes());
+
+    // the released page is reused and zeroed
+    page = pool.Allocate(2);
+    ASSERT_EQ(data, page->data);
+    ASSERT_EQ(2, page->index);
+    ASSERT_EQ(0, pool.GetIdleBytes());
+    for (uint32_t i = 0; i < pageSize; i++) {
+        ASSERT_EQ(0, page->data[i]);
+    }
+    pool.Release(page);
+}
+
+TEST(PagePoolTest, MaxIdleBytes) {
+    const uint32_t pageSize = 4096;
+    PagePool pool;
+    pool.Init(pageSize, 2 * pageSize);
+
+    PageData* pages[4];
+    for (auto& page : pages) {
+        page = pool.Allocate(0);
+    }
+    ASSERT_EQ(4 * pageSize, pool.GetInuseBytes());
+
+    for (auto& page : pages) {
+        pool.Release(page);
+    }
+    ASSERT_EQ(0, pool.GetInuseBytes());
+    ASSERT_EQ(2 * pageSize, pool.GetIdleBytes());
+
+    // idle pages are dropped when page size changes
+    pool.Init(2 * pageSize, 0);
+    ASSERT_EQ(0, pool.GetIdleBytes());
+    PageData* page = pool.Allocate(0);
+    ASSERT_EQ(2 * pageSize, pool.GetInuseBytes());
+    pool.Release(page);
+    ASSERT_EQ(0, pool.GetIdleBytes());
+}
+
+}  // namespace client
+}  // namespace curvefs
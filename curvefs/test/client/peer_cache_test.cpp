@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-30
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "curvefs/src/client/kvclient/peer_cache_ring.h"
+#include "curvefs/src/client/kvclient/peer_cache_store.h"
+
+namespace curvefs {
+namespace client {
+
+TEST(PeerCacheRingTest, Locate) {
+    PeerCacheRing ring(100);
+    std::string peer;
+    ASSERT_FALSE(ring.Locate("key", &peer));
+
+    std::vector<std::string> peers{"127.0.0.1:9200", "127.0.0.1:9201",
+                                   "127.0.0.1:9202"};
+    ASSERT_TRUE(ring.Update(peers));
+    // same peers in another order and with duplicates
+    ASSERT_FALSE(ring.Update({peers[2], peers[0], peers[1], peers[0]}));
+    ASSERT_EQ(peers, ring.GetPeers());
+
+    // every client locates the same owner
+    PeerCacheRing other(100);
+    ASSERT_TRUE(other.Update({peers[1], peers[2], peers[0]}));
+
+    std::map<std::string, int> owned;
+    for (int i = 0; i < 3000; i++) {
+        std::string key = "1_16_" + std::to_string(i) + "_0_0";
+        std::string owner;
+        ASSERT_TRUE(ring.Locate(key, &peer));
+        ASSERT_TRUE(other.Locate(key, &owner));
+        ASSERT_EQ(peer, owner);
+        owned[peer]++;
+    }
+
+    // keys are spread over all peers
+    ASSERT_EQ(3, owned.size());
+    for (const auto& item : owned) {
+        ASSERT_GT(item.second, 500);
+    }
+}
+
+TEST(PeerCacheRingTest, PeerLeave) {
+    PeerCacheRing ring(100);
+    std::vector<std::string> peers{"127.0.0.1:9200", "127.0.0.1:9201",
+                                   "127.0.0.1:9202"};
+    ASSERT_TRUE(ring.Update(peers));
+
+    std::vector<std::string> before;
+    for (int i = 0; i < 1000; i++) {
+        std::string peer;
+        ASSERT_TRUE(ring.Locate(std::to_string(i), &peer));
+        before.push_back(peer);
+    }
+
+    // only the keys of the left peer move
+    ASSERT_TRUE(ring.Update({peers[0], peers[1]}));
+    for (int i = 0; i < 1000; i++) {
+        std::string peer;
+        ASSERT_TRUE(ring.Locate(std::to_string(i), &peer));
+        ASSERT_NE(peers[2], peer);
+        if (before[i] != peers[2]) {
+            ASSERT_EQ(before[i], peer);
+        }
+    }
+}
+
+TEST(PeerCacheStoreTest, PutGet) {
+    PeerCacheStore store(10);
+    char buf[10];
+
+    ASSERT_FALSE(store.Get("a", 0, 1, buf));
+
+    store.Put("a", "0123", 4);
+    ASSERT_TRUE(store.Get("a", 1, 3, buf));
+    ASSERT_EQ("123", std::string(buf, 3));
+
+    // out of range
+    ASSERT_FALSE(store.Get("a", 2, 3, buf));
+    ASSERT_FALSE(store.Get("a", 5, 0, buf));
+
+    // overwrite
+    store.Put("a", "abc", 3);
+    ASSERT_EQ(3, store.GetBytes());
+    ASSERT_TRUE(store.Get("a", 0, 3, buf));
+    ASSERT_EQ("abc", std::string(buf, 3));
+
+    // larger than the store
+    store.Put("b", "0123456789a", 11);
+    ASSERT_FALSE(store.Get("b", 0, 1, buf));
+    ASSERT_EQ(1, store.Size());
+}
+
+TEST(PeerCacheStoreTest, Evict) {
+    PeerCacheStore store(10);
+    char buf[4];
+
+    store.Put("a", "aaaa", 4);
+    store.Put("b", "bbbb", 4);
+    // "b" becomes the least recently used one
+    ASSERT_TRUE(store.Get("a", 0, 4, buf));
+
+    store.Put("c", "cccc", 4);
+    ASSERT_EQ(8, store.GetBytes());
+    ASSERT_EQ(2, store.Size());
+    ASSERT_FALSE(store.Get("b", 0, 4, buf));
+    ASSERT_TRUE(store.Get("a", 0, 4, buf));
+    ASSERT_TRUE(store.Get("c", 0, 4, buf));
+}
+
+}  // namespace client
+}  // namespace curvefs
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-27
+ * Author: curve
+ */
+
+#include "curvefs/src/client/s3/prefetch_tracker.h"
+
+#include <gtest/gtest.h>
+
+namespace curvefs {
+namespace client {
+
+TEST(PrefetchTrackerTest, Sequential) {
+    PrefetchTracker tracker;
+    auto window = tracker.Access(0, 0, 2, 16);
+    ASSERT_EQ(0, window.start);
+    ASSERT_EQ(2, window.count);
+    ASSERT_EQ(AccessPattern::UNKNOWN, tracker.GetPattern());
+
+    // reads in the same block prefetch nothing
+    window = tracker.Access(0, 0, 2, 16);
+    ASSERT_EQ(0, window.count);
+
+    // the window doubles on every new block
+    uint32_t expected[] = {4, 8, 16, 16};
+    for (uint64_t block = 1; block <= 4; block++) {
+        window = tracker.Access(block, block, 2, 16);
+        ASSERT_EQ(AccessPattern::SEQUENTIAL, tracker.GetPattern());
+        ASSERT_EQ(block, window.start);
+        ASSERT_EQ(1, window.stride);
+        ASSERT_EQ(expected[block - 1], window.count);
+    }
+
+    // read across blocks
+    window = tracker.Access(5, 7, 2, 16);
+    ASSERT_EQ(AccessPattern::SEQUENTIAL, tracker.GetPattern());
+    window = tracker.Access(7, 8, 2, 16);
+    ASSERT_EQ(AccessPattern::SEQUENTIAL, tracker.GetPattern());
+    ASSERT_EQ(16, window.count);
+}
+
+TEST(PrefetchTrackerTest, Strided) {
+    PrefetchTracker tracker;
+    tracker.Access(0, 0, 1, 8);
+
+    // the first jump looks random
+    auto window = tracker.Access(4, 4, 1, 8);
+    ASSERT_EQ(AccessPattern::RANDOM, tracker.GetPattern());
+    ASSERT_EQ(0, window.count);
+
+    window = tracker.Access(8, 8, 1, 8);
+    ASSERT_EQ(AccessPattern::STRIDED, tracker.GetPattern());
+    ASSERT_EQ(8, window.start);
+    ASSERT_EQ(4, window.stride);
+    ASSERT_EQ(1, window.count);
+
+    window = tracker.Access(12, 12, 1, 8);
+    ASSERT_EQ(AccessPattern::STRIDED, tracker.GetPattern());
+    ASSERT_EQ(2, window.count);
+}
+
+TEST(PrefetchTrackerTest, Random) {
+    PrefetchTracker tracker;
+    tracker.Access(100, 100, 4, 16);
+    tracker.Access(101, 101, 4, 16);
+
+    uint64_t blocks[] = {7, 300, 20, 3};
+    for (auto block : blocks) {
+        auto window = tracker.Access(block, block, 4, 16);
+        ASSERT_EQ(AccessPattern::RANDOM, tracker.GetPattern());
+        ASSERT_EQ(0, window.count);
+    }
+
+    // back to sequential, the window restarts from the minimum
+    auto window = tracker.Access(4, 4, 4, 16);
+    ASSERT_EQ(AccessPattern::SEQUENTIAL, tracker.GetPattern());
+    ASSERT_EQ(4, window.count);
+}
+
+}  // namespace client
+}  // namespace curvefs
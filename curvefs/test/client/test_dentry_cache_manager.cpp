@@ -25,6 +25,9 @@
 #include <google/protobuf/util/message_differencer.h>
 #include <unistd.h>
 
+#include <chrono>
+#include <future>
+
 #include "curvefs/test/client/mock_metaserver_client.h"
 #include "curvefs/src/client/dentry_cache_manager.h"
 
@@ -238,6 +241,144 @@ TEST_F(TestDentryCacheManager, ListDentryFailed) {
     ASSERT_EQ(0, out.size());
 }
 
+TEST_F(TestDentryCacheManager, ListDentryPlus) {
+    uint64_t parent = 99;
+
+    std::list<Dentry> part1, part2;
+    uint32_t limit = 100;
+    part1.resize(limit);
+    part2.resize(1);
+
+    std::list<InodeAttr> attrs1, attrs2;
+    for (uint64_t ino = 1; ino <= 3; ino++) {
+        InodeAttr attr;
+        attr.set_inodeid(ino);
+        (ino < 3 ? attrs1 : attrs2).push_back(attr);
+    }
+
+    EXPECT_CALL(*metaClient_, ListDentryPlus(fsId_, parent, _, limit, _, _))
+        .WillOnce(DoAll(SetArgPointee<4>(part1), SetArgPointee<5>(attrs1),
+                Return(MetaStatusCode::OK)))
+        .WillOnce(DoAll(SetArgPointee<4>(part2), SetArgPointee<5>(attrs2),
+                Return(MetaStatusCode::OK)));
+
+    std::list<Dentry> out;
+    std::map<uint64_t, InodeAttr> attrs;
+    CURVEFS_ERROR ret = dCacheManager_->ListDentryPlus(parent, &out, &attrs,
+                                                       limit);
+    ASSERT_EQ(CURVEFS_ERROR::OK, ret);
+    ASSERT_EQ(limit + 1, out.size());
+    ASSERT_EQ(3, attrs.size());
+    ASSERT_EQ(3, attrs[3].inodeid());
+
+    EXPECT_CALL(*metaClient_, ListDentryPlus(fsId_, parent, _, _, _, _))
+        .WillOnce(Return(MetaStatusCode::UNKNOWN_ERROR));
+    ret = dCacheManager_->ListDentryPlus(parent, &out, &attrs, limit);
+    ASSERT_EQ(CURVEFS_ERROR::UNKNOWN, ret);
+}
+
+TEST_F(TestDentryCacheManager, DeferCreateDentry) {
+    DeferSyncOption option;
+    option.deferCreate = true;
+    option.deferCreateThreads = 2;
+    ASSERT_EQ(CURVEFS_ERROR::OK, dCacheManager_->Init(option));
+
+    uint64_t parent = 99;
+    Dentry dentry;
+    dentry.set_fsid(fsId_);
+    dentry.set_parentinodeid(parent);
+    dentry.set_name("file");
+    dentry.set_inodeid(100);
+
+    // hold the creating until the pending dentry is checked
+    std::promise<void> creating;
+    std::shared_future<void> wait = creating.get_future().share();
+    EXPECT_CALL(*metaClient_, CreateDentry(_))
+        .WillOnce(Invoke([&](const Dentry&) {
+            wait.wait();
+            return MetaStatusCode::OK;
+        }));
+    EXPECT_CALL(*metaClient_, GetDentry(_, _, _, _))
+        .Times(0);
+    ASSERT_EQ(CURVEFS_ERROR::OK, dCacheManager_->DeferCreateDentry(dentry));
+    ASSERT_EQ(CURVEFS_ERROR::EXISTS, dCacheManager_->DeferCreateDentry(dentry));
+
+    Dentry out;
+    ASSERT_EQ(CURVEFS_ERROR::OK, dCacheManager_->GetDentry(parent, "file",
+                                                           &out));
+    ASSERT_EQ(100, out.inodeid());
+
+    creating.set_value();
+    ASSERT_EQ(CURVEFS_ERROR::OK, dCacheManager_->WaitPendingInode(100));
+
+    // failed dentry removes its inode
+    dentry.set_name("file2");
+    dentry.set_inodeid(101);
+    EXPECT_CALL(*metaClient_, CreateDentry(_))
+        .WillOnce(Return(MetaStatusCode::UNKNOWN_ERROR));
+    EXPECT_CALL(*metaClient_, DeleteInode(fsId_, 101))
+        .WillOnce(Return(MetaStatusCode::OK));
+    ASSERT_EQ(CURVEFS_ERROR::OK, dCacheManager_->DeferCreateDentry(dentry));
+
+    // list waits for all pending dentries under the parent
+    EXPECT_CALL(*metaClient_, ListDentry(fsId_, parent, _, _, _, _))
+        .WillOnce(Return(MetaStatusCode::OK));
+    std::list<Dentry> dentrys;
+    ASSERT_EQ(CURVEFS_ERROR::OK, dCacheManager_->ListDentry(parent, &dentrys,
+                                                            100));
+    dCacheManager_->UnInit();
+}
+
+TEST_F(TestDentryCacheManager, DeferCreateDentryFailed) {
+    DeferSyncOption option;
+    option.deferCreate = true;
+    option.deferCreateThreads = 1;
+    ASSERT_EQ(CURVEFS_ERROR::OK, dCacheManager_->Init(option));
+
+    Dentry dentry;
+    dentry.set_fsid(fsId_);
+    dentry.set_parentinodeid(99);
+    dentry.set_name("file");
+    dentry.set_inodeid(100);
+
+    std::promise<void> creating;
+    std::shared_future<void> wait = creating.get_future().share();
+    EXPECT_CALL(*metaClient_, CreateDentry(_))
+        .WillOnce(Invoke([&](const Dentry&) {
+            wait.wait();
+            return MetaStatusCode::UNKNOWN_ERROR;
+        }));
+    EXPECT_CALL(*metaClient_, DeleteInode(fsId_, 100))
+        .WillOnce(Return(MetaStatusCode::OK));
+    ASSERT_EQ(CURVEFS_ERROR::OK, dCacheManager_->DeferCreateDentry(dentry));
+
+    // the waiter blocked before the failure gets the error
+    std::future<CURVEFS_ERROR> waiter = std::async(std::launch::async, [&]() {
+        return dCacheManager_->WaitPendingInode(100);
+    });
+    ASSERT_EQ(std::future_status::timeout,
+              waiter.wait_for(std::chrono::milliseconds(100)));
+    creating.set_value();
+    ASSERT_EQ(CURVEFS_ERROR::IO_ERROR, waiter.get());
+
+    // the failure has been reported
+    ASSERT_EQ(CURVEFS_ERROR::OK, dCacheManager_->WaitPendingInode(100));
+    ASSERT_EQ(CURVEFS_ERROR::OK, dCacheManager_->WaitPendingInode(101));
+
+    // fsync or release issued after the failure sees it once
+    dentry.set_name("file2");
+    dentry.set_inodeid(102);
+    EXPECT_CALL(*metaClient_, CreateDentry(_))
+        .WillOnce(Return(MetaStatusCode::UNKNOWN_ERROR));
+    EXPECT_CALL(*metaClient_, DeleteInode(fsId_, 102))
+        .WillOnce(Return(MetaStatusCode::OK));
+    ASSERT_EQ(CURVEFS_ERROR::OK, dCacheManager_->DeferCreateDentry(dentry));
+    dCacheManager_->WaitPendingDentry(99);
+    ASSERT_EQ(CURVEFS_ERROR::IO_ERROR, dCacheManager_->WaitPendingInode(102));
+    ASSERT_EQ(CURVEFS_ERROR::OK, dCacheManager_->WaitPendingInode(102));
+    dCacheManager_->UnInit();
+}
+
 TEST_F(TestDentryCacheManager, GetTimeOutDentry) {
     curvefs::client::common::FLAGS_enableCto = false;
     uint64_t parent = 99;
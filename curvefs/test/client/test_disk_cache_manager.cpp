@@ -207,6 +207,37 @@ TEST_F(TestDiskCacheManager, IsCached) {
     ASSERT_EQ(true, ret);
 }
 
+TEST_F(TestDiskCacheManager, AdmitReadCache) {
+    S3ClientAdaptorOption option;
+    option.objectPrefix = 0;
+    option.diskCacheOpt.cacheDir = "/mnt/test_unit";
+    option.diskCacheOpt.safeRatio = 99;
+    option.diskCacheOpt.maxUsableSpaceBytes = 100000000;
+    option.diskCacheOpt.maxFileNums = 1;
+    option.diskCacheOpt.admissionFilter = true;
+    EXPECT_CALL(*wrapper, stat(NotNull(), NotNull())).WillOnce(Return(-1));
+    EXPECT_CALL(*wrapper, mkdir(_, _)).WillOnce(Return(-1));
+    diskCacheManager_->Init(client_, option);
+
+    // disk cache is safe, admit all
+    ASSERT_TRUE(diskCacheManager_->AdmitReadCache("cold"));
+
+    std::string hot = "hot";
+    diskCacheManager_->AddCache(hot);
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(diskCacheManager_->IsCached(hot));
+    }
+    ASSERT_FALSE(diskCacheManager_->IsDiskCacheSafe());
+
+    // cold obj is accessed less than the victim
+    ASSERT_FALSE(diskCacheManager_->AdmitReadCache("cold"));
+
+    for (int i = 0; i < 5; i++) {
+        ASSERT_FALSE(diskCacheManager_->IsCached("cold"));
+    }
+    ASSERT_TRUE(diskCacheManager_->AdmitReadCache("cold"));
+}
+
 TEST_F(TestDiskCacheManager, SetDiskFsUsedRatio) {
     EXPECT_CALL(*wrapper, statfs(NotNull(), NotNull())).WillOnce(Return(-1));
     int ret = diskCacheManager_->SetDiskFsUsedRatio();
@@ -80,31 +80,23 @@ TEST_F(TestDiskCacheRead, ReadDiskFile) {
     ASSERT_EQ(-1, ret);
 
     EXPECT_CALL(*wrapper_, open(_, _, _)).WillOnce(Return(0));
-    EXPECT_CALL(*wrapper_, lseek(_, _, _)).WillOnce(Return(-1));
+    EXPECT_CALL(*wrapper_, pread(_, _, length, length)).WillOnce(Return(-1));
     EXPECT_CALL(*wrapper_, close(_)).WillOnce(Return(0));
     ret = diskCacheRead_->ReadDiskFile(
         fileName, const_cast<char *>(fileName.c_str()), length, length);
     ASSERT_EQ(-1, ret);
 
     EXPECT_CALL(*wrapper_, open(_, _, _)).WillOnce(Return(0));
-    EXPECT_CALL(*wrapper_, lseek(_, _, _)).WillOnce(Return(0));
-    EXPECT_CALL(*wrapper_, read(_, _, _)).WillOnce(Return(-1));
-    EXPECT_CALL(*wrapper_, close(_)).WillOnce(Return(0));
-    ret = diskCacheRead_->ReadDiskFile(
-        fileName, const_cast<char *>(fileName.c_str()), length, length);
-    ASSERT_EQ(-1, ret);
-
-    EXPECT_CALL(*wrapper_, open(_, _, _)).WillOnce(Return(0));
-    EXPECT_CALL(*wrapper_, lseek(_, _, _)).WillOnce(Return(0));
-    EXPECT_CALL(*wrapper_, read(_, _, _)).WillOnce(Return(length - 1));
+    EXPECT_CALL(*wrapper_, pread(_, _, length, length))
+        .WillOnce(Return(length - 1));
     EXPECT_CALL(*wrapper_, close(_)).WillOnce(Return(0));
     ret = diskCacheRead_->ReadDiskFile(
         fileName, const_cast<char *>(fileName.c_str()), length, length);
     ASSERT_EQ(length - 1, ret);
 
     EXPECT_CALL(*wrapper_, open(_, _, _)).WillOnce(Return(0));
-    EXPECT_CALL(*wrapper_, lseek(_, _, _)).WillOnce(Return(0));
-    EXPECT_CALL(*wrapper_, read(_, _, _)).WillOnce(Return(length));
+    EXPECT_CALL(*wrapper_, pread(_, _, length, length))
+        .WillOnce(Return(length));
     EXPECT_CALL(*wrapper_, close(_)).WillOnce(Return(0));
     ret = diskCacheRead_->ReadDiskFile(
         fileName, const_cast<char *>(fileName.c_str()), length, length);
@@ -26,6 +26,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <list>
 #include <memory>
 #include <unordered_map>
 
@@ -510,6 +511,69 @@ TEST_F(TestFuseS3Client, warmUp_fetchDataEnqueue_chunkempty) {
     ASSERT_FALSE(ret);
 }
 
+// empty file is skipped by the length from BatchGetInodeAttr
+TEST_F(TestFuseS3Client, warmUp_fetchDataEnqueue_skipEmptyFile) {
+    sleep(1);
+    fuse_ino_t parent = 1;
+    std::string name = "test";
+    fuse_ino_t inodeid = 2;
+
+    Dentry dentry;
+    dentry.set_fsid(fsId);
+    dentry.set_name(name);
+    dentry.set_parentinodeid(parent);
+    dentry.set_inodeid(inodeid);
+    dentry.set_type(FsFileType::TYPE_S3);
+
+    Inode inode;
+    inode.set_fsid(fsId);
+    inode.set_inodeid(inodeid);
+    inode.set_length(4096);
+    inode.set_type(FsFileType::TYPE_S3);
+    auto inodeWrapper = std::make_shared<InodeWrapper>(inode, metaClient_);
+
+    InodeAttr attr;
+    attr.set_fsid(fsId);
+    attr.set_inodeid(inodeid);
+    attr.set_length(0);
+    std::list<InodeAttr> attrs{attr};
+
+    EXPECT_CALL(*dentryManager_, GetDentry(_, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(dentry), Return(CURVEFS_ERROR::OK)));
+    EXPECT_CALL(*inodeManager_, BatchGetInodeAttr(_, _))
+        .WillOnce(DoAll(SetArgPointee<1>(attrs), Return(CURVEFS_ERROR::OK)));
+    // no GetInode for fetching the data of the empty file
+    EXPECT_CALL(*inodeManager_, GetInode(_, _))
+        .WillOnce(
+            DoAll(SetArgReferee<1>(inodeWrapper), Return(CURVEFS_ERROR::OK)))
+        .WillOnce(
+            DoAll(SetArgReferee<1>(inodeWrapper), Return(CURVEFS_ERROR::OK)));
+
+    size_t len = 20;
+    char *tmpbuf = new char[len];
+    memset(tmpbuf, '\n', len);
+    tmpbuf[0] = '/';
+    tmpbuf[1] = 't';
+    tmpbuf[2] = 'e';
+    tmpbuf[3] = '\n';
+    EXPECT_CALL(*s3ClientAdaptor_, Read(_, _, _, _))
+        .WillOnce(
+            DoAll(SetArrayArgument<3>(tmpbuf, tmpbuf + len), Return(len)));
+    auto old = client_->GetFsInfo()->fstype();
+    client_->GetFsInfo()->set_fstype(FSType::TYPE_S3);
+    client_->PutWarmFilelistTask(
+        inodeid,
+        curvefs::client::common::WarmupStorageType::kWarmupStorageTypeDisk);
+
+    warmup::WarmupProgress progress;
+    bool ret = client_->GetWarmupProgress(inodeid, &progress);
+    ASSERT_TRUE(ret);
+    client_->GetFsInfo()->set_fstype(old);
+    sleep(5);
+    ret = client_->GetWarmupProgress(inodeid, &progress);
+    ASSERT_FALSE(ret);
+}
+
 // single file (parent is root); FetchDentry
 TEST_F(TestFuseS3Client, warmUp_FetchDentry_TYPE_SYM_LINK) {
     sleep(1);
@@ -25,6 +25,7 @@
 #include <gmock/gmock.h>
 #include <chrono>
 #include <cstdint>
+#include <list>
 #include <thread>
 
 #include "curvefs/src/client/inode_wrapper.h"
@@ -169,6 +170,72 @@ TEST_F(TestInodeCacheManager, GetInode) {
     */
 }
 
+TEST_F(TestInodeCacheManager, InodeLease) {
+    RefreshDataOption option;
+    option.inodeLeaseMs = 60 * 1000;
+    auto deferSync = std::make_shared<DeferSync>(DeferSyncOption());
+    auto openFiles =
+        std::make_shared<OpenFiles>(OpenFilesOption(), deferSync);
+    auto manager = std::make_shared<InodeCacheManagerImpl>(metaClient_);
+    manager->SetFsId(fsId_);
+    manager->Init(option, openFiles, deferSync);
+
+    uint64_t inodeId = 100;
+    Inode inode;
+    inode.set_inodeid(inodeId);
+    inode.set_fsid(fsId_);
+    inode.set_length(100);
+    inode.set_mtime(1);
+    inode.set_mtime_ns(1);
+    inode.set_ctime(1);
+    inode.set_ctime_ns(1);
+    inode.set_type(FsFileType::TYPE_S3);
+
+    EXPECT_CALL(*metaClient_, GetInode(fsId_, inodeId, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(inode), SetArgPointee<3>(false),
+                        Return(MetaStatusCode::OK)));
+    std::shared_ptr<InodeWrapper> first;
+    std::shared_ptr<InodeWrapper> second;
+    ASSERT_EQ(CURVEFS_ERROR::OK, manager->GetInode(inodeId, first));
+
+    // within the lease, no rpc at all
+    ASSERT_EQ(CURVEFS_ERROR::OK, manager->GetInode(inodeId, second));
+    ASSERT_EQ(first, second);
+
+    // with cto, revalidate by the attribute
+    curvefs::client::common::FLAGS_enableCto = true;
+    InodeAttr attr;
+    first->GetInodeAttr(&attr);
+    std::list<InodeAttr> attrs{attr};
+    EXPECT_CALL(*metaClient_, BatchGetInodeAttr(fsId_, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(attrs), Return(MetaStatusCode::OK)));
+    ASSERT_EQ(CURVEFS_ERROR::OK, manager->GetInode(inodeId, second));
+    ASSERT_EQ(first, second);
+
+    // modified by others
+    inode.set_length(200);
+    inode.set_mtime(2);
+    attrs.front().set_length(200);
+    attrs.front().set_mtime(2);
+    EXPECT_CALL(*metaClient_, BatchGetInodeAttr(fsId_, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(attrs), Return(MetaStatusCode::OK)));
+    EXPECT_CALL(*metaClient_, GetInode(fsId_, inodeId, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(inode), SetArgPointee<3>(false),
+                        Return(MetaStatusCode::OK)));
+    ASSERT_EQ(CURVEFS_ERROR::OK, manager->GetInode(inodeId, second));
+    ASSERT_NE(first, second);
+    ASSERT_EQ(200, second->GetLength());
+    curvefs::client::common::FLAGS_enableCto = false;
+
+    // lease is dropped after the inode is deleted
+    EXPECT_CALL(*metaClient_, DeleteInode(fsId_, inodeId))
+        .WillOnce(Return(MetaStatusCode::OK));
+    ASSERT_EQ(CURVEFS_ERROR::OK, manager->DeleteInode(inodeId));
+    EXPECT_CALL(*metaClient_, GetInode(fsId_, inodeId, _, _))
+        .WillOnce(Return(MetaStatusCode::NOT_FOUND));
+    ASSERT_EQ(CURVEFS_ERROR::NOTEXIST, manager->GetInode(inodeId, second));
+}
+
 TEST_F(TestInodeCacheManager, GetInodeAttr) {
     uint64_t inodeId = 100;
     uint64_t parentId = 99;
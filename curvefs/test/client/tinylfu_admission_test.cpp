@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-29
+ * Author: curve
+ */
+
+#include "curvefs/src/client/s3/tinylfu_admission.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace curvefs {
+namespace client {
+
+TEST(TinyLfuAdmissionTest, Estimate) {
+    TinyLfuAdmission admission(1024);
+    ASSERT_EQ(0, admission.Estimate("a"));
+
+    for (int i = 0; i < 3; i++) {
+        admission.Record("a");
+    }
+    ASSERT_EQ(3, admission.Estimate("a"));
+    ASSERT_EQ(0, admission.Estimate("b"));
+
+    // counters saturate
+    for (int i = 0; i < 100; i++) {
+        admission.Record("a");
+    }
+    ASSERT_EQ(15, admission.Estimate("a"));
+}
+
+TEST(TinyLfuAdmissionTest, Admit) {
+    TinyLfuAdmission admission(65536);
+    for (int i = 0; i < 5; i++) {
+        admission.Record("hot");
+    }
+
+    // a scan doesn't evict the hot obj
+    for (int i = 0; i < 1000; i++) {
+        std::string key = "scan_" + std::to_string(i);
+        admission.Record(key);
+        ASSERT_FALSE(admission.Admit(key, "hot"));
+    }
+
+    admission.Record("warm");
+    admission.Record("warm");
+    ASSERT_TRUE(admission.Admit("warm", "scan_0"));
+    ASSERT_FALSE(admission.Admit("scan_0", "warm"));
+}
+
+TEST(TinyLfuAdmissionTest, Aging) {
+    TinyLfuAdmission admission(1024);
+    for (int i = 0; i < 15; i++) {
+        admission.Record("old");
+    }
+    ASSERT_EQ(15, admission.Estimate("old"));
+
+    // counters are halved after 10 * width records
+    for (int i = 0; i < 10 * 1024; i++) {
+        admission.Record("new_" + std::to_string(i));
+    }
+    ASSERT_LE(admission.Estimate("old"), 7);
+}
+
+}  // namespace client
+}  // namespace curvefs
@@ -25,6 +25,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "curvefs/src/metaserver/storage/storage.h"
 #include "curvefs/src/metaserver/storage/rocksdb_storage.h"
 #include "curvefs/test/metaserver/storage/utils.h"
@@ -533,5 +538,48 @@ TEST_F(DentryStorageTest, HandleTx) {
     ASSERT_EQ(dentry.inodeid(), 1);
 }
 
+TEST_F(DentryStorageTest, ConcurrentMutation) {
+    DentryStorage storage(kvStorage_, nameGenerator_, 0);
+
+    // all threads create and delete dentrys in the same directory
+    const int nThreads = 8;
+    const int nDentrys = 500;
+    std::atomic<bool> running(true);
+    std::thread reader([&]() {
+        while (running.load()) {
+            std::vector<Dentry> dentrys;
+            auto dentry = GenDentry(1, 0, "", 0, 0, false);
+            ASSERT_EQ(storage.List(dentry, &dentrys, 0), MetaStatusCode::OK);
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int i = 0; i < nThreads; i++) {
+        writers.emplace_back([&, i]() {
+            for (int j = 0; j < nDentrys; j++) {
+                auto name = std::to_string(i) + "_" + std::to_string(j);
+                auto dentry = GenDentry(1, 0, name, 0, i * nDentrys + j + 1,
+                                        false);
+                ASSERT_EQ(storage.Insert(dentry), MetaStatusCode::OK);
+                if (j % 2 == 1) {
+                    ASSERT_EQ(storage.Delete(dentry), MetaStatusCode::OK);
+                }
+            }
+        });
+    }
+
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    running.store(false);
+    reader.join();
+
+    ASSERT_EQ(storage.Size(), nThreads * nDentrys / 2);
+    std::vector<Dentry> dentrys;
+    auto dentry = GenDentry(1, 0, "", 0, 0, false);
+    ASSERT_EQ(storage.List(dentry, &dentrys, 0), MetaStatusCode::OK);
+    ASSERT_EQ(dentrys.size(), nThreads * nDentrys / 2);
+}
+
 }  // namespace metaserver
 }  // namespace curvefs
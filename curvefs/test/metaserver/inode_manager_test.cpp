@@ -28,6 +28,7 @@
 
 #include "curvefs/test/metaserver/test_helper.h"
 #include "curvefs/src/metaserver/inode_manager.h"
+#include "curvefs/src/metaserver/s3chunkinfo_codec.h"
 #include "curvefs/src/common/define.h"
 #include "curvefs/src/metaserver/storage/storage.h"
 #include "curvefs/src/metaserver/storage/converter.h"
@@ -172,7 +173,9 @@ class InodeManagerTest : public ::testing::Test {
         ASSERT_EQ(iterator->Status(), 0);
         for (iterator->SeekToFirst(); iterator->Valid(); iterator->Next()) {
             ASSERT_TRUE(conv_->ParseFromString(iterator->Key(), &key));
-            ASSERT_TRUE(conv_->ParseFromString(iterator->Value(), &list4get));
+            list4get.Clear();
+            ASSERT_TRUE(S3ChunkInfoListCodec::ParseFromString(
+                iterator->Value(), &list4get));
             ASSERT_EQ(key.chunkIndex, chunkIndexs[size]);
             ASSERT_TRUE(EqualS3ChunkInfoList(list4get, lists[size]));
             size++;
@@ -430,6 +433,92 @@ TEST_F(InodeManagerTest, UpdateInode) {
 }
 
 
+TEST_F(InodeManagerTest, S3FragmentIndex) {
+    uint32_t fsId = 1;
+    uint64_t ino = 2;
+    param_.type = FsFileType::TYPE_S3;
+    Inode inode;
+    ASSERT_EQ(MetaStatusCode::OK, manager->CreateInode(ino, param_, &inode));
+
+    auto* index = manager->GetS3FragmentIndex();
+    ASSERT_EQ(0, index->GetScore(ino));
+
+    // appended chunk infos are counted
+    S3ChunkInfoMap map2add;
+    S3ChunkInfoMap map2del;
+    std::shared_ptr<Iterator> iterator;
+    map2add[0] = GenS3ChunkInfoList(1, 10);
+    map2add[1] = GenS3ChunkInfoList(11, 15);
+    ASSERT_EQ(MetaStatusCode::OK,
+              manager->GetOrModifyS3ChunkInfo(fsId, ino, map2add, map2del,
+                                              false, &iterator));
+    ASSERT_EQ(15, index->GetScore(ino));
+
+    // compaction replaces chunk infos with a merged one
+    map2add.clear();
+    map2add[0] = GenS3ChunkInfoList(10, 10);
+    map2del[0] = GenS3ChunkInfoList(1, 10);
+    ASSERT_EQ(MetaStatusCode::OK,
+              manager->GetOrModifyS3ChunkInfo(fsId, ino, map2add, map2del,
+                                              false, &iterator));
+    ASSERT_EQ(6, index->GetScore(ino));
+
+    // taken inodes are removed from the index
+    std::vector<uint64_t> inodes;
+    index->Take(7, 10, &inodes);
+    ASSERT_TRUE(inodes.empty());
+    index->Take(6, 10, &inodes);
+    ASSERT_EQ(std::vector<uint64_t>{ino}, inodes);
+    ASSERT_EQ(0, index->GetScore(ino));
+
+    // truncate
+    UpdateInodeRequest request = MakeUpdateInodeRequestFromInode(inode);
+    request.set_length(inode.length() - 1);
+    ASSERT_EQ(MetaStatusCode::OK, manager->UpdateInode(request));
+    ASSERT_EQ(S3FragmentIndex::kTruncatedScore, index->GetScore(ino));
+
+    // delete
+    ASSERT_EQ(MetaStatusCode::OK, manager->DeleteInode(fsId, ino));
+    ASSERT_EQ(0, index->GetScore(ino));
+}
+
+TEST_F(InodeManagerTest, RebuildS3FragmentIndex) {
+    uint32_t fsId = 1;
+    param_.type = FsFileType::TYPE_S3;
+    Inode inode;
+    ASSERT_EQ(MetaStatusCode::OK, manager->CreateInode(2, param_, &inode));
+    ASSERT_EQ(MetaStatusCode::OK, manager->CreateInode(3, param_, &inode));
+
+    S3ChunkInfoMap map2add;
+    S3ChunkInfoMap map2del;
+    std::shared_ptr<Iterator> iterator;
+    map2add[0] = GenS3ChunkInfoList(1, 10);
+    map2add[1] = GenS3ChunkInfoList(11, 15);
+    ASSERT_EQ(MetaStatusCode::OK,
+              manager->GetOrModifyS3ChunkInfo(fsId, 2, map2add, map2del,
+                                              false, &iterator));
+    map2add.clear();
+    map2add[0] = GenS3ChunkInfoList(16, 18);
+    ASSERT_EQ(MetaStatusCode::OK,
+              manager->GetOrModifyS3ChunkInfo(fsId, 3, map2add, map2del,
+                                              false, &iterator));
+
+    // recovered from checkpoint: chunk infos are in the storage, but the
+    // in-memory index of the new manager is empty
+    auto inodeStorage = std::make_shared<InodeStorage>(
+        kvStorage_, std::make_shared<NameGenerator>(1), 0);
+    FileType2InodeNumMap filetype2InodeNum;
+    InodeManager recovered(inodeStorage, nullptr, &filetype2InodeNum);
+    auto* index = recovered.GetS3FragmentIndex();
+    ASSERT_EQ(0, index->Size());
+
+    ASSERT_EQ(MetaStatusCode::OK, recovered.RebuildS3FragmentIndex());
+    ASSERT_EQ(2, index->Size());
+    ASSERT_EQ(15, index->GetScore(2));
+    ASSERT_EQ(3, index->GetScore(3));
+}
+
+
 TEST_F(InodeManagerTest, testGetAttr) {
     // CREATE
     uint32_t fsId = 1;
@@ -32,6 +32,7 @@
 #include <string>
 #include "curvefs/proto/metaserver.pb.h"
 #include "curvefs/src/metaserver/inode_storage.h"
+#include "curvefs/src/metaserver/s3chunkinfo_codec.h"
 #include "curvefs/src/common/define.h"
 
 #include "curvefs/src/metaserver/storage/config.h"
@@ -177,7 +178,9 @@ class InodeStorageTest : public ::testing::Test {
         for (iterator->SeekToFirst(); iterator->Valid(); iterator->Next()) {
             ASSERT_TRUE(conv_->ParseFromString(iterator->Key(), &key));
             LOG(INFO) << "key" << size << "=" << iterator->Key();
-            ASSERT_TRUE(iterator->ParseFromValue(&list4get));
+            list4get.Clear();
+            ASSERT_TRUE(S3ChunkInfoListCodec::ParseFromString(
+                iterator->Value(), &list4get));
             ASSERT_EQ(key.chunkIndex, chunkIndexs[size]);
             ASSERT_TRUE(EqualS3ChunkInfoList(list4get, lists[size]));
             size++;
@@ -720,7 +723,9 @@ TEST_F(InodeStorageTest, GetAllS3ChunkInfoList) {
     auto iterator = storage.GetAllS3ChunkInfoList();
     for (iterator->SeekToFirst(); iterator->Valid(); iterator->Next()) {
         ASSERT_TRUE(conv_->ParseFromString(iterator->Key(), &key));
-        ASSERT_TRUE(iterator->ParseFromValue(&list4get));
+        list4get.Clear();
+        ASSERT_TRUE(S3ChunkInfoListCodec::ParseFromString(
+            iterator->Value(), &list4get));
         ASSERT_EQ(key.chunkIndex, chunkIndex);
         ASSERT_EQ(key.fsId, fsIds[size]);
         ASSERT_EQ(key.inodeId, inodeIds[size]);
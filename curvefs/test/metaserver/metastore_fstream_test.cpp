@@ -0,0 +1,193 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-20
+ * Author: curve
+ */
+
+#include "curvefs/src/metaserver/metastore_fstream.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "curvefs/src/metaserver/storage/converter.h"
+#include "curvefs/src/metaserver/storage/rocksdb_storage.h"
+#include "curvefs/src/metaserver/storage/storage_fstream.h"
+#include "curvefs/test/metaserver/storage/utils.h"
+#include "src/fs/ext4_filesystem_impl.h"
+
+namespace curvefs {
+namespace metaserver {
+
+using ::curvefs::metaserver::storage::ContainerIterator;
+using ::curvefs::metaserver::storage::DUMPFILE_ERROR;
+using ::curvefs::metaserver::storage::DumpFile;
+using ::curvefs::metaserver::storage::IteratorWrapper;
+using ::curvefs::metaserver::storage::RandomStoragePath;
+using ::curvefs::metaserver::storage::RocksDBStorage;
+using ::curvefs::metaserver::storage::StorageOptions;
+
+namespace {
+
+auto localfs = curve::fs::Ext4FileSystemImpl::getInstance();
+
+using ContainerType = std::unordered_map<std::string, std::string>;
+
+constexpr uint32_t kPartitionNum = 8;
+constexpr uint32_t kInodePerPartition = 3000;
+constexpr uint64_t kInodePerPartitionRange = 10000;
+
+Inode MakeInode(uint32_t fsId, uint64_t inodeId) {
+    Inode inode;
+    inode.set_fsid(fsId);
+    inode.set_inodeid(inodeId);
+    inode.set_length(0);
+    inode.set_ctime(0);
+    inode.set_ctime_ns(0);
+    inode.set_mtime(0);
+    inode.set_mtime_ns(0);
+    inode.set_atime(0);
+    inode.set_atime_ns(0);
+    inode.set_uid(0);
+    inode.set_gid(0);
+    inode.set_mode(0);
+    inode.set_nlink(1);
+    inode.set_type(FsFileType::TYPE_FILE);
+    return inode;
+}
+
+}  // namespace
+
+class MetaStoreFStreamTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        dataDir_ = RandomStoragePath();
+        StorageOptions options;
+        options.dataDir = dataDir_;
+        options.localFileSystem = localfs.get();
+        kvStorage_ = std::make_shared<RocksDBStorage>(options);
+        ASSERT_TRUE(kvStorage_->Open());
+        ASSERT_EQ(0, localfs->Mkdir(dataDir_ + "_dump"));
+        dumpfile_ = dataDir_ + "_dump/metadata";
+    }
+
+    void TearDown() override {
+        ASSERT_TRUE(kvStorage_->Close());
+        ASSERT_EQ(0, localfs->Delete(dataDir_));
+        ASSERT_EQ(0, localfs->Delete(dataDir_ + "_dump"));
+    }
+
+    // dump partitions and their inodes, inodes of different partitions
+    // are interleaved in the dumpfile, only legacy dump files contain
+    // entries other than partitions and pending tx
+    void PrepareDumpFile(uint8_t version = storage::kDumpFileV2) {
+        Converter conv;
+        std::string value;
+        auto partitions = std::make_shared<ContainerType>();
+        for (uint32_t pid = 1; pid <= kPartitionNum; pid++) {
+            PartitionInfo info;
+            info.set_fsid(1);
+            info.set_poolid(1);
+            info.set_copysetid(1);
+            info.set_partitionid(pid);
+            info.set_start(pid * kInodePerPartitionRange);
+            info.set_end((pid + 1) * kInodePerPartitionRange - 1);
+            ASSERT_TRUE(conv.SerializeToString(info, &value));
+            partitions->emplace(std::to_string(pid), value);
+        }
+
+        MergeIterator::ChildrenType children;
+        children.push_back(std::make_shared<IteratorWrapper>(
+            ENTRY_TYPE::PARTITION, 0,
+            std::make_shared<ContainerIterator<ContainerType>>(partitions)));
+
+        for (uint32_t pid = 1; pid <= kPartitionNum; pid++) {
+            auto inodes = std::make_shared<ContainerType>();
+            for (uint32_t i = 0; i < kInodePerPartition; i++) {
+                uint64_t inodeId = pid * kInodePerPartitionRange + i;
+                ASSERT_TRUE(
+                    conv.SerializeToString(MakeInode(1, inodeId), &value));
+                inodes->emplace(std::to_string(inodeId), value);
+            }
+            children.push_back(std::make_shared<IteratorWrapper>(
+                ENTRY_TYPE::INODE, pid,
+                std::make_shared<ContainerIterator<ContainerType>>(inodes)));
+        }
+
+        auto iterator = std::make_shared<MergeIterator>(children);
+        DumpFile dumpfile(dumpfile_, version);
+        ASSERT_EQ(DUMPFILE_ERROR::OK, dumpfile.Open());
+        ASSERT_EQ(DUMPFILE_ERROR::OK, dumpfile.Save(iterator));
+        ASSERT_EQ(DUMPFILE_ERROR::OK, dumpfile.Close());
+    }
+
+    void CheckLoad(uint32_t loadConcurrency) {
+        PartitionMap partitionMap;
+        MetaStoreFStream fstream(&partitionMap, kvStorage_, 1, 1,
+                                 loadConcurrency);
+        uint8_t version = 0;
+        ASSERT_TRUE(fstream.Load(dumpfile_, &version));
+        ASSERT_EQ(kPartitionNum, partitionMap.size());
+        for (const auto& item : partitionMap) {
+            ASSERT_EQ(kInodePerPartition, item.second->GetInodeNum());
+        }
+
+        for (const auto& item : partitionMap) {
+            ASSERT_TRUE(item.second->Clear());
+        }
+    }
+
+ protected:
+    std::string dataDir_;
+    std::string dumpfile_;
+    std::shared_ptr<KVStorage> kvStorage_;
+};
+
+TEST_F(MetaStoreFStreamTest, LoadSerially) {
+    PrepareDumpFile();
+    CheckLoad(1);
+}
+
+TEST_F(MetaStoreFStreamTest, LoadConcurrently) {
+    PrepareDumpFile();
+    CheckLoad(4);
+}
+
+TEST_F(MetaStoreFStreamTest, LoadV3Serially) {
+    // workers are not started for V3 dump files
+    PrepareDumpFile(storage::kDumpFileV3);
+    CheckLoad(4);
+}
+
+TEST_F(MetaStoreFStreamTest, LoadConcurrentlyFailed) {
+    PrepareDumpFile();
+
+    // the same inode can't be inserted twice, the second load must fail
+    PartitionMap partitionMap;
+    MetaStoreFStream fstream(&partitionMap, kvStorage_, 1, 1, 4);
+    uint8_t version = 0;
+    ASSERT_TRUE(fstream.Load(dumpfile_, &version));
+    partitionMap.clear();
+    ASSERT_FALSE(fstream.Load(dumpfile_, &version));
+}
+
+}  // namespace metaserver
+}  // namespace curvefs
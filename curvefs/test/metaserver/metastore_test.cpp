@@ -26,6 +26,7 @@
 #include <braft/storage.h>
 #include <condition_variable>  // NOLINT
 #include "curvefs/proto/metaserver.pb.h"
+#include "curvefs/src/metaserver/s3chunkinfo_codec.h"
 #include "curvefs/src/common/process.h"
 #include "curvefs/src/common/define.h"
 #include "curvefs/src/common/rpc_stream.h"
@@ -227,7 +228,9 @@ class MetastoreTest : public ::testing::Test {
         ASSERT_EQ(iterator->Status(), 0);
         for (iterator->SeekToFirst(); iterator->Valid(); iterator->Next()) {
             ASSERT_TRUE(conv_->ParseFromString(iterator->Key(), &key));
-            ASSERT_TRUE(conv_->ParseFromString(iterator->Value(), &list4get));
+            list4get.Clear();
+            ASSERT_TRUE(S3ChunkInfoListCodec::ParseFromString(
+                iterator->Value(), &list4get));
             ASSERT_EQ(key.chunkIndex, chunkIndexs[size]);
             ASSERT_TRUE(EqualS3ChunkInfoList(list4get, lists[size]));
             size++;
@@ -852,6 +855,29 @@ TEST_F(MetastoreTest, test_dentry) {
 
     ret = metastore.DeleteDentry(&deleteRequest, &deleteResponse);
     ASSERT_EQ(deleteResponse.statuscode(), MetaStatusCode::NOT_FOUND);
+
+    // ListDentry with attributes, only existing inodes are returned
+    createInodeRequest.set_type(FsFileType::TYPE_FILE);
+    ret = metastore.CreateInode(&createInodeRequest, &createInodeResponse);
+    ASSERT_EQ(createInodeResponse.statuscode(), MetaStatusCode::OK);
+    uint64_t fileId = createInodeResponse.inode().inodeid();
+
+    Dentry dentry4 = dentry3;
+    dentry4.set_inodeid(fileId);
+    dentry4.set_name("dentry4");
+    dentry4.set_type(FsFileType::TYPE_FILE);
+    createRequest.mutable_dentry()->CopyFrom(dentry4);
+    ret = metastore.CreateDentry(&createRequest, &createResponse);
+    ASSERT_EQ(createResponse.statuscode(), MetaStatusCode::OK);
+
+    listRequest.set_returnattr(true);
+    listResponse.Clear();
+    ret = metastore.ListDentry(&listRequest, &listResponse);
+    ASSERT_EQ(listResponse.statuscode(), MetaStatusCode::OK);
+    ASSERT_EQ(listResponse.dentrys_size(), 3);
+    ASSERT_EQ(listResponse.attr_size(), 1);
+    ASSERT_EQ(listResponse.attr(0).inodeid(), fileId);
+    ASSERT_EQ(listResponse.attr(0).type(), FsFileType::TYPE_FILE);
 }
 
 TEST_F(MetastoreTest, persist_success) {
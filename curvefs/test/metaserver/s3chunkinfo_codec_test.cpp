@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-22
+ * Author: curve
+ */
+
+#include "curvefs/src/metaserver/s3chunkinfo_codec.h"
+
+#include <google/protobuf/util/message_differencer.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace curvefs {
+namespace metaserver {
+
+using ::google::protobuf::util::MessageDifferencer;
+
+namespace {
+
+void AddChunk(S3ChunkInfoList* list, uint64_t chunkId, uint64_t compaction,
+              uint64_t offset, uint64_t len, uint64_t size, bool zero) {
+    auto* info = list->add_s3chunks();
+    info->set_chunkid(chunkId);
+    info->set_compaction(compaction);
+    info->set_offset(offset);
+    info->set_len(len);
+    info->set_size(size);
+    info->set_zero(zero);
+}
+
+S3ChunkInfoList GenAppendList(uint64_t firstChunkId, int count) {
+    S3ChunkInfoList list;
+    for (int i = 0; i < count; i++) {
+        AddChunk(&list, firstChunkId + i, 0, 4096ULL * i, 4096, 4096, false);
+    }
+    return list;
+}
+
+}  // namespace
+
+TEST(S3ChunkInfoListCodecTest, EncodeAndDecode) {
+    S3ChunkInfoList list;
+    AddChunk(&list, 100, 0, 0, 4096, 4096, false);
+    // chunk id and offset go backwards
+    AddChunk(&list, 90, 2, 8192, 100, 100, false);
+    AddChunk(&list, 91, 0, 0, 1, 1, true);
+    AddChunk(&list, UINT64_MAX, 0, UINT64_MAX - 1, 10, 10, false);
+    AddChunk(&list, 0, 0, 0, 0, 0, false);
+
+    PackedS3ChunkInfoList packed;
+    S3ChunkInfoListCodec::Encode(list, &packed);
+    ASSERT_EQ(5, packed.count());
+
+    S3ChunkInfoList out;
+    ASSERT_TRUE(S3ChunkInfoListCodec::Decode(packed, &out));
+    ASSERT_TRUE(MessageDifferencer::Equals(list, out));
+}
+
+TEST(S3ChunkInfoListCodecTest, DefaultColumnsAreOmitted) {
+    auto list = GenAppendList(1000, 100);
+
+    PackedS3ChunkInfoList packed;
+    S3ChunkInfoListCodec::Encode(list, &packed);
+    ASSERT_EQ(0, packed.compaction_size());
+    ASSERT_EQ(0, packed.zero_size());
+
+    std::string compact;
+    std::string plain;
+    ASSERT_TRUE(packed.SerializeToString(&compact));
+    ASSERT_TRUE(list.SerializeToString(&plain));
+    ASSERT_LT(compact.size() * 2, plain.size());
+
+    S3ChunkInfoList out;
+    ASSERT_TRUE(S3ChunkInfoListCodec::ParseFromString(compact, &out));
+    ASSERT_TRUE(MessageDifferencer::Equals(list, out));
+}
+
+TEST(S3ChunkInfoListCodecTest, EmptyList) {
+    S3ChunkInfoList list;
+    PackedS3ChunkInfoList packed;
+    S3ChunkInfoListCodec::Encode(list, &packed);
+
+    std::string value;
+    ASSERT_TRUE(packed.SerializeToString(&value));
+
+    S3ChunkInfoList out;
+    ASSERT_TRUE(S3ChunkInfoListCodec::ParseFromString(value, &out));
+    ASSERT_EQ(0, out.s3chunks_size());
+}
+
+TEST(S3ChunkInfoListCodecTest, ParseOldFormat) {
+    auto list = GenAppendList(1, 10);
+    std::string value;
+    ASSERT_TRUE(list.SerializeToString(&value));
+
+    S3ChunkInfoList out;
+    ASSERT_TRUE(S3ChunkInfoListCodec::ParseFromString(value, &out));
+    ASSERT_TRUE(MessageDifferencer::Equals(list, out));
+
+    // empty list in old format
+    out.Clear();
+    ASSERT_TRUE(S3ChunkInfoListCodec::ParseFromString("", &out));
+    ASSERT_EQ(0, out.s3chunks_size());
+}
+
+TEST(S3ChunkInfoListCodecTest, ParseAppends) {
+    auto first = GenAppendList(1, 3);
+    auto second = GenAppendList(10, 2);
+
+    PackedS3ChunkInfoList packed;
+    std::string value1;
+    std::string value2;
+    S3ChunkInfoListCodec::Encode(first, &packed);
+    ASSERT_TRUE(packed.SerializeToString(&value1));
+    ASSERT_TRUE(second.SerializeToString(&value2));
+
+    S3ChunkInfoList out;
+    ASSERT_TRUE(S3ChunkInfoListCodec::ParseFromString(value1, &out));
+    ASSERT_TRUE(S3ChunkInfoListCodec::ParseFromString(value2, &out));
+
+    auto expect = first;
+    expect.MergeFrom(second);
+    ASSERT_TRUE(MessageDifferencer::Equals(expect, out));
+}
+
+TEST(S3ChunkInfoListCodecTest, DecodeCorrupted) {
+    auto list = GenAppendList(1, 3);
+    PackedS3ChunkInfoList packed;
+    S3ChunkInfoListCodec::Encode(list, &packed);
+    packed.set_count(4);
+
+    S3ChunkInfoList out;
+    ASSERT_FALSE(S3ChunkInfoListCodec::Decode(packed, &out));
+
+    std::string value;
+    ASSERT_TRUE(packed.SerializeToString(&value));
+    ASSERT_FALSE(S3ChunkInfoListCodec::ParseFromString(value, &out));
+}
+
+}  // namespace metaserver
+}  // namespace curvefs
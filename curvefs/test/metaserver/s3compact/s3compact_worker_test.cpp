@@ -76,23 +76,6 @@ TEST_F(S3CompactWorkerTest, TestRunAndStop) {
     ASSERT_NO_FATAL_FAILURE(worker.Stop());
 }
 
-namespace {
-
-std::shared_ptr<std::map<std::string, std::string>> PrepareInodeList() {
-    const uint32_t fsId = 1;
-    const uint64_t inodes = 10ULL * 10000;
-    std::map<std::string, std::string> kvs;
-
-    for (uint64_t i = 0; i < inodes; ++i) {
-        storage::Key4Inode key(fsId, i);
-        kvs.emplace(key.SerializeToString(), "dummy");
-    }
-
-    return std::make_shared<std::map<std::string, std::string>>(std::move(kvs));
-}
-
-}  // namespace
-
 TEST_F(S3CompactWorkerTest, TestCancelCompact) {
     auto mockKvStorage = std::make_shared<storage::MockKVStorage>();
     auto nameGen = std::make_shared<NameGenerator>(1);
@@ -102,7 +85,12 @@ TEST_F(S3CompactWorkerTest, TestCancelCompact) {
     auto inodeManager = std::make_shared<InodeManager>(inodeStorage, nullptr,
                                                        &filetype2InodeNum);
     auto copysetNode = std::make_shared<copyset::MockCopysetNode>();
-    auto kvs = PrepareInodeList();
+
+    // mark all inodes as fragmented
+    const uint64_t inodes = 10ULL * 10000;
+    for (uint64_t i = 0; i < inodes; ++i) {
+        inodeManager->GetS3FragmentIndex()->Update(i, 100, 0);
+    }
 
     unsigned int seed = time(nullptr);
 
@@ -110,13 +98,6 @@ TEST_F(S3CompactWorkerTest, TestCancelCompact) {
                            &workerOptions_);
     ASSERT_NO_FATAL_FAILURE(worker.Run());
 
-    EXPECT_CALL(*mockKvStorage, HGetAll(_))
-        .WillRepeatedly(Invoke([&kvs](const std::string& /*name*/) {
-            return std::make_shared<
-                storage::ContainerIterator<std::map<std::string, std::string>>>(
-                kvs);
-        }));
-
     EXPECT_CALL(*mockKvStorage, HGet(_, _, _))
         .WillRepeatedly(Return(storage::Status::NotFound()));
 
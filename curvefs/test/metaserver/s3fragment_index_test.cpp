@@ -0,0 +1,139 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-24
+ * Author: curve
+ */
+
+#include "curvefs/src/metaserver/s3fragment_index.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace curvefs {
+namespace metaserver {
+
+TEST(S3FragmentIndexTest, Update) {
+    S3FragmentIndex index;
+    index.Update(1, 0, 0);
+    ASSERT_EQ(0, index.Size());
+
+    // removing from an absent inode does nothing
+    index.Update(1, 1, 10);
+    ASSERT_EQ(0, index.Size());
+
+    index.Update(1, 10, 0);
+    index.Update(1, 5, 0);
+    ASSERT_EQ(15, index.GetScore(1));
+
+    index.Update(1, 1, 10);
+    ASSERT_EQ(6, index.GetScore(1));
+
+    // score reaches zero
+    index.Update(1, 0, 100);
+    ASSERT_EQ(0, index.GetScore(1));
+    ASSERT_EQ(0, index.Size());
+}
+
+TEST(S3FragmentIndexTest, Truncated) {
+    S3FragmentIndex index;
+    index.MarkTruncated(1);
+    ASSERT_EQ(S3FragmentIndex::kTruncatedScore, index.GetScore(1));
+
+    // truncated inode stays at the top until it's taken
+    index.Update(1, 10, 100);
+    ASSERT_EQ(S3FragmentIndex::kTruncatedScore, index.GetScore(1));
+
+    index.Update(2, UINT64_MAX, 0);
+    index.Update(2, UINT64_MAX, 0);
+    ASSERT_EQ(S3FragmentIndex::kTruncatedScore - 1, index.GetScore(2));
+
+    std::vector<uint64_t> inodes;
+    index.Take(0, 10, &inodes);
+    ASSERT_EQ((std::vector<uint64_t>{1, 2}), inodes);
+    ASSERT_EQ(0, index.Size());
+}
+
+TEST(S3FragmentIndexTest, Take) {
+    S3FragmentIndex index;
+    for (uint64_t ino = 1; ino <= 100; ino++) {
+        index.Update(ino, ino, 0);
+    }
+
+    std::vector<uint64_t> inodes;
+    index.Take(1, 0, &inodes);
+    ASSERT_TRUE(inodes.empty());
+    ASSERT_EQ(100, index.Size());
+
+    index.Take(200, 10, &inodes);
+    ASSERT_TRUE(inodes.empty());
+
+    index.Take(50, 3, &inodes);
+    ASSERT_EQ((std::vector<uint64_t>{100, 99, 98}), inodes);
+    ASSERT_EQ(97, index.Size());
+
+    // only inodes reach |minScore| are taken
+    index.Take(90, 100, &inodes);
+    ASSERT_EQ(8, inodes.size());
+    for (size_t i = 0; i < inodes.size(); i++) {
+        ASSERT_EQ(97 - i, inodes[i]);
+    }
+    ASSERT_EQ(89, index.Size());
+
+    index.Erase(1);
+    ASSERT_EQ(0, index.GetScore(1));
+    ASSERT_EQ(88, index.Size());
+}
+
+TEST(S3FragmentIndexTest, Finish) {
+    S3FragmentIndex index;
+    index.Update(1, 10, 0);
+    index.Update(2, 20, 0);
+    index.MarkTruncated(3);
+
+    std::vector<uint64_t> inodes;
+    index.Take(1, 10, &inodes);
+    ASSERT_EQ((std::vector<uint64_t>{3, 2, 1}), inodes);
+    ASSERT_EQ(0, index.Size());
+
+    // compacted inode is dropped
+    index.Finish(1, true);
+    ASSERT_EQ(0, index.GetScore(1));
+
+    // inode not compacted is put back, chunk infos appended meanwhile are
+    // added up
+    index.Update(2, 5, 0);
+    index.Finish(2, false);
+    ASSERT_EQ(25, index.GetScore(2));
+
+    index.Finish(3, false);
+    ASSERT_EQ(S3FragmentIndex::kTruncatedScore, index.GetScore(3));
+
+    // finished twice or erased meanwhile
+    index.Finish(2, false);
+    ASSERT_EQ(25, index.GetScore(2));
+    index.Take(1, 10, &inodes);
+    index.Erase(2);
+    index.Finish(2, false);
+    ASSERT_EQ(0, index.GetScore(2));
+    ASSERT_EQ(0, index.Size());
+}
+
+}  // namespace metaserver
+}  // namespace curvefs
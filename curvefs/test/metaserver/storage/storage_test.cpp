@@ -23,7 +23,9 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "src/common/string_util.h"
 #include "curvefs/src/metaserver/storage/iterator.h"
@@ -930,6 +932,47 @@ void TestTransaction(std::shared_ptr<KVStorage> kvStorage) {
     ASSERT_TRUE(s.IsNotFound());
     s = kvStorage->HGet(TableName(1), "key2", &value);
     ASSERT_TRUE(s.IsNotFound());
+
+    // CASE 5: uncommitted mutations are visible inside transaction
+    s = kvStorage->SSet(TableName(1), "key1", Value("value1"));
+    ASSERT_TRUE(s.ok());
+    s = kvStorage->SSet(TableName(1), "key2", Value("value2"));
+    ASSERT_TRUE(s.ok());
+
+    txn = kvStorage->BeginTransaction();
+    s = txn->SSet(TableName(1), "key1", Value("value11"));
+    ASSERT_TRUE(s.ok());
+    s = txn->SDel(TableName(1), "key2");
+    ASSERT_TRUE(s.ok());
+    s = txn->SSet(TableName(1), "key3", Value("value3"));
+    ASSERT_TRUE(s.ok());
+
+    s = txn->SGet(TableName(1), "key1", &value);
+    ASSERT_TRUE(s.ok());
+    ASSERT_EQ(value, Value("value11"));
+    s = txn->SGet(TableName(1), "key2", &value);
+    ASSERT_TRUE(s.IsNotFound());
+
+    std::vector<std::string> keys;
+    iterator = txn->SGetAll(TableName(1));
+    ASSERT_EQ(iterator->Status(), 0);
+    for (iterator->SeekToFirst(); iterator->Valid(); iterator->Next()) {
+        keys.push_back(iterator->Key());
+    }
+    iterator.reset();
+    ASSERT_EQ(keys, std::vector<std::string>({"key1", "key3"}));
+
+    s = txn->Commit();
+    ASSERT_TRUE(s.ok());
+
+    s = kvStorage->SGet(TableName(1), "key1", &value);
+    ASSERT_TRUE(s.ok());
+    ASSERT_EQ(value, Value("value11"));
+    s = kvStorage->SGet(TableName(1), "key2", &value);
+    ASSERT_TRUE(s.IsNotFound());
+    s = kvStorage->SGet(TableName(1), "key3", &value);
+    ASSERT_TRUE(s.ok());
+    ASSERT_EQ(value, Value("value3"));
 }
 
 }  // namespace storage
@@ -309,6 +309,40 @@ TEST(ExtentTest, TestAsSmallAllocatorWithHint) {
     }
 }
 
+TEST(ExtentTest, TestAllocBestFit) {
+    FreeExtents freeExt(0, 16 * kMiB);
+    AllocateHint hint;
+
+    Extents exts;
+    ASSERT_EQ(16 * kMiB, freeExt.Alloc(16 * kMiB, hint, &exts));
+
+    freeExt.DeAlloc(0, 4 * kMiB);
+    freeExt.DeAlloc(8 * kMiB, 1 * kMiB);
+    freeExt.DeAlloc(12 * kMiB, 2 * kMiB);
+    ASSERT_EQ(7 * kMiB, freeExt.AvailableSize());
+
+    // the smallest extent that satisfies the size is chosen
+    exts.clear();
+    ASSERT_EQ(1 * kMiB, freeExt.Alloc(1 * kMiB, hint, &exts));
+    ASSERT_EQ(Extents{Extent(8 * kMiB, 1 * kMiB)}, exts);
+
+    exts.clear();
+    ASSERT_EQ(1 * kMiB, freeExt.Alloc(1 * kMiB, hint, &exts));
+    ASSERT_EQ(Extents{Extent(12 * kMiB, 1 * kMiB)}, exts);
+
+    exts.clear();
+    ASSERT_EQ(2 * kMiB, freeExt.Alloc(2 * kMiB, hint, &exts));
+    ASSERT_EQ(Extents{Extent(0, 2 * kMiB)}, exts);
+
+    // no extent is large enough
+    exts.clear();
+    ASSERT_EQ(3 * kMiB, freeExt.Alloc(4 * kMiB, hint, &exts));
+    Extents expected = {{2 * kMiB, 2 * kMiB}, {13 * kMiB, 1 * kMiB}};
+    ASSERT_EQ(expected, exts);
+    ASSERT_EQ(0, freeExt.AvailableSize());
+    ASSERT_TRUE(freeExt.AvailableExtents().empty());
+}
+
 TEST(ExtentTest, TestMarkUsed) {
     FreeExtents freeExt(16 * kMiB, 16 * kMiB);
     EXPECT_EQ(16 * kMiB, freeExt.AvailableSize());
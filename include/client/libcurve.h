@@ -172,6 +172,26 @@ int AioRead(int fd, CurveAioContext* aioctx);
  */
 int AioWrite(int fd, CurveAioContext* aioctx);
 
+/**
+ * @brief Asynchronous vectored read, data is scattered into the user
+ *        iovecs directly without a contiguous bounce buffer
+ * @param fd file descriptor
+ * @param aioctx async request context, aioctx->buf points to a
+ *        CurveIOVector whose total length must equal aioctx->length
+ * @return 0 means success, otherwise it means failure
+ */
+int AioReadv(int fd, CurveAioContext* aioctx);
+
+/**
+ * @brief Asynchronous vectored write, user iovecs are sent as they are
+ *        without being linearized first
+ * @param fd file descriptor
+ * @param aioctx async request context, aioctx->buf points to a
+ *        CurveIOVector whose total length must equal aioctx->length
+ * @return 0 means success, otherwise it means failure
+ */
+int AioWritev(int fd, CurveAioContext* aioctx);
+
 /**
  * @brief Asynchronous discard operation
  * @param fd file descriptor
@@ -180,6 +200,57 @@ int AioWrite(int fd, CurveAioContext* aioctx);
  */
 int AioDiscard(int fd, CurveAioContext* aioctx);
 
+/**
+ * @brief Create an aio queue. Requests submitted through the queue don't
+ *        run user callbacks on brpc/bthread workers, their completions are
+ *        collected in the queue and returned by AioQueuePoll, which is
+ *        usually called from the frontend's own polling thread.
+ * @param depth max number of requests in the queue, including completed
+ *        ones that have not been polled yet
+ * @return the queue on success, otherwise NULL
+ */
+CurveAioQueue* AioQueueCreate(uint32_t depth);
+
+/**
+ * @brief Destroy an aio queue
+ * @param queue the queue returned by AioQueueCreate
+ * @return 0 on success, -LIBCURVE_ERROR::FAILED if the queue still has
+ *         requests that have not been polled
+ */
+int AioQueueDestroy(CurveAioQueue* queue);
+
+/**
+ * @brief Get the eventfd of an aio queue. It becomes readable when the
+ *        queue goes from no completion to having completions, so after it
+ *        fires, callers should poll until AioQueuePoll returns 0 before
+ *        waiting on it again. Callers that busy-poll can ignore it
+ * @param queue the queue returned by AioQueueCreate
+ * @return the eventfd
+ */
+int AioQueueEventFd(CurveAioQueue* queue);
+
+/**
+ * @brief Submit requests of a file in batch
+ * @param queue the queue returned by AioQueueCreate
+ * @param fd file descriptor
+ * @param reqs requests to submit, they must stay valid until polled
+ * @param nr number of requests
+ * @return number of requests submitted, which is less than nr if the
+ *         queue is full or a request failed to submit. If the first request
+ *         can't be submitted, return its error code
+ */
+int AioQueueSubmit(CurveAioQueue* queue, int fd,
+                   CurveAioQueueRequest** reqs, int nr);
+
+/**
+ * @brief Get completed requests, don't block
+ * @param queue the queue returned by AioQueueCreate
+ * @param[out] reqs completed requests, whose ret is filled
+ * @param max max number of requests to return
+ * @return number of completed requests returned
+ */
+int AioQueuePoll(CurveAioQueue* queue, CurveAioQueueRequest** reqs, int max);
+
 /**
  * 重命名文件
  * @param: userinfo是用户信息
@@ -342,7 +413,8 @@ class FileClient;
 
 enum class UserDataType {
     RawBuffer,  // char*
-    IOBuffer   // butil::IOBuf*
+    IOBuffer,   // butil::IOBuf*
+    IOVector    // CurveIOVector*
 };
 
 // 存储用户信息
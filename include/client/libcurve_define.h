@@ -26,6 +26,7 @@
 
 #include <unistd.h>
 #include <stdint.h>
+#include <sys/uio.h>
 
 enum LIBCURVE_ERROR {
     // success
@@ -116,4 +117,29 @@ typedef struct CurveAioContext {
     void*               buf;
 } CurveAioContext;
 
+// user buffer made of several segments, see AioReadv/AioWritev.
+// the iov array and the memory it points to must stay valid until the
+// request completes
+typedef struct CurveIOVector {
+    const struct iovec* iov;
+    int                 iovcnt;
+} CurveIOVector;
+
+// request submitted to a CurveAioQueue, see AioQueueSubmit
+typedef struct CurveAioQueueRequest {
+    LIBCURVE_OP         op;
+    off_t               offset;
+    size_t              length;
+    void*               buf;
+    // non-zero if buf points to a CurveIOVector
+    int                 vectored;
+    // returned untouched with the completion
+    void*               userdata;
+    // same as CurveAioContext::ret, valid after the request is polled
+    int                 ret;
+} CurveAioQueueRequest;
+
+// opaque handle of an aio queue
+typedef struct CurveAioQueue CurveAioQueue;
+
 #endif  // INCLUDE_CLIENT_LIBCURVE_DEFINE_H_
@@ -0,0 +1,438 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: nebd
+ * Created Date: 2023-04-05
+ * Author: curve
+ */
+
+#include "nebd/src/common/shm_buffer.h"
+
+#include <fcntl.h>
+#include <glog/logging.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <cstring>
+
+#include "nebd/src/common/timeutility.h"
+
+// 老版本的glibc没有memfd和file seal的定义
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#ifndef MFD_ALLOW_SEALING
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS (1024 + 9)
+#define F_GET_SEALS (1024 + 10)
+#define F_SEAL_SEAL 0x0001
+#define F_SEAL_SHRINK 0x0002
+#define F_SEAL_GROW 0x0004
+#endif
+
+namespace nebd {
+namespace common {
+
+namespace {
+
+const char kShmRegionPrefix[] = "nebd-";
+
+// 从pos开始解析十进制数字，返回解析结束的位置，没有数字或者溢出返回npos
+size_t ParseNumber(const std::string& str, size_t pos, uint64_t* value) {
+    const size_t begin = pos;
+    *value = 0;
+    for (; pos < str.size() && str[pos] >= '0' && str[pos] <= '9'; ++pos) {
+        uint64_t digit = str[pos] - '0';
+        if (*value > (UINT64_MAX - digit) / 10) {
+            return std::string::npos;
+        }
+        *value = *value * 10 + digit;
+    }
+
+    return pos == begin ? std::string::npos : pos;
+}
+
+std::string ReadLink(const std::string& path) {
+    char buf[256];
+    ssize_t len = readlink(path.c_str(), buf, sizeof(buf));
+    if (len < 0 || static_cast<size_t>(len) >= sizeof(buf)) {
+        return "";
+    }
+
+    return std::string(buf, len);
+}
+
+// 打开part1进程中的memfd，并检查确实是该进程创建的共享内存
+int OpenOwnerMemfd(const std::string& name, pid_t pid, int memfd) {
+    std::string procPath = "/proc/" + std::to_string(pid);
+    struct stat procSt;
+    if (stat(procPath.c_str(), &procSt) != 0) {
+        LOG(ERROR) << "Stat shm owner failed, name: " << name
+                   << ", pid: " << pid << ", error: " << strerror(errno);
+        return -1;
+    }
+
+    std::string fdPath = procPath + "/fd/" + std::to_string(memfd);
+    int fd = open(fdPath.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        LOG(ERROR) << "Open shm failed, name: " << name
+                   << ", path: " << fdPath << ", error: " << strerror(errno);
+        return -1;
+    }
+
+    // 打开之后再检查，避免检查和打开之间fd被替换
+    std::string link = ReadLink("/proc/self/fd/" + std::to_string(fd));
+    int seals = fcntl(fd, F_GET_SEALS);
+    struct stat st;
+    if (link != "/memfd:" + name + " (deleted)") {
+        LOG(ERROR) << "Shm name mismatch, name: " << name
+                   << ", pid: " << pid << ", memfd: " << memfd
+                   << ", link: " << link;
+    } else if (fstat(fd, &st) != 0 || st.st_uid != procSt.st_uid) {
+        LOG(ERROR) << "Shm owner mismatch, name: " << name
+                   << ", pid: " << pid << ", process uid: " << procSt.st_uid;
+    } else if (seals < 0 || (seals & F_SEAL_SHRINK) == 0) {
+        // 共享内存被缩小之后访问会收到SIGBUS，part2不能映射可以缩小的内存
+        LOG(ERROR) << "Shm is not sealed against shrinking, name: " << name;
+    } else {
+        return fd;
+    }
+
+    close(fd);
+    return -1;
+}
+
+}  // namespace
+
+std::string ShmRegionName(pid_t pid, uint64_t token) {
+    return kShmRegionPrefix + std::to_string(pid) + "-" +
+           std::to_string(token);
+}
+
+bool IsValidShmRegionName(const std::string& name, pid_t* pid) {
+    const size_t prefixLen = sizeof(kShmRegionPrefix) - 1;
+    if (name.compare(0, prefixLen, kShmRegionPrefix) != 0) {
+        return false;
+    }
+
+    uint64_t pidValue = 0;
+    uint64_t token = 0;
+    size_t pos = ParseNumber(name, prefixLen, &pidValue);
+    if (pos == std::string::npos || pos >= name.size() || name[pos] != '-' ||
+        pidValue > INT32_MAX) {
+        return false;
+    }
+
+    pos = ParseNumber(name, pos + 1, &token);
+    if (pos != name.size()) {
+        return false;
+    }
+
+    if (pid != nullptr) {
+        *pid = static_cast<pid_t>(pidValue);
+    }
+    return true;
+}
+
+ShmBufferPool::ShmBufferPool()
+    : pid_(0), token_(0), fd_(-1), addr_(nullptr), size_(0), nextPage_(0),
+      allocated_(0), quarantined_(0) {}
+
+ShmBufferPool::~ShmBufferPool() {
+    Fini();
+}
+
+int ShmBufferPool::Init(pid_t pid, uint64_t size) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (addr_ != nullptr) {
+        return 0;
+    }
+
+    size = (size + kShmPageSize - 1) / kShmPageSize * kShmPageSize;
+    if (size == 0) {
+        LOG(ERROR) << "Shm size is 0, pid: " << pid;
+        return -1;
+    }
+
+    pid_ = pid;
+    size_ = size;
+    allocated_ = 0;
+    if (CreateRegion() != 0) {
+        size_ = 0;
+        return -1;
+    }
+
+    LOG(INFO) << "Init shm buffer pool success, name: " << name_
+              << ", size: " << size_;
+    return 0;
+}
+
+int ShmBufferPool::CreateRegion() {
+    token_ = std::max(token_ + 1, TimeUtility::GetTimeofDayUs());
+    std::string name = ShmRegionName(pid_, token_);
+    int fd = syscall(SYS_memfd_create, name.c_str(),
+                     MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        LOG(ERROR) << "memfd_create failed, name: " << name
+                   << ", error: " << strerror(errno);
+        return -1;
+    }
+
+    // 固定大小之后part2可以一直信任映射时的大小
+    if (ftruncate(fd, size_) != 0 ||
+        fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) !=
+            0) {
+        LOG(ERROR) << "Resize and seal shm failed, name: " << name
+                   << ", size: " << size_ << ", error: " << strerror(errno);
+        close(fd);
+        return -1;
+    }
+
+    void* addr = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      fd, 0);
+    if (addr == MAP_FAILED) {
+        LOG(ERROR) << "mmap shm failed, name: " << name
+                   << ", size: " << size_ << ", error: " << strerror(errno);
+        close(fd);
+        return -1;
+    }
+
+    name_ = name;
+    fd_ = fd;
+    addr_ = static_cast<char*>(addr);
+    used_.assign(size_ / kShmPageSize, false);
+    nextPage_ = 0;
+    quarantined_ = 0;
+    return 0;
+}
+
+bool ShmBufferPool::WaitAllFree(uint64_t timeoutMs) {
+    std::unique_lock<std::mutex> lk(mtx_);
+    return freeCond_.wait_for(lk, std::chrono::milliseconds(timeoutMs),
+                              [this]() { return allocated_ == 0; });
+}
+
+void ShmBufferPool::Fini() {
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (addr_ == nullptr) {
+        return;
+    }
+
+    if (allocated_ == 0) {
+        munmap(addr_, size_);
+    } else {
+        LOG(WARNING) << "Shm buffers still in use, keep the mapping, name: "
+                     << name_ << ", buffers: " << allocated_;
+    }
+    // 关闭之后part2不能再打开这块共享内存，已经建立的映射不受影响
+    close(fd_);
+    fd_ = -1;
+    addr_ = nullptr;
+    size_ = 0;
+    used_.clear();
+    quarantined_ = 0;
+}
+
+bool ShmBufferPool::Allocate(uint64_t length, ShmBuffer* buf) {
+    const uint64_t pages = (length + kShmPageSize - 1) / kShmPageSize;
+
+    std::lock_guard<std::mutex> lk(mtx_);
+    const uint64_t total = used_.size();
+    if (addr_ == nullptr || pages == 0 || pages > total) {
+        return false;
+    }
+
+    // 从上次分配结束的位置开始查找连续的空闲页，找不到再从头查找
+    uint64_t first = 0;
+    if (!FindFreePages(nextPage_, pages, &first) &&
+        !FindFreePages(0, pages, &first)) {
+        return false;
+    }
+
+    for (uint64_t i = first; i < first + pages; ++i) {
+        used_[i] = true;
+    }
+    nextPage_ = first + pages;
+    ++allocated_;
+
+    buf->offset = first * kShmPageSize;
+    buf->length = length;
+    buf->addr = addr_ + buf->offset;
+    return true;
+}
+
+bool ShmBufferPool::FindFreePages(uint64_t begin, uint64_t pages,
+                                  uint64_t* first) const {
+    uint64_t run = 0;
+    for (uint64_t page = begin; page < used_.size(); ++page) {
+        run = used_[page] ? 0 : run + 1;
+        if (run == pages) {
+            *first = page + 1 - pages;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ShmBufferPool::Free(const ShmBuffer& buf) {
+    if (buf.length == 0) {
+        return;
+    }
+
+    const uint64_t first = buf.offset / kShmPageSize;
+    const uint64_t pages = (buf.length + kShmPageSize - 1) / kShmPageSize;
+
+    std::lock_guard<std::mutex> lk(mtx_);
+    for (uint64_t i = first; i < first + pages && i < used_.size(); ++i) {
+        used_[i] = false;
+    }
+
+    // Fini之后used_已经清空，这里只需要维护计数
+    OnBufferReleased();
+}
+
+void ShmBufferPool::Quarantine(const ShmBuffer& buf) {
+    if (buf.length == 0) {
+        return;
+    }
+
+    const uint64_t pages = (buf.length + kShmPageSize - 1) / kShmPageSize;
+
+    std::lock_guard<std::mutex> lk(mtx_);
+    LOG(WARNING) << "Quarantine shm buffer, name: " << name_
+                 << ", offset: " << buf.offset << ", length: " << buf.length;
+    // 页保持使用状态，直到重新创建共享内存
+    if (addr_ != nullptr) {
+        quarantined_ += pages;
+    }
+    OnBufferReleased();
+}
+
+void ShmBufferPool::OnBufferReleased() {
+    if (allocated_ > 0) {
+        --allocated_;
+    }
+    if (allocated_ != 0) {
+        return;
+    }
+    freeCond_.notify_all();
+
+    if (addr_ == nullptr || quarantined_ * 2 < used_.size()) {
+        return;
+    }
+
+    // 没有在用的缓冲区，part1不会再访问旧的映射，part2自己的映射不受影响
+    LOG(INFO) << "Recreate shm, name: " << name_
+              << ", quarantined pages: " << quarantined_;
+    munmap(addr_, size_);
+    close(fd_);
+    fd_ = -1;
+    addr_ = nullptr;
+    if (CreateRegion() != 0) {
+        LOG(ERROR) << "Recreate shm failed, read and write data by socket";
+        size_ = 0;
+        used_.clear();
+        quarantined_ = 0;
+    }
+}
+
+ShmRegion::~ShmRegion() {
+    munmap(addr_, size_);
+}
+
+char* ShmRegion::GetAddress(uint64_t offset, uint64_t length) const {
+    if (offset > size_ || length > size_ - offset) {
+        return nullptr;
+    }
+
+    return addr_ + offset;
+}
+
+ShmRegionPtr ShmRegionCache::Get(const std::string& name, pid_t ownerPid,
+                                  int memfd) {
+    pid_t pid = 0;
+    if (!IsValidShmRegionName(name, &pid)) {
+        LOG(ERROR) << "Invalid shm name: " << name;
+        return nullptr;
+    }
+
+    if (pid != ownerPid) {
+        LOG(ERROR) << "Shm does not belong to the file owner, name: " << name
+                   << ", owner pid: " << ownerPid;
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lk(mtx_);
+    auto iter = regions_.find(pid);
+    if (iter != regions_.end() && iter->second.name == name) {
+        return iter->second.region;
+    }
+
+    int fd = OpenOwnerMemfd(name, pid, memfd);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        LOG(ERROR) << "Get shm size failed, name: " << name;
+        close(fd);
+        return nullptr;
+    }
+
+    void* addr = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        LOG(ERROR) << "mmap shm failed, name: " << name
+                   << ", error: " << strerror(errno);
+        return nullptr;
+    }
+
+    LOG(INFO) << "Map shm success, name: " << name
+              << ", size: " << st.st_size;
+    ShmRegionPtr region = std::make_shared<ShmRegion>(
+        static_cast<char*>(addr), st.st_size);
+    // part1重新初始化或者pid被复用，旧的共享内存已经被删除，替换掉
+    if (iter != regions_.end()) {
+        LOG(INFO) << "Replace shm mapping, old name: " << iter->second.name
+                  << ", new name: " << name;
+    }
+    regions_[pid] = Entry{name, region};
+    return region;
+}
+
+void ShmRegionCache::Remove(pid_t pid) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    auto iter = regions_.find(pid);
+    if (iter != regions_.end()) {
+        LOG(INFO) << "Remove shm mapping, name: " << iter->second.name;
+        regions_.erase(iter);
+    }
+}
+
+}  // namespace common
+}  // namespace nebd
@@ -0,0 +1,237 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: nebd
+ * Created Date: 2023-04-05
+ * Author: curve
+ */
+
+#ifndef NEBD_SRC_COMMON_SHM_BUFFER_H_
+#define NEBD_SRC_COMMON_SHM_BUFFER_H_
+
+#include <sys/types.h>
+
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "nebd/src/common/uncopyable.h"
+
+namespace nebd {
+namespace common {
+
+// 共享内存数据缓冲区的分配粒度
+const uint64_t kShmPageSize = 4096;
+
+/**
+ * @brief 获取part1进程对应的共享内存名字，也是memfd的名字
+ *
+ * @param pid part1进程的pid
+ * @param token 每次创建共享内存时生成，区分同一进程重新初始化
+ *              以及pid复用时创建的共享内存
+ * @return 共享内存名字，格式为nebd-<pid>-<token>
+ */
+std::string ShmRegionName(pid_t pid, uint64_t token);
+
+/**
+ * @brief 检查共享内存名字是否合法，part2只映射part1创建的共享内存
+ *
+ * @param name 共享内存名字
+ * @param[out] pid 不为空时返回名字中的pid
+ */
+bool IsValidShmRegionName(const std::string& name, pid_t* pid = nullptr);
+
+// 共享内存中的一段数据缓冲区
+struct ShmBuffer {
+    // 在共享内存中的偏移
+    uint64_t offset = 0;
+    // 缓冲区长度，为0表示没有分配
+    uint64_t length = 0;
+    // 缓冲区在当前进程中的地址
+    char* addr = nullptr;
+};
+
+/**
+ * part1使用，创建一块共享内存，并按页从中分配读写请求的数据缓冲区，
+ * 数据缓冲区的偏移通过rpc请求传给part2，读写数据不再经过socket。
+ * 共享内存是一个禁止缩小的memfd，不在/dev/shm下创建文件，part2只能通过
+ * /proc/<pid>/fd/<memfd>打开，其他进程无法按名字打开，也无法缩小之后
+ * 让part2访问时收到SIGBUS
+ */
+class ShmBufferPool : public Uncopyable {
+ public:
+    ShmBufferPool();
+
+    ~ShmBufferPool();
+
+    /**
+     * @brief 创建并映射共享内存
+     *
+     * @param pid 当前进程的pid，共享内存名字为ShmRegionName(pid, token)，
+     *            token取创建时间，每次创建都不同
+     * @param size 共享内存大小，向上对齐到kShmPageSize
+     * @return 成功返回0，失败返回-1
+     */
+    int Init(pid_t pid, uint64_t size);
+
+    /**
+     * @brief 等待所有缓冲区被释放
+     *
+     * @param timeoutMs 最长等待时间
+     * @return 所有缓冲区都已释放返回true，超时返回false
+     */
+    bool WaitAllFree(uint64_t timeoutMs);
+
+    /**
+     * @brief 解除映射并关闭memfd，还有缓冲区没有释放时只关闭memfd，
+     *        保留映射，避免还在处理的请求访问已经解除映射的地址
+     */
+    void Fini();
+
+    /**
+     * @brief 分配一段连续的数据缓冲区
+     *
+     * @param length 需要的长度
+     * @param[out] buf 分配到的缓冲区
+     * @return 分配成功返回true，空间不足或者未初始化返回false
+     */
+    bool Allocate(uint64_t length, ShmBuffer* buf);
+
+    /**
+     * @brief 释放Allocate分配的缓冲区
+     */
+    void Free(const ShmBuffer& buf);
+
+    /**
+     * @brief 隔离rpc失败过的缓冲区。part2可能还在处理失败的请求，
+     *        之后还会读写这块缓冲区，所以不能再分配给其他请求。
+     *        隔离的页超过一半并且没有在用的缓冲区时重新创建共享内存，
+     *        part2对旧共享内存的访问不再影响新的请求
+     */
+    void Quarantine(const ShmBuffer& buf);
+
+    const std::string& Name() const {
+        return name_;
+    }
+
+    // part2通过/proc/<pid>/fd/<memfd>打开共享内存，未初始化时返回-1
+    int Fd() const {
+        return fd_;
+    }
+
+ private:
+    // 从begin开始查找连续pages个空闲页，调用方需要持有锁
+    bool FindFreePages(uint64_t begin, uint64_t pages, uint64_t* first) const;
+
+    // 创建并映射size_大小的共享内存，调用方需要持有锁
+    int CreateRegion();
+
+    // 释放一个缓冲区之后的处理，调用方需要持有锁
+    void OnBufferReleased();
+
+ private:
+    pid_t pid_;
+    // 上一次创建共享内存使用的token
+    uint64_t token_;
+    std::string name_;
+    int fd_;
+    char* addr_;
+    uint64_t size_;
+
+    std::mutex mtx_;
+    std::condition_variable freeCond_;
+    // 每一页是否被使用
+    std::vector<bool> used_;
+    // 下一次分配开始查找的页，避免每次都从头查找
+    uint64_t nextPage_;
+    // 已分配还没有释放的缓冲区个数
+    uint64_t allocated_;
+    // 被隔离的页数
+    uint64_t quarantined_;
+};
+
+// part2映射的一块part1的共享内存
+class ShmRegion : public Uncopyable {
+ public:
+    ShmRegion(char* addr, uint64_t size) : addr_(addr), size_(size) {}
+
+    ~ShmRegion();
+
+    /**
+     * @brief 获取[offset, offset + length)对应的地址，越界返回nullptr
+     */
+    char* GetAddress(uint64_t offset, uint64_t length) const;
+
+ private:
+    char* addr_;
+    uint64_t size_;
+};
+
+using ShmRegionPtr = std::shared_ptr<ShmRegion>;
+
+/**
+ * part2使用，映射part1创建的共享内存并缓存映射关系，
+ * 正在处理的请求持有ShmRegionPtr，Remove之后等请求结束才真正解除映射。
+ * 每个part1进程只缓存最新的一块共享内存，part1重新初始化或者pid被复用时
+ * 名字会变化，旧的映射被替换。
+ * part2是所有part1共用的，只映射打开文件的part1进程自己的共享内存，
+ * 避免一个part1通过part2读写其他进程的数据
+ */
+class ShmRegionCache : public Uncopyable {
+ public:
+    static ShmRegionCache& GetInstance() {
+        static ShmRegionCache cache;
+        return cache;
+    }
+
+    /**
+     * @brief 获取共享内存的映射，没有映射过则打开并映射。
+     *        只映射名字中的pid为ownerPid、属于ownerPid进程的用户、
+     *        并且禁止缩小的memfd
+     *
+     * @param name 共享内存名字
+     * @param ownerPid 打开文件的part1进程的pid
+     * @param memfd 共享内存在ownerPid进程中的fd
+     * @return 成功返回映射，名字不合法、不属于ownerPid或者映射失败返回nullptr
+     */
+    ShmRegionPtr Get(const std::string& name, pid_t ownerPid, int memfd);
+
+    /**
+     * @brief 删除part1进程的共享内存映射，part1退出之后调用
+     */
+    void Remove(pid_t pid);
+
+ private:
+    ShmRegionCache() = default;
+
+    struct Entry {
+        std::string name;
+        ShmRegionPtr region;
+    };
+
+    std::mutex mtx_;
+    std::unordered_map<pid_t, Entry> regions_;
+};
+
+}  // namespace common
+}  // namespace nebd
+
+#endif  // NEBD_SRC_COMMON_SHM_BUFFER_H_
@@ -26,6 +26,7 @@
 #include <bthread/bthread.h>
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 
 namespace nebd {
@@ -45,6 +46,9 @@ void AsyncRequestClosure::Run() {
             << ", log id = " << cntl.log_id()
             << ", retryCount = " << aioCtx->retryCount
             << ", sleep " << (sleepUs / 1000) << " ms";
+        // part2可能还在处理失败的请求，之后还会读写这块缓冲区，
+        // 不能释放给其他请求使用
+        nebdClient.QuarantineShmBuffer(shmBuf);
         bthread_usleep(sleepUs);
         Retry();
     } else {
@@ -53,11 +57,15 @@ void AsyncRequestClosure::Run() {
             DVLOG(6) << OpTypeToString(aioCtx->op) << " success, fd = " << fd;
 
             // 读请求复制数据
-            if (aioCtx->op == LIBAIO_OP::LIBAIO_OP_READ) {
+            if (aioCtx->op == LIBAIO_OP::LIBAIO_OP_READ &&
+                shmBuf.length != 0) {
+                memcpy(aioCtx->buf, shmBuf.addr, shmBuf.length);
+            } else if (aioCtx->op == LIBAIO_OP::LIBAIO_OP_READ) {
                 cntl.response_attachment().copy_to(
                     aioCtx->buf, cntl.response_attachment().size());
             }
 
+            nebdClient.FreeShmBuffer(shmBuf);
             aioCtx->ret = 0;
             aioCtx->cb(aioCtx);
         } else {
@@ -66,6 +74,7 @@ void AsyncRequestClosure::Run() {
                        << ", length = " << aioCtx->length
                        << ", retCode = " << GetResponseRetCode()
                        << ", log id = " << cntl.log_id();
+            nebdClient.FreeShmBuffer(shmBuf);
             aioCtx->ret = -1;
             aioCtx->cb(aioCtx);
         }
@@ -91,11 +100,12 @@ int64_t AsyncRequestClosure::GetRpcRetryIntervalUs(int64_t retryCount) const {
 
 void AsyncRequestClosure::Retry() const {
     switch (aioCtx->op) {
+        // 共享内存不可用时part2也会让请求失败，重试时通过socket传递数据
         case LIBAIO_OP::LIBAIO_OP_WRITE:
-            nebdClient.AioWrite(fd, aioCtx);
+            nebdClient.SendAioWrite(fd, aioCtx, false);
             break;
         case LIBAIO_OP::LIBAIO_OP_READ:
-            nebdClient.AioRead(fd, aioCtx);
+            nebdClient.SendAioRead(fd, aioCtx, false);
             break;
         case LIBAIO_OP::LIBAIO_OP_FLUSH:
             nebdClient.Flush(fd, aioCtx);
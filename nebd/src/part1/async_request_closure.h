@@ -57,6 +57,9 @@ struct AsyncRequestClosure : public google::protobuf::Closure {
     brpc::Controller cntl;
 
     RequestOption requestOption_;
+
+    // 读写数据使用的共享内存缓冲区，长度为0表示数据通过attachment传递
+    ShmBuffer shmBuf;
 };
 
 struct AioWriteClosure : public AsyncRequestClosure {
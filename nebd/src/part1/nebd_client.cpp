@@ -29,6 +29,7 @@
 #include <glog/logging.h>
 #include <gflags/gflags.h>
 #include <bthread/bthread.h>
+#include <cstring>
 #include <string>
 
 #include "nebd/src/part1/async_request_closure.h"
@@ -97,6 +98,12 @@ int NebdClient::Init(const char* confpath) {
         return -1;
     }
 
+    if (option_.shmOption.enable) {
+        ret = shmPool_.Init(getpid(), option_.shmOption.sizeMB * 1024 * 1024);
+        LOG_IF(WARNING, ret != 0)
+            << "Init shm buffer pool failed, read and write data by socket";
+    }
+
     metaCache_ = std::make_shared<NebdClientMetaCache>();
     heartbeatMgr_ = std::make_shared<HeartbeatManager>(
         metaCache_);
@@ -111,9 +118,12 @@ int NebdClient::Init(const char* confpath) {
 
     // init rpc send exec-queue
     rpcTaskQueues_.resize(option_.requestOption.rpcSendExecQueueNum);
-    for (auto& q : rpcTaskQueues_) {
+    for (size_t i = 0; i < rpcTaskQueues_.size(); ++i) {
+        rpcQueueMetrics_.emplace_back(new AsyncRpcQueueMetric(
+            "nebd_client_rpc_queue_" + std::to_string(i)));
         int rc = bthread::execution_queue_start(
-            &q, nullptr, &NebdClient::ExecAsyncRpcTask, this);
+            &rpcTaskQueues_[i], nullptr, &NebdClient::ExecAsyncRpcTask,
+            rpcQueueMetrics_[i].get());
         if (rc != 0) {
             LOG(ERROR) << "Init AsyncRpcQueues failed";
             return -1;
@@ -133,6 +143,13 @@ void NebdClient::Uninit() {
         bthread::execution_queue_stop(q);
         bthread::execution_queue_join(q);
     }
+    rpcQueueMetrics_.clear();
+
+    // 已经发出的请求返回时还会访问共享内存，等它们结束之后再解除映射
+    if (!shmPool_.WaitAllFree(option_.shmOption.uninitWaitMs)) {
+        LOG(WARNING) << "Wait shm buffers free timeout";
+    }
+    shmPool_.Fini();
 
     LOG(INFO) << "NebdClient uninit success.";
     google::ShutdownGoogleLogging();
@@ -158,6 +175,7 @@ int NebdClient::Open(const char* filename, const NebdOpenFlags* flags) {
         OpenFileResponse response;
 
         request.set_filename(filename);
+        request.set_pid(getpid());
 
         if (flags != nullptr) {
             auto* p = request.mutable_flags();
@@ -335,29 +353,41 @@ int NebdClient::Discard(int fd, NebdClientAioContext* aioctx) {
         stub.Discard(&done->cntl, &request, &done->response, done);
     };
 
-    PushAsyncTask(task);
+    PushAsyncTask(fd, task);
 
     return 0;
 }
 
 int NebdClient::AioRead(int fd, NebdClientAioContext* aioctx) {
-    auto task = [this, fd, aioctx]() {
+    SendAioRead(fd, aioctx, true);
+    return 0;
+}
+
+void NebdClient::SendAioRead(int fd, NebdClientAioContext* aioctx,
+                             bool useShm) {
+    auto task = [this, fd, aioctx, useShm]() {
         nebd::client::NebdFileService_Stub stub(&channel_);
         nebd::client::ReadRequest request;
         request.set_fd(fd);
         request.set_offset(aioctx->offset);
         request.set_size(aioctx->length);
 
+        ShmBuffer shmBuf;
+        if (useShm && AllocateShmBuffer(aioctx->length, &shmBuf)) {
+            request.mutable_shmbuf()->set_name(shmPool_.Name());
+            request.mutable_shmbuf()->set_offset(shmBuf.offset);
+            request.mutable_shmbuf()->set_memfd(shmPool_.Fd());
+        }
+
         AioReadClosure* done = new(std::nothrow) AioReadClosure(
             fd, aioctx, option_.requestOption);
+        done->shmBuf = shmBuf;
         done->cntl.set_timeout_ms(-1);
         done->cntl.set_log_id(logId_.fetch_add(1, std::memory_order_relaxed));
         stub.Read(&done->cntl, &request, &done->response, done);
     };
 
-    PushAsyncTask(task);
-
-    return 0;
+    PushAsyncTask(fd, task);
 }
 
 static void EmptyDeleter(void* m) {
@@ -365,26 +395,51 @@ static void EmptyDeleter(void* m) {
 }
 
 int NebdClient::AioWrite(int fd, NebdClientAioContext* aioctx) {
-    auto task = [this, fd, aioctx]() {
+    SendAioWrite(fd, aioctx, true);
+    return 0;
+}
+
+void NebdClient::SendAioWrite(int fd, NebdClientAioContext* aioctx,
+                              bool useShm) {
+    auto task = [this, fd, aioctx, useShm]() {
         nebd::client::NebdFileService_Stub stub(&channel_);
         nebd::client::WriteRequest request;
         request.set_fd(fd);
         request.set_offset(aioctx->offset);
         request.set_size(aioctx->length);
 
+        ShmBuffer shmBuf;
+        if (useShm && AllocateShmBuffer(aioctx->length, &shmBuf)) {
+            memcpy(shmBuf.addr, aioctx->buf, aioctx->length);
+        }
+
         AioWriteClosure* done = new(std::nothrow) AioWriteClosure(
             fd, aioctx, option_.requestOption);
+        done->shmBuf = shmBuf;
 
         done->cntl.set_timeout_ms(-1);
         done->cntl.set_log_id(logId_.fetch_add(1, std::memory_order_relaxed));
-        done->cntl.request_attachment().append_user_data(
-            aioctx->buf, aioctx->length, EmptyDeleter);
+        if (shmBuf.length != 0) {
+            request.mutable_shmbuf()->set_name(shmPool_.Name());
+            request.mutable_shmbuf()->set_offset(shmBuf.offset);
+            request.mutable_shmbuf()->set_memfd(shmPool_.Fd());
+        } else {
+            done->cntl.request_attachment().append_user_data(
+                aioctx->buf, aioctx->length, EmptyDeleter);
+        }
         stub.Write(&done->cntl, &request, &done->response, done);
     };
 
-    PushAsyncTask(task);
+    PushAsyncTask(fd, task);
+}
 
-    return 0;
+bool NebdClient::AllocateShmBuffer(uint64_t length, ShmBuffer* buf) {
+    if (!option_.shmOption.enable ||
+        length > option_.shmOption.maxIoSizeKB * 1024) {
+        return false;
+    }
+
+    return shmPool_.Allocate(length, buf);
 }
 
 int NebdClient::Flush(int fd, NebdClientAioContext* aioctx) {
@@ -400,7 +455,7 @@ int NebdClient::Flush(int fd, NebdClientAioContext* aioctx) {
         stub.Flush(&done->cntl, &request, &done->response, done);
     };
 
-    PushAsyncTask(task);
+    PushAsyncTask(fd, task);
 
     return 0;
 }
@@ -532,8 +587,39 @@ int NebdClient::InitNebdClientOption(Configuration* conf) {
            "value is "
         << requestOption.rpcSendExecQueueNum;
 
+    std::string affinity;
+    ret = conf->GetStringValue("request.rpcSendExecQueueAffinity", &affinity);
+    if (ret && affinity == "fd") {
+        requestOption.rpcSendExecQueueAffinity = ExecQueueAffinity::kFd;
+    } else if (ret && affinity != "thread") {
+        LOG(ERROR) << "Unknown request.rpcSendExecQueueAffinity: " << affinity
+                   << ", using thread affinity";
+    }
+
     option_.requestOption = requestOption;
 
+    ret = conf->GetBoolValue("shm.enable", &option_.shmOption.enable);
+    LOG_IF(ERROR, ret != true)
+        << "Load shm.enable from config file failed, current value is "
+        << option_.shmOption.enable;
+
+    ret = conf->GetUInt64Value("shm.sizeMB", &option_.shmOption.sizeMB);
+    LOG_IF(ERROR, ret != true)
+        << "Load shm.sizeMB from config file failed, current value is "
+        << option_.shmOption.sizeMB;
+
+    ret = conf->GetUInt64Value("shm.maxIoSizeKB",
+                               &option_.shmOption.maxIoSizeKB);
+    LOG_IF(ERROR, ret != true)
+        << "Load shm.maxIoSizeKB from config file failed, current value is "
+        << option_.shmOption.maxIoSizeKB;
+
+    ret = conf->GetUInt64Value("shm.uninitWaitMs",
+                               &option_.shmOption.uninitWaitMs);
+    LOG_IF(ERROR, ret != true)
+        << "Load shm.uninitWaitMs from config file failed, current value is "
+        << option_.shmOption.uninitWaitMs;
+
     ret = conf->GetStringValue("log.path", &option_.logOption.logPath);
     LOG_IF(ERROR, ret != true) << "Load log.path failed";
     RETURN_IF_FALSE(ret);
@@ -623,17 +709,36 @@ void NebdClient::InitLogger(const LogOption& logOption) {
     google::InitGoogleLogging(kProcessName);
 }
 
+uint32_t NebdClient::SelectExecQueue(int fd) {
+    const uint32_t queueNum = rpcTaskQueues_.size();
+    if (option_.requestOption.rpcSendExecQueueAffinity ==
+        ExecQueueAffinity::kFd) {
+        return static_cast<uint32_t>(fd) % queueNum;
+    }
+
+    // qemu的每个iothread/vcpu线程固定使用一个队列，不同线程轮流分配
+    static thread_local uint32_t threadSeq =
+        nextThreadSeq_.fetch_add(1, std::memory_order_relaxed);
+    return threadSeq % queueNum;
+}
+
 int NebdClient::ExecAsyncRpcTask(void* meta,
                                  bthread::TaskIterator<AsyncRpcTask>& iter) {  // NOLINT
-    (void)meta;
     if (iter.is_queue_stopped()) {
         return 0;
     }
 
+    // 一次取出队列中所有的请求连续下发，brpc会把这期间对同一个连接的写
+    // 合并成更少的系统调用
+    AsyncRpcQueueMetric* metric = static_cast<AsyncRpcQueueMetric*>(meta);
+    int64_t count = 0;
     for (; iter; ++iter) {
         auto& task = *iter;
-        task();
+        metric->queueLatency << butil::cpuwide_time_us() - task.enqueueUs;
+        task.func();
+        ++count;
     }
+    metric->batchSize << count;
 
     return 0;
 }
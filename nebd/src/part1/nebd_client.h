@@ -25,6 +25,8 @@
 
 #include <brpc/channel.h>
 #include <bthread/execution_queue.h>
+#include <butil/time.h>
+#include <bvar/bvar.h>
 
 #include <functional>
 #include <string>
@@ -33,6 +35,7 @@
 
 #include "nebd/src/part1/nebd_common.h"
 #include "nebd/src/common/configuration.h"
+#include "nebd/src/common/shm_buffer.h"
 #include "nebd/proto/client.pb.h"
 #include "nebd/src/part1/libnebd.h"
 #include "nebd/src/part1/heartbeat_manager.h"
@@ -47,6 +50,7 @@ using RpcTask = std::function<int64_t (brpc::Controller* cntl,
                                        brpc::Channel* channel,
                                        bool* rpcFailed)>;
 using nebd::common::Configuration;
+using nebd::common::ShmBuffer;
 
 class NebdClient {
  public:
@@ -165,6 +169,35 @@ class NebdClient {
     std::string ReplaceSlash(const std::string& str);
 
     int64_t ExecuteSyncRpc(RpcTask task);
+
+    friend struct AsyncRequestClosure;
+
+    /**
+     *  @brief 下发读写请求
+     *  @param fd：文件的fd
+     *         aioctx：异步请求的上下文
+     *         useShm：数据是否优先通过共享内存传递，
+     *                 rpc失败之后重试的请求通过socket传递数据
+     */
+    void SendAioRead(int fd, NebdClientAioContext* aioctx, bool useShm);
+
+    void SendAioWrite(int fd, NebdClientAioContext* aioctx, bool useShm);
+
+    /**
+     *  @brief 为读写请求分配共享内存缓冲区
+     *  @return 成功返回true，未开启、请求过大或者空间不足返回false，
+     *          此时数据通过socket传递
+     */
+    bool AllocateShmBuffer(uint64_t length, ShmBuffer* buf);
+
+    void FreeShmBuffer(const ShmBuffer& buf) {
+        shmPool_.Free(buf);
+    }
+
+    void QuarantineShmBuffer(const ShmBuffer& buf) {
+        shmPool_.Quarantine(buf);
+    }
+
     // 心跳管理模块
     std::shared_ptr<HeartbeatManager> heartbeatMgr_;
     // 缓存模块
@@ -176,21 +209,52 @@ class NebdClient {
 
     std::atomic<uint64_t> logId_{1};
 
+    // 读写数据的共享内存缓冲区
+    nebd::common::ShmBufferPool shmPool_;
+
  private:
-    using AsyncRpcTask = std::function<void()>;
+    struct AsyncRpcTask {
+        std::function<void()> func;
+        // 进入队列的时间
+        uint64_t enqueueUs;
+    };
+
+    // rpc发送执行队列的metric
+    struct AsyncRpcQueueMetric {
+        explicit AsyncRpcQueueMetric(const std::string& prefix)
+            : queueLatency(prefix, "queue_latency"),
+              batchSize(prefix, "batch_size") {}
+
+        // 请求在队列中的等待时间
+        bvar::LatencyRecorder queueLatency;
+        // 每次执行的请求个数
+        bvar::IntRecorder batchSize;
+    };
 
     std::vector<bthread::ExecutionQueueId<AsyncRpcTask>> rpcTaskQueues_;
 
+    std::vector<std::unique_ptr<AsyncRpcQueueMetric>> rpcQueueMetrics_;
+
+    // 线程第一次下发请求时分配的序号，用来选择执行队列
+    std::atomic<uint32_t> nextThreadSeq_{0};
+
     static int ExecAsyncRpcTask(void* meta, bthread::TaskIterator<AsyncRpcTask>& iter);  // NOLINT
 
-    void PushAsyncTask(const AsyncRpcTask& task) {
-        static thread_local unsigned int seed = time(nullptr);
+    /**
+     *  @brief 选择请求的执行队列，同一个线程或者同一个文件的请求
+     *         进入同一个队列，保持请求的顺序
+     *  @param fd：请求的文件fd
+     *  @return 执行队列的下标
+     */
+    uint32_t SelectExecQueue(int fd);
 
-        int idx = rand_r(&seed) % rpcTaskQueues_.size();
-        int rc = bthread::execution_queue_execute(rpcTaskQueues_[idx], task);
+    void PushAsyncTask(int fd, const std::function<void()>& func) {
+        AsyncRpcTask task{func, butil::cpuwide_time_us()};
+        int rc = bthread::execution_queue_execute(
+            rpcTaskQueues_[SelectExecQueue(fd)], task);
 
         if (CURVE_UNLIKELY(rc != 0)) {
-            task();
+            func();
         }
     }
 };
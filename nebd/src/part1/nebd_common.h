@@ -25,6 +25,14 @@
 
 #include <string>
 
+// rpc发送执行队列的选择方式
+enum class ExecQueueAffinity {
+    // 同一个线程下发的请求进入同一个队列
+    kThread = 0,
+    // 同一个文件的请求进入同一个队列
+    kFd = 1,
+};
+
 // rpc request配置项
 struct RequestOption {
     // 同步rpc的最大重试次数
@@ -41,6 +49,8 @@ struct RequestOption {
     int64_t rpcMaxDelayHealthCheckIntervalMs;
     // rpc发送执行队列个数
     uint32_t rpcSendExecQueueNum = 2;
+    // rpc发送执行队列的选择方式
+    ExecQueueAffinity rpcSendExecQueueAffinity = ExecQueueAffinity::kThread;
 };
 
 // 日志配置项
@@ -49,6 +59,18 @@ struct LogOption {
     std::string logPath;
 };
 
+// 共享内存数据通道配置项
+struct ShmOption {
+    // 是否通过共享内存传递读写数据
+    bool enable = false;
+    // 共享内存大小
+    uint64_t sizeMB = 64;
+    // 使用共享内存的单个请求最大长度，超过的请求仍然通过socket传递数据
+    uint64_t maxIoSizeKB = 1024;
+    // Uninit时等待使用共享内存的请求结束的最长时间
+    uint64_t uninitWaitMs = 10000;
+};
+
 // nebd client配置项
 struct NebdClientOption {
     // part2 socket file address
@@ -59,6 +81,8 @@ struct NebdClientOption {
     RequestOption requestOption;
     // 日志配置项
     LogOption logOption;
+    // 共享内存数据通道配置项
+    ShmOption shmOption;
 };
 
 // heartbeat配置项
@@ -30,6 +30,7 @@
 #include <map>
 
 #include "nebd/src/common/rw_lock.h"
+#include "nebd/src/common/shm_buffer.h"
 
 namespace nebd {
 namespace server {
@@ -96,6 +97,10 @@ struct NebdServerAioContext {
     RpcController* cntl = nullptr;
     // return rpc when io error
     bool returnRpcWhenIoError = false;
+    // 读写数据在part1共享内存中的地址，为nullptr表示数据通过attachment传递
+    char* shmAddr = nullptr;
+    // 请求结束之前持有共享内存的映射
+    nebd::common::ShmRegionPtr shmRegion;
 };
 
 struct NebdFileInfo {
@@ -61,6 +61,7 @@ NebdFileEntity::NebdFileEntity()
     , fileName_("")
     , status_(NebdFileStatus::CLOSED)
     , timeStamp_(0)
+    , ownerPid_(0)
     , fileInstance_(nullptr)
     , executor_(nullptr)
     , metaFileManager_(nullptr) {}
@@ -179,6 +179,22 @@ class NebdFileEntity : public std::enable_shared_from_this<NebdFileEntity> {
         return timeStamp_.load();
     }
 
+    virtual void SetOwnerPid(int pid) {
+        ownerPid_.store(pid);
+    }
+
+    /**
+     * 只在还不知道打开文件的进程时记录，part2重启之后通过心跳恢复
+     */
+    virtual void SetOwnerPidIfUnknown(int pid) {
+        int unknown = 0;
+        ownerPid_.compare_exchange_strong(unknown, pid);
+    }
+
+    virtual int GetOwnerPid() const {
+        return ownerPid_.load();
+    }
+
     virtual NebdFileStatus GetFileStatus() const {
         return status_.load();
     }
@@ -219,6 +235,8 @@ class NebdFileEntity : public std::enable_shared_from_this<NebdFileEntity> {
     std::atomic<NebdFileStatus> status_;
     // 该文件上一次收到心跳时的时间戳
     std::atomic<uint64_t> timeStamp_;
+    // 打开该文件的part1进程号，0表示未知，part2只映射该进程的共享内存
+    std::atomic<int> ownerPid_;
     // 文件在executor open时返回上下文信息，用于后续文件的请求处理
     NebdFileInstancePtr fileInstance_;
     // 文件对应的executor的指针
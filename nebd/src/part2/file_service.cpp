@@ -25,12 +25,16 @@
 
 #include <butil/iobuf.h>
 
+#include <cerrno>
+
 #include "nebd/src/part2/file_service.h"
 
 namespace nebd {
 namespace server {
 
 using nebd::client::RetCode;
+using nebd::common::ShmRegionCache;
+using nebd::common::ShmRegionPtr;
 using OpenFlags = nebd::client::ProtoOpenFlags;
 
 /**
@@ -41,6 +45,35 @@ static bool pass_bool(const char*, bool) { return true; }
 DEFINE_bool(dropRpc, false, "drop the request rpc");
 DEFINE_validator(dropRpc, &pass_bool);
 
+static void EmptyDeleter(void* m) {
+    (void)m;
+}
+
+char* NebdFileServiceImpl::GetShmAddress(
+    int fd, const nebd::client::ShmBuffer& shmBuf, uint64_t size,
+    ShmRegionPtr* region) {
+    NebdFileEntityPtr entity = fileManager_->GetFileEntity(fd);
+    // part2重启之后，收到心跳之前还不知道文件是哪个进程打开的
+    int ownerPid = entity == nullptr ? 0 : entity->GetOwnerPid();
+    if (ownerPid == 0) {
+        LOG(WARNING) << "Owner of file is unknown, fd: " << fd
+                     << ", shm name: " << shmBuf.name();
+        return nullptr;
+    }
+
+    *region = ShmRegionCache::GetInstance().Get(shmBuf.name(), ownerPid,
+                                                shmBuf.memfd());
+    if (*region == nullptr) {
+        return nullptr;
+    }
+
+    char* addr = (*region)->GetAddress(shmBuf.offset(), size);
+    LOG_IF(ERROR, addr == nullptr)
+        << "Shm buffer out of range, name: " << shmBuf.name()
+        << ", offset: " << shmBuf.offset() << ", size: " << size;
+    return addr;
+}
+
 void SetResponse(NebdServerAioContext* context, RetCode retCode) {
     switch (context->op) {
         case LIBAIO_OP::LIBAIO_OP_READ:
@@ -48,7 +81,10 @@ void SetResponse(NebdServerAioContext* context, RetCode retCode) {
             nebd::client::ReadResponse* response =
                 dynamic_cast<nebd::client::ReadResponse*>(context->response);
             response->set_retcode(retCode);
-            if (context->ret >= 0) {
+            if (context->ret >= 0 && context->shmAddr != nullptr) {
+                reinterpret_cast<butil::IOBuf*>(context->buf)->copy_to(
+                    context->shmAddr, context->size);
+            } else if (context->ret >= 0) {
                 brpc::Controller* cntl =
                     dynamic_cast<brpc::Controller *>(context->cntl);
                 cntl->response_attachment() =
@@ -127,6 +163,11 @@ void NebdFileServiceImpl::OpenFile(
                            request->has_flags() ? &request->flags() : nullptr);
 
     if (fd > 0) {
+        NebdFileEntityPtr entity =
+            request->has_pid() ? fileManager_->GetFileEntity(fd) : nullptr;
+        if (entity != nullptr) {
+            entity->SetOwnerPid(request->pid());
+        }
         response->set_retcode(RetCode::kOK);
         response->set_fd(fd);
         LOG(INFO) << "Open file success. "
@@ -147,6 +188,22 @@ void NebdFileServiceImpl::Write(
     brpc::ClosureGuard doneGuard(done);
     response->set_retcode(RetCode::kNoOK);
 
+    ShmRegionPtr shmRegion;
+    char* shmAddr = nullptr;
+    if (request->has_shmbuf()) {
+        shmAddr = GetShmAddress(request->fd(), request->shmbuf(),
+                                request->size(), &shmRegion);
+        if (shmAddr == nullptr) {
+            LOG(ERROR) << "Get write data from shm failed. "
+                       << "fd: " << request->fd()
+                       << ", offset: " << request->offset()
+                       << ", size: " << request->size();
+            // 数据还没有写入，让part1重试
+            cntl_base->SetFailed(EAGAIN, "get write data from shm failed");
+            return;
+        }
+    }
+
     NebdServerAioContext* aioContext
         = new (std::nothrow) NebdServerAioContext();
     aioContext->offset = request->offset();
@@ -158,7 +215,14 @@ void NebdFileServiceImpl::Write(
     brpc::Controller* cntl = dynamic_cast<brpc::Controller *>(cntl_base);
 
     std::unique_ptr<butil::IOBuf> buf(new butil::IOBuf());
-    *buf = cntl->request_attachment();
+    if (shmAddr != nullptr) {
+        // part1在请求返回之后才会释放共享内存中的数据缓冲区
+        buf->append_user_data(shmAddr, request->size(), EmptyDeleter);
+        aioContext->shmAddr = shmAddr;
+        aioContext->shmRegion = std::move(shmRegion);
+    } else {
+        *buf = cntl->request_attachment();
+    }
 
     size_t copySize = buf->size();
     if (copySize != aioContext->size) {
@@ -195,11 +259,28 @@ void NebdFileServiceImpl::Read(
     brpc::ClosureGuard doneGuard(done);
     response->set_retcode(RetCode::kNoOK);
 
+    ShmRegionPtr shmRegion;
+    char* shmAddr = nullptr;
+    if (request->has_shmbuf()) {
+        shmAddr = GetShmAddress(request->fd(), request->shmbuf(),
+                                request->size(), &shmRegion);
+        if (shmAddr == nullptr) {
+            LOG(ERROR) << "Get read buffer from shm failed. "
+                       << "fd: " << request->fd()
+                       << ", offset: " << request->offset()
+                       << ", size: " << request->size();
+            cntl_base->SetFailed(EAGAIN, "get read buffer from shm failed");
+            return;
+        }
+    }
+
     NebdServerAioContext* aioContext
         = new (std::nothrow) NebdServerAioContext();
     aioContext->offset = request->offset();
     aioContext->size = request->size();
     aioContext->op = LIBAIO_OP::LIBAIO_OP_READ;
+    aioContext->shmAddr = shmAddr;
+    aioContext->shmRegion = std::move(shmRegion);
     aioContext->cb = NebdFileServiceCallback;
     aioContext->returnRpcWhenIoError = returnRpcWhenIoError_;
 
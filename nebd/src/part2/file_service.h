@@ -30,6 +30,7 @@
 #include <memory>
 
 #include "nebd/proto/client.pb.h"
+#include "nebd/src/common/shm_buffer.h"
 #include "nebd/src/part2/file_manager.h"
 
 namespace nebd {
@@ -91,6 +92,20 @@ class NebdFileServiceImpl : public nebd::client::NebdFileService {
                             nebd::client::InvalidateCacheResponse* response,
                             google::protobuf::Closure* done);
 
+ private:
+    /**
+     * @brief 获取请求数据在part1共享内存中的地址，
+     *        只使用打开文件的part1进程自己的共享内存
+     *
+     * @param fd 请求的文件fd
+     * @param shmBuf 请求中携带的共享内存信息
+     * @param size 请求的数据长度
+     * @param[out] region 共享内存的映射，请求结束之前需要一直持有
+     * @return 成功返回数据地址，失败返回nullptr
+     */
+    char* GetShmAddress(int fd, const nebd::client::ShmBuffer& shmBuf,
+                        uint64_t size, nebd::common::ShmRegionPtr* region);
+
  private:
     std::shared_ptr<NebdFileManager> fileManager_;
     const bool returnRpcWhenIoError_;
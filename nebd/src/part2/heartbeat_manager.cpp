@@ -23,6 +23,7 @@
 #include <unordered_map>
 #include <string>
 
+#include "nebd/src/common/shm_buffer.h"
 #include "nebd/src/common/timeutility.h"
 #include "nebd/src/part2/heartbeat_manager.h"
 
@@ -53,13 +54,15 @@ int HeartbeatManager::Fini() {
     return 0;
 }
 
-bool HeartbeatManager::UpdateFileTimestamp(int fd, uint64_t timestamp) {
+bool HeartbeatManager::UpdateFileTimestamp(int fd, uint64_t timestamp,
+                                           int pid) {
     NebdFileEntityPtr entity = fileManager_->GetFileEntity(fd);
     if (entity == nullptr) {
         LOG(ERROR) << "File not exist, fd: " << fd;
         return false;
     }
     entity->UpdateFileTimeStamp(timestamp);
+    entity->SetOwnerPidIfUnknown(pid);
     return true;
 }
 
@@ -131,6 +134,8 @@ void HeartbeatManager::RemoveTimeoutNebdClient() {
         if (interval > (uint64_t)1000 * heartbeatTimeoutS_) {
             LOG(INFO) << "Delete nebd client info which has timed out. "
                       << "client info: " << iter->second;
+            // part1已经退出，不再需要它的共享内存
+            nebd::common::ShmRegionCache::GetInstance().Remove(iter->first);
             iter = nebdClients_.erase(iter);
             nebdClientNum_ << -1;
         } else {
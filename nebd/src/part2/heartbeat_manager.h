@@ -91,7 +91,8 @@ class HeartbeatManager {
     virtual int Fini();
     // part2收到心跳后，会通过该接口更新心跳中包含的文件在内存中记录的时间戳
     // 心跳检测线程会根据该时间戳判断是否需要关闭文件
-    virtual bool UpdateFileTimestamp(int fd, uint64_t timestamp);
+    // part2重启之后文件不知道是哪个part1打开的，根据心跳中的pid记录
+    virtual bool UpdateFileTimestamp(int fd, uint64_t timestamp, int pid);
     // part2收到心跳后，会通过该接口更新part1的时间戳
     virtual void UpdateNebdClientInfo(int pid, const std::string& version,
                                       uint64_t timestamp);
@@ -42,7 +42,8 @@ void NebdHeartbeatServiceImpl::KeepAlive(
                                             request->nebdversion(), curTime);
     for (int i = 0; i < request->info_size(); ++i) {
         const auto& info = request->info(i);
-        bool res = heartbeatManager_->UpdateFileTimestamp(info.fd(), curTime);
+        bool res = heartbeatManager_->UpdateFileTimestamp(
+            info.fd(), curTime, request->pid());
         if (!res) {
             LOG(WARNING) << "Update file timestamp fail, fd: "
                          << info.fd() << ", name: " << info.name();
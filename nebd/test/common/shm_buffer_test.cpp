@@ -0,0 +1,247 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: nebd
+ * Created Date: 2023-04-05
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <chrono>  // NOLINT
+#include <cstring>
+#include <string>
+#include <thread>  // NOLINT
+
+#include "nebd/src/common/shm_buffer.h"
+
+namespace nebd {
+namespace common {
+
+TEST(ShmBufferTest, RegionName) {
+    ASSERT_EQ("nebd-1234-5", ShmRegionName(1234, 5));
+    pid_t pid = 0;
+    ASSERT_TRUE(IsValidShmRegionName("nebd-1234-5", &pid));
+    ASSERT_EQ(1234, pid);
+    ASSERT_FALSE(IsValidShmRegionName("nebd-1234"));
+    ASSERT_FALSE(IsValidShmRegionName("nebd-1234-"));
+    ASSERT_FALSE(IsValidShmRegionName("nebd--5"));
+    ASSERT_FALSE(IsValidShmRegionName("nebd-"));
+    ASSERT_FALSE(IsValidShmRegionName("nebd-../1234-5"));
+    ASSERT_FALSE(IsValidShmRegionName("nebd-1234-5/.."));
+    ASSERT_FALSE(IsValidShmRegionName("nebd-99999999999-5"));
+    ASSERT_FALSE(IsValidShmRegionName("curve-1234-5"));
+}
+
+TEST(ShmBufferTest, AllocateAndFree) {
+    ShmBufferPool pool;
+    ShmBuffer buf;
+    // 未初始化不能分配
+    ASSERT_FALSE(pool.Allocate(kShmPageSize, &buf));
+
+    ASSERT_EQ(0, pool.Init(getpid(), 4 * kShmPageSize));
+
+    ShmBuffer buf1, buf2, buf3;
+    ASSERT_TRUE(pool.Allocate(1, &buf1));
+    ASSERT_EQ(0, buf1.offset);
+    ASSERT_EQ(1, buf1.length);
+    ASSERT_TRUE(pool.Allocate(2 * kShmPageSize, &buf2));
+    ASSERT_EQ(kShmPageSize, buf2.offset);
+    ASSERT_EQ(buf1.addr + kShmPageSize, buf2.addr);
+
+    // 空间不足
+    ASSERT_FALSE(pool.Allocate(2 * kShmPageSize, &buf3));
+    ASSERT_FALSE(pool.Allocate(5 * kShmPageSize, &buf3));
+
+    ASSERT_TRUE(pool.Allocate(kShmPageSize, &buf3));
+    ASSERT_EQ(3 * kShmPageSize, buf3.offset);
+
+    // 释放之后从头开始查找
+    pool.Free(buf1);
+    pool.Free(buf2);
+    ASSERT_TRUE(pool.Allocate(3 * kShmPageSize, &buf1));
+    ASSERT_EQ(0, buf1.offset);
+
+    pool.Fini();
+    ASSERT_FALSE(pool.Allocate(kShmPageSize, &buf));
+}
+
+TEST(ShmBufferTest, MapByName) {
+    auto& cache = ShmRegionCache::GetInstance();
+    ASSERT_EQ(nullptr, cache.Get("../etc/passwd", getpid(), 0));
+    ASSERT_EQ(nullptr, cache.Get(ShmRegionName(getpid(), 1), getpid(), 0));
+
+    ShmBufferPool pool;
+    ASSERT_EQ(-1, pool.Fd());
+    ASSERT_EQ(0, pool.Init(getpid(), 4 * kShmPageSize));
+    const std::string name = pool.Name();
+    pid_t pid = 0;
+    ASSERT_TRUE(IsValidShmRegionName(name, &pid));
+    ASSERT_EQ(getpid(), pid);
+    ShmBuffer buf;
+    ASSERT_TRUE(pool.Allocate(kShmPageSize, &buf));
+    ASSERT_TRUE(pool.Allocate(kShmPageSize, &buf));
+    memset(buf.addr, 'a', buf.length);
+
+    ShmRegionPtr region = cache.Get(name, getpid(), pool.Fd());
+    ASSERT_NE(nullptr, region);
+    ASSERT_EQ(region, cache.Get(name, getpid(), pool.Fd()));
+    ASSERT_EQ(nullptr, region->GetAddress(3 * kShmPageSize,
+                                          2 * kShmPageSize));
+
+    // 同一块共享内存的两个映射看到的数据相同
+    char* addr = region->GetAddress(buf.offset, buf.length);
+    ASSERT_NE(nullptr, addr);
+    ASSERT_EQ(std::string(buf.length, 'a'), std::string(addr, buf.length));
+    memset(addr, 'b', buf.length);
+    ASSERT_EQ(std::string(buf.length, 'b'),
+              std::string(buf.addr, buf.length));
+
+    // 删除之后已经获取的映射仍然可用
+    cache.Remove(getpid());
+    ASSERT_EQ('b', addr[0]);
+    region.reset();
+
+    const int memfd = pool.Fd();
+    pool.Free(buf);
+    pool.Fini();
+    ASSERT_EQ(-1, pool.Fd());
+    ASSERT_EQ(nullptr, cache.Get(name, getpid(), memfd));
+}
+
+TEST(ShmBufferTest, ReInit) {
+    auto& cache = ShmRegionCache::GetInstance();
+    ShmBufferPool pool;
+    ASSERT_EQ(0, pool.Init(getpid(), kShmPageSize));
+    const std::string name1 = pool.Name();
+    ShmBuffer buf;
+    ASSERT_TRUE(pool.Allocate(kShmPageSize, &buf));
+    memset(buf.addr, 'a', buf.length);
+    const int memfd1 = pool.Fd();
+    ShmRegionPtr region1 = cache.Get(name1, getpid(), memfd1);
+    ASSERT_NE(nullptr, region1);
+    pool.Free(buf);
+    pool.Fini();
+
+    // 重新初始化之后part2映射新的共享内存，不会读到旧的数据
+    ASSERT_EQ(0, pool.Init(getpid(), kShmPageSize));
+    const std::string name2 = pool.Name();
+    ASSERT_NE(name1, name2);
+    ASSERT_TRUE(pool.Allocate(kShmPageSize, &buf));
+    memset(buf.addr, 'b', buf.length);
+    ShmRegionPtr region2 = cache.Get(name2, getpid(), pool.Fd());
+    ASSERT_NE(nullptr, region2);
+    ASSERT_NE(region1, region2);
+    ASSERT_EQ('b', region2->GetAddress(buf.offset, buf.length)[0]);
+    ASSERT_EQ(region2, cache.Get(name2, getpid(), pool.Fd()));
+
+    // 旧的共享内存已经关闭
+    ASSERT_EQ(nullptr, cache.Get(name1, getpid(), memfd1));
+    ASSERT_EQ(region2, cache.Get(name2, getpid(), pool.Fd()));
+
+    pool.Free(buf);
+    pool.Fini();
+    cache.Remove(getpid());
+}
+
+TEST(ShmBufferTest, OnlyMapOwnerShm) {
+    auto& cache = ShmRegionCache::GetInstance();
+    ShmBufferPool pool;
+    ASSERT_EQ(0, pool.Init(getpid(), 2 * kShmPageSize));
+    const std::string name = pool.Name();
+
+    // 共享内存的大小不能再修改，part2访问时不会收到SIGBUS
+    ASSERT_NE(0, ftruncate(pool.Fd(), kShmPageSize));
+    ASSERT_NE(0, ftruncate(pool.Fd(), 4 * kShmPageSize));
+
+    // 名字中的pid不是打开文件的进程
+    ASSERT_EQ(nullptr, cache.Get(name, getpid() + 1, pool.Fd()));
+    ASSERT_EQ(nullptr, cache.Get(ShmRegionName(getpid() + 1, 1),
+                                 getpid() + 1, pool.Fd()));
+
+    // fd不是名字对应的共享内存
+    ASSERT_EQ(nullptr, cache.Get(name, getpid(), STDIN_FILENO));
+    ASSERT_EQ(nullptr, cache.Get(name + "1", getpid(), pool.Fd()));
+
+    // 可以缩小的共享内存不能映射
+    const std::string unsealedName = ShmRegionName(getpid(), 1);
+    int unsealed = syscall(SYS_memfd_create, unsealedName.c_str(), 0);
+    ASSERT_GE(unsealed, 0);
+    ASSERT_EQ(0, ftruncate(unsealed, kShmPageSize));
+    ASSERT_EQ(nullptr, cache.Get(unsealedName, getpid(), unsealed));
+    close(unsealed);
+
+    ASSERT_NE(nullptr, cache.Get(name, getpid(), pool.Fd()));
+    pool.Fini();
+    cache.Remove(getpid());
+}
+
+TEST(ShmBufferTest, Quarantine) {
+    ShmBufferPool pool;
+    ASSERT_EQ(0, pool.Init(getpid(), 4 * kShmPageSize));
+    const std::string name = pool.Name();
+
+    // 隔离的缓冲区不会再分配出去
+    ShmBuffer buf1, buf2, buf3;
+    ASSERT_TRUE(pool.Allocate(kShmPageSize, &buf1));
+    ASSERT_TRUE(pool.Allocate(kShmPageSize, &buf2));
+    pool.Quarantine(buf1);
+    ASSERT_FALSE(pool.WaitAllFree(0));
+    ASSERT_TRUE(pool.Allocate(2 * kShmPageSize, &buf3));
+    ASSERT_EQ(2 * kShmPageSize, buf3.offset);
+    pool.Free(buf3);
+    ASSERT_FALSE(pool.Allocate(3 * kShmPageSize, &buf3));
+    ASSERT_EQ(name, pool.Name());
+
+    // 隔离的页超过一半，没有在用的缓冲区之后重新创建共享内存
+    memset(buf2.addr, 'a', buf2.length);
+    pool.Quarantine(buf2);
+    ASSERT_TRUE(pool.WaitAllFree(0));
+    ASSERT_NE(name, pool.Name());
+    ASSERT_TRUE(pool.Allocate(4 * kShmPageSize, &buf1));
+    ASSERT_EQ(0, buf1.addr[kShmPageSize]);
+
+    pool.Free(buf1);
+    pool.Fini();
+}
+
+TEST(ShmBufferTest, WaitAllFree) {
+    ShmBufferPool pool;
+    ASSERT_EQ(0, pool.Init(getpid(), 2 * kShmPageSize));
+    ShmBuffer buf;
+    ASSERT_TRUE(pool.Allocate(kShmPageSize, &buf));
+    ASSERT_FALSE(pool.WaitAllFree(10));
+
+    std::thread t([&pool, buf]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        pool.Free(buf);
+    });
+    ASSERT_TRUE(pool.WaitAllFree(10000));
+    t.join();
+
+    // 还有缓冲区没有释放时Fini保留映射
+    ASSERT_TRUE(pool.Allocate(kShmPageSize, &buf));
+    memset(buf.addr, 'a', buf.length);
+    pool.Fini();
+    ASSERT_EQ('a', buf.addr[0]);
+    pool.Free(buf);
+}
+
+}  // namespace common
+}  // namespace nebd
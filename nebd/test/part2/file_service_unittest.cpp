@@ -24,6 +24,7 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <brpc/controller.h>
+#include <unistd.h>
 #include <memory>
 
 #include "nebd/src/part2/file_service.h"
@@ -157,6 +158,70 @@ TEST_F(FileServiceTest, WriteTest) {
     ASSERT_TRUE(done.IsRunned());
 }
 
+TEST_F(FileServiceTest, WriteByShmTest) {
+    int fd = 1;
+    const uint64_t kSize = 4096;
+    nebd::common::ShmBufferPool pool;
+    ASSERT_EQ(0, pool.Init(getpid(), kSize));
+    nebd::common::ShmBuffer shmBuf;
+    ASSERT_TRUE(pool.Allocate(kSize, &shmBuf));
+    memset(shmBuf.addr, 'a', kSize);
+
+    auto entity = std::make_shared<NebdFileEntity>();
+    EXPECT_CALL(*fileManager_, GetFileEntity(fd))
+    .WillRepeatedly(Return(entity));
+
+    // open时记录打开文件的进程
+    brpc::Controller openCntl;
+    nebd::client::OpenFileRequest openRequest;
+    openRequest.set_filename(testFile1);
+    openRequest.set_pid(getpid() + 1);
+    nebd::client::OpenFileResponse openResponse;
+    FileServiceTestClosure done;
+    EXPECT_CALL(*fileManager_, Open(testFile1, _))
+    .WillOnce(Return(fd));
+    fileService_->OpenFile(&openCntl, &openRequest, &openResponse, &done);
+    ASSERT_EQ(openResponse.retcode(), RetCode::kOK);
+    ASSERT_EQ(getpid() + 1, entity->GetOwnerPid());
+
+    nebd::client::WriteRequest request;
+    request.set_fd(fd);
+    request.set_offset(0);
+    request.set_size(kSize);
+    request.mutable_shmbuf()->set_name(pool.Name());
+    request.mutable_shmbuf()->set_offset(shmBuf.offset);
+    request.mutable_shmbuf()->set_memfd(pool.Fd());
+    nebd::client::WriteResponse response;
+
+    // 不能使用其他进程的共享内存，让part1重试
+    brpc::Controller cntl;
+    done.Reset();
+    EXPECT_CALL(*fileManager_, AioWrite(_, _))
+    .Times(0);
+    fileService_->Write(&cntl, &request, &response, &done);
+    ASSERT_TRUE(cntl.Failed());
+    ASSERT_TRUE(done.IsRunned());
+
+    // 使用打开文件的进程自己的共享内存
+    entity->SetOwnerPid(getpid());
+    cntl.Reset();
+    done.Reset();
+    NebdServerAioContext* aioCtx;
+    EXPECT_CALL(*fileManager_, AioWrite(fd, NotNull()))
+    .WillOnce(DoAll(SaveArg<1>(&aioCtx), Return(0)));
+    fileService_->Write(&cntl, &request, &response, &done);
+    ASSERT_FALSE(cntl.Failed());
+    ASSERT_FALSE(done.IsRunned());
+    ASSERT_EQ(std::string(kSize, 'a'),
+              reinterpret_cast<butil::IOBuf*>(aioCtx->buf)->to_string());
+    delete reinterpret_cast<butil::IOBuf*>(aioCtx->buf);
+    delete aioCtx;
+
+    pool.Free(shmBuf);
+    pool.Fini();
+    nebd::common::ShmRegionCache::GetInstance().Remove(getpid());
+}
+
 TEST_F(FileServiceTest, ReadTest) {
     int fd = 1;
     uint64_t offset = 0;
@@ -112,11 +112,21 @@ TEST_F(HeartbeatManagerTest, UpdateTimeStampTest) {
     .WillOnce(Return(entity));
     EXPECT_CALL(*entity, UpdateFileTimeStamp(100))
     .Times(1);
-    ASSERT_TRUE(heartbeatManager_->UpdateFileTimestamp(1, 100));
+    ASSERT_TRUE(heartbeatManager_->UpdateFileTimestamp(1, 100, 12345));
+    // part2重启之后通过心跳记录打开文件的进程
+    ASSERT_EQ(12345, entity->GetOwnerPid());
+
+    // 已经知道打开文件的进程时不会被其他进程的心跳修改
+    EXPECT_CALL(*fileManager_, GetFileEntity(1))
+    .WillOnce(Return(entity));
+    EXPECT_CALL(*entity, UpdateFileTimeStamp(200))
+    .Times(1);
+    ASSERT_TRUE(heartbeatManager_->UpdateFileTimestamp(1, 200, 54321));
+    ASSERT_EQ(12345, entity->GetOwnerPid());
 
     EXPECT_CALL(*fileManager_, GetFileEntity(1))
     .WillOnce(Return(nullptr));
-    ASSERT_FALSE(heartbeatManager_->UpdateFileTimestamp(1, 100));
+    ASSERT_FALSE(heartbeatManager_->UpdateFileTimestamp(1, 100, 12345));
 }
 
 TEST_F(HeartbeatManagerTest, UpdateNebdClientInfo) {
@@ -69,7 +69,7 @@ TEST_F(HeartbeatServiceTest, KeepAlive) {
     brpc::Controller cntl;
 
     // 正常情况
-    EXPECT_CALL(*heartbeatManager_, UpdateFileTimestamp(_, _))
+    EXPECT_CALL(*heartbeatManager_, UpdateFileTimestamp(_, _, 12345))
         .Times(3)
         .WillRepeatedly(Return(true));
     stub.KeepAlive(&cntl, &request, &response, nullptr);
@@ -77,7 +77,7 @@ TEST_F(HeartbeatServiceTest, KeepAlive) {
     ASSERT_EQ(nebd::client::RetCode::kOK, response.retcode());
 
     // 有文件更新时间戳失败
-    EXPECT_CALL(*heartbeatManager_, UpdateFileTimestamp(_, _))
+    EXPECT_CALL(*heartbeatManager_, UpdateFileTimestamp(_, _, 12345))
         .Times(3)
         .WillOnce(Return(false))
         .WillRepeatedly(Return(true));
@@ -241,7 +241,7 @@ ReadChunkRequest::ReadChunkRequest(std::shared_ptr<CopysetNode> nodePtr,
 void ReadChunkRequest::Process() {
     brpc::ClosureGuard doneGuard(done_);
 
-    if (!node_->IsLeaderTerm()) {
+    if (!node_->IsLeaderTerm() && !CanReadOnFollower()) {
         RedirectChunkRequest();
         return;
     }
@@ -326,6 +326,11 @@ void ReadChunkRequest::OnApply(uint64_t index,
         }
         // 如果需要从源端拷贝数据，需要将请求转发给clone manager处理
         if ( needLazyClone || NeedClone(chunkInfo) ) {
+            // clone 需要写入数据，follower 无法处理，让 client 去读 leader
+            if (!node_->IsLeaderTerm()) {
+                RedirectChunkRequest();
+                break;
+            }
             applyIndex = index;
             std::shared_ptr<CloneTask> cloneTask =
             cloneMgr_->GenerateCloneTask(
@@ -371,6 +376,19 @@ void ReadChunkRequest::OnApplyFromLog(std::shared_ptr<CSDataStore> datastore,
     // read什么都不用做
 }
 
+bool ReadChunkRequest::CanReadOnFollower() const {
+    /**
+     * follower 的 applied index 不小于 client 已知的 applied index 时，
+     * client 之前写入的数据一定已经在 follower 上 apply 了，读请求同样进入
+     * 并发层排队，与 leader 上的 applied index read 保证相同的语义
+     */
+    return request_->followerread()
+        && request_->optype() == CHUNK_OP_TYPE::CHUNK_OP_READ
+        && request_->has_appliedindex()
+        && !existCloneInfo(request_)
+        && node_->GetAppliedIndex() >= request_->appliedindex();
+}
+
 bool ReadChunkRequest::NeedClone(const CSChunkInfo& chunkInfo) {
     // 如果不是 clone chunk，就不需要拷贝
     if (chunkInfo.isClone) {
@@ -232,6 +232,10 @@ class ReadChunkRequest : public ChunkOpRequest {
  private:
     // 根据chunk信息判断是否需要拷贝数据
     bool NeedClone(const CSChunkInfo& chunkInfo);
+
+    // 是否可以在 follower 上直接处理该读请求
+    bool CanReadOnFollower() const;
+
     // 从chunk文件中读数据
     void ReadChunk();
 
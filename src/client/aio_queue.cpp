@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-04-05
+ * Author: curve
+ */
+
+#include "src/client/aio_queue.h"
+
+#include <glog/logging.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+namespace curve {
+namespace client {
+
+// 每个请求对应的CurveAioContext，请求完成之后释放
+struct AioQueue::Entry : public CurveAioContext {
+    AioQueue* queue;
+    CurveAioQueueRequest* req;
+};
+
+AioQueue::AioQueue(uint32_t depth, SubmitFunc submit)
+    : depth_(depth),
+      submit_(std::move(submit)),
+      eventFd_(-1),
+      size_(0),
+      completions_(depth, nullptr),
+      head_(0),
+      count_(0) {}
+
+AioQueue::~AioQueue() {
+    if (eventFd_ >= 0) {
+        ::close(eventFd_);
+    }
+}
+
+int AioQueue::Init() {
+    if (depth_ == 0) {
+        LOG(ERROR) << "aio queue depth is 0";
+        return -1;
+    }
+
+    eventFd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (eventFd_ < 0) {
+        LOG(ERROR) << "create eventfd failed, error: " << strerror(errno);
+        return -1;
+    }
+
+    return 0;
+}
+
+int AioQueue::Submit(int fd, CurveAioQueueRequest** reqs, int nr) {
+    int submitted = 0;
+    for (; submitted < nr; ++submitted) {
+        uint32_t size = size_.fetch_add(1, std::memory_order_acq_rel);
+        if (size >= depth_) {
+            size_.fetch_sub(1, std::memory_order_acq_rel);
+            break;
+        }
+
+        CurveAioQueueRequest* req = reqs[submitted];
+        req->ret = 0;
+
+        // 长度为0的读写请求不会回调，直接完成
+        if (req->length == 0 && req->op != LIBCURVE_OP_DISCARD) {
+            Complete(req);
+            continue;
+        }
+
+        Entry* entry = new Entry();
+        entry->offset = req->offset;
+        entry->length = req->length;
+        entry->ret = 0;
+        entry->op = req->op;
+        entry->cb = OnRequestDone;
+        entry->buf = req->buf;
+        entry->queue = this;
+        entry->req = req;
+
+        int ret = submit_(fd, entry, req->vectored != 0
+                                         ? UserDataType::IOVector
+                                         : UserDataType::RawBuffer);
+        if (ret != LIBCURVE_ERROR::OK) {
+            delete entry;
+            size_.fetch_sub(1, std::memory_order_acq_rel);
+            return submitted == 0 ? ret : submitted;
+        }
+    }
+
+    return submitted;
+}
+
+int AioQueue::Poll(CurveAioQueueRequest** reqs, int max) {
+    int polled = 0;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        while (polled < max && count_ > 0) {
+            reqs[polled++] = completions_[head_];
+            head_ = (head_ + 1) % depth_;
+            --count_;
+        }
+    }
+
+    if (polled > 0) {
+        size_.fetch_sub(polled, std::memory_order_acq_rel);
+    }
+
+    return polled;
+}
+
+void AioQueue::OnRequestDone(CurveAioContext* ctx) {
+    Entry* entry = static_cast<Entry*>(ctx);
+    AioQueue* queue = entry->queue;
+    CurveAioQueueRequest* req = entry->req;
+    req->ret = entry->ret;
+    delete entry;
+
+    queue->Complete(req);
+}
+
+void AioQueue::Complete(CurveAioQueueRequest* req) {
+    bool notify = false;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        completions_[(head_ + count_) % depth_] = req;
+        notify = (count_++ == 0);
+    }
+
+    // 只在完成队列从空变为非空时通知，用户线程被唤醒之后会一直取到队列为空
+    if (notify) {
+        uint64_t one = 1;
+        ssize_t ret = ::write(eventFd_, &one, sizeof(one));
+        LOG_IF(ERROR, ret != sizeof(one))
+            << "write eventfd failed, error: " << strerror(errno);
+    }
+}
+
+}   // namespace client
+}   // namespace curve
@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-04-05
+ * Author: curve
+ */
+
+#ifndef SRC_CLIENT_AIO_QUEUE_H_
+#define SRC_CLIENT_AIO_QUEUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>  // NOLINT
+#include <vector>
+
+#include "include/client/libcurve.h"
+
+namespace curve {
+namespace client {
+
+/**
+ * 异步请求队列，请求完成之后不在brpc/bthread线程中回调用户，
+ * 而是放入完成队列，由用户线程通过Poll批量取回
+ *  - 队列中的请求数（包括已经完成但还没有被取回的）不超过depth，
+ *    所以完成队列不会溢出
+ *  - 完成队列从空变为非空时写一次eventfd，用户可以用epoll等待，
+ *    也可以忽略eventfd直接轮询
+ */
+class AioQueue {
+ public:
+    // 下发一个异步请求，返回值与FileClient::AioRead/AioWrite相同
+    using SubmitFunc = std::function<int(int fd, CurveAioContext* ctx,
+                                         UserDataType dataType)>;
+
+    AioQueue(uint32_t depth, SubmitFunc submit);
+
+    ~AioQueue();
+
+    /**
+     * 创建eventfd
+     * @return: 成功返回0，失败返回-1
+     */
+    int Init();
+
+    int EventFd() const {
+        return eventFd_;
+    }
+
+    /**
+     * 批量下发请求
+     * @param fd: 文件fd
+     * @param reqs: 请求数组，请求在被Poll取回之前需要保持有效
+     * @param nr: 请求个数
+     * @return: 下发成功的请求数，队列满或者某个请求下发失败时小于nr，
+     *          第一个请求就下发失败时返回它的错误码
+     */
+    int Submit(int fd, CurveAioQueueRequest** reqs, int nr);
+
+    /**
+     * 取回已经完成的请求，不会阻塞
+     * @param[out] reqs: 已经完成的请求
+     * @param max: 最多取回的请求数
+     * @return: 取回的请求数
+     */
+    int Poll(CurveAioQueueRequest** reqs, int max);
+
+    // 队列中的请求数，包括已经完成但还没有被取回的
+    uint32_t Size() const {
+        return size_.load(std::memory_order_acquire);
+    }
+
+ private:
+    struct Entry;
+
+    static void OnRequestDone(CurveAioContext* ctx);
+
+    void Complete(CurveAioQueueRequest* req);
+
+ private:
+    const uint32_t depth_;
+    SubmitFunc submit_;
+    int eventFd_;
+
+    std::atomic<uint32_t> size_;
+
+    std::mutex mtx_;
+    // 完成队列，容量为depth
+    std::vector<CurveAioQueueRequest*> completions_;
+    uint32_t head_;
+    uint32_t count_;
+};
+
+}   // namespace client
+}   // namespace curve
+
+#endif  // SRC_CLIENT_AIO_QUEUE_H_
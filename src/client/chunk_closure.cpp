@@ -82,6 +82,8 @@ void ClientClosure::PreProcessBeforeRetry(int rpcstatus, int cntlstatus) {
     }
 
     if (rpcstatus == CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD) {
+        metaCache_->GetChunkServerInflightControl().OnCongested(
+            chunkserverID_);
         uint64_t nextsleeptime = OverLoadBackOff(reqDone->GetRetriedTimes());
         LOG(WARNING) << "chunkserver overload, sleep(us) = " << nextsleeptime
                   << ", " << *reqCtx_
@@ -268,6 +270,8 @@ void ClientClosure::OnRpcFailed() {
     if (cntlstatus_ == brpc::ERPCTIMEDOUT) {
         // 如果RPC超时, 对应的chunkserver超时请求次数+1
         metaCache_->GetUnstableHelper().IncreTimeout(chunkserverID_);
+        metaCache_->GetChunkServerInflightControl().OnCongested(
+            chunkserverID_);
         MetricHelper::IncremTimeOutRPCCount(fileMetric_, reqCtx_->optype_);
     }
 
@@ -305,10 +309,14 @@ void ClientClosure::ProcessUnstableState() {
                 << "now set chunkserver(" << chunkserverID_ <<  ") unstable";
             metaCache_->SetChunkserverUnstable(chunkserverID_);
         }
+        metaCache_->GetChunkServerInflightControl().OnUnstable(
+            chunkserverID_);
         break;
     }
     case UnstableState::ChunkServerUnstable: {
         metaCache_->SetChunkserverUnstable(chunkserverID_);
+        metaCache_->GetChunkServerInflightControl().OnUnstable(
+            chunkserverID_);
         break;
     }
     case UnstableState::NoUnstable: {
@@ -327,6 +335,12 @@ void ClientClosure::OnSuccess() {
     MetricHelper::LatencyRecord(fileMetric_, duration, reqCtx_->optype_);
     MetricHelper::IncremRPCQPSCount(
         fileMetric_, reqCtx_->rawlength_, reqCtx_->optype_);
+
+    if (reqCtx_->optype_ == OpType::READ ||
+        reqCtx_->optype_ == OpType::WRITE) {
+        metaCache_->GetChunkServerInflightControl().OnResponse(
+            chunkserverID_, duration);
+    }
 }
 
 void ClientClosure::OnChunkNotExist() {
@@ -504,6 +518,25 @@ void WriteChunkClosure::OnSuccess() {
         response_->appliedindex());
 }
 
+void ReadChunkClosure::Run() {
+    if (hedgedReadState_ != nullptr) {
+        if (!cntl_->Failed()) {
+            ChunkServerReadLatency::GetInstance().Record(
+                chunkserverID_, cntl_->latency_us());
+        }
+
+        // hedged read已经结束了上层请求，done_可能已经被复用，不能再访问
+        if (!hedgedReadState_->TryFinish()) {
+            GetHedgedReadMetric().discardCount << 1;
+            delete cntl_;
+            delete this;
+            return;
+        }
+    }
+
+    ClientClosure::Run();
+}
+
 void ReadChunkClosure::SendRetryRequest() {
     client_->ReadChunk(reqCtx_->idinfo_, reqCtx_->seq_,
                        reqCtx_->offset_,
@@ -28,11 +28,13 @@
 #include <brpc/errno.pb.h>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "proto/chunk.pb.h"
 #include "src/client/client_config.h"
 #include "src/client/client_common.h"
 #include "src/client/client_metric.h"
+#include "src/client/hedged_read.h"
 #include "src/client/request_closure.h"
 #include "src/common/math_util.h"
 
@@ -249,9 +251,18 @@ class ReadChunkClosure : public ClientClosure {
     ReadChunkClosure(CopysetClient* client, Closure* done)
         : ClientClosure(client, done) {}
 
+    void Run() override;
     void OnSuccess() override;
     void OnChunkNotExist() override;
     void SendRetryRequest() override;
+
+    // 设置hedged read状态，与发给follower的hedged read竞争结束上层请求
+    void SetHedgedReadState(std::shared_ptr<HedgedReadState> state) {
+        hedgedReadState_ = std::move(state);
+    }
+
+ private:
+    std::shared_ptr<HedgedReadState> hedgedReadState_;
 };
 
 class ReadChunkSnapClosure : public ClientClosure {
@@ -0,0 +1,229 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-04-05
+ * Author: curve
+ */
+
+#include "src/client/chunkserver_inflight_control.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace curve {
+namespace client {
+
+struct ChunkServerInflightControl::Window {
+    uint32_t size;
+    uint32_t inflight = 0;
+
+    // 基准延迟，取各轮最小延迟中的最小值，并缓慢跟随最近一轮的最小延迟，
+    // 避免leader切换或者负载变化之后基准一直偏小，导致窗口只减不增
+    uint64_t baseLatencyUs = 0;
+
+    // 当前轮收到的回复数，以及其中的最小延迟
+    uint32_t roundResponses = 0;
+    uint64_t roundMinLatencyUs = UINT64_MAX;
+    // 当前轮是否已经减小过窗口
+    bool roundDecreased = false;
+
+    // 等待token的请求
+    std::deque<WakeupFunc> waiters;
+
+    bvar::Status<uint32_t> sizeMetric;
+
+    Window(const std::string& name, uint32_t initSize)
+        : size(initSize), sizeMetric("curve_client", name, initSize) {}
+};
+
+ChunkServerInflightControl::ChunkServerInflightControl() = default;
+
+ChunkServerInflightControl::~ChunkServerInflightControl() = default;
+
+void ChunkServerInflightControl::Init(const ChunkServerInflightOption& opt,
+                                      const std::string& filename) {
+    option_ = opt;
+    option_.minWindow = std::max(option_.minWindow, 1u);
+    option_.maxWindow = std::max(option_.maxWindow, option_.minWindow);
+    option_.initWindow = std::min(
+        std::max(option_.initWindow, option_.minWindow), option_.maxWindow);
+    filename_ = filename;
+
+    LOG(INFO) << "chunkserver inflight control init, enable = "
+              << option_.enable << ", init window = " << option_.initWindow
+              << ", min window = " << option_.minWindow
+              << ", max window = " << option_.maxWindow
+              << ", latency ratio = " << option_.latencyRatio
+              << ", decrease factor = " << option_.decreaseFactor;
+}
+
+bool ChunkServerInflightControl::GetToken(ChunkServerID csId,
+                                          WakeupFunc wakeup) {
+    std::lock_guard<bthread::Mutex> lk(mtx_);
+    Window* window = GetOrCreateWindow(csId);
+    // 有等待的请求时新请求排在后面，保证先来先得
+    if (window->waiters.empty() && window->inflight < window->size) {
+        ++window->inflight;
+        return true;
+    }
+
+    window->waiters.push_back(std::move(wakeup));
+    return false;
+}
+
+void ChunkServerInflightControl::ReleaseToken(ChunkServerID csId) {
+    std::vector<WakeupFunc> wakeups;
+    {
+        std::lock_guard<bthread::Mutex> lk(mtx_);
+        Window* window = GetOrCreateWindow(csId);
+        if (window->inflight == 0) {
+            LOG(ERROR) << "release token of chunkserver " << csId
+                       << " without inflight rpc";
+            return;
+        }
+        --window->inflight;
+        wakeups = GrantWaiters(window);
+    }
+
+    for (auto& wakeup : wakeups) {
+        wakeup();
+    }
+}
+
+void ChunkServerInflightControl::OnResponse(ChunkServerID csId,
+                                            uint64_t latencyUs) {
+    if (!option_.enable) {
+        return;
+    }
+
+    std::vector<WakeupFunc> wakeups;
+    {
+        std::lock_guard<bthread::Mutex> lk(mtx_);
+        Window* window = GetOrCreateWindow(csId);
+        window->roundMinLatencyUs =
+            std::min(window->roundMinLatencyUs, latencyUs);
+        if (++window->roundResponses < window->size) {
+            return;
+        }
+
+        // 一轮结束，用这一轮的最小延迟判断是否拥塞，避免个别慢请求的影响
+        const uint64_t roundMin = window->roundMinLatencyUs;
+        if (window->baseLatencyUs == 0 || roundMin < window->baseLatencyUs) {
+            window->baseLatencyUs = roundMin;
+        }
+
+        if (!window->roundDecreased) {
+            if (roundMin <= window->baseLatencyUs * option_.latencyRatio) {
+                SetWindow(window, window->size + 1);
+            } else {
+                DecreaseWindow(window);
+            }
+        }
+
+        window->baseLatencyUs += (roundMin - window->baseLatencyUs) / 8;
+        StartNewRound(window);
+        wakeups = GrantWaiters(window);
+    }
+
+    for (auto& wakeup : wakeups) {
+        wakeup();
+    }
+}
+
+void ChunkServerInflightControl::OnCongested(ChunkServerID csId) {
+    if (!option_.enable) {
+        return;
+    }
+
+    std::lock_guard<bthread::Mutex> lk(mtx_);
+    Window* window = GetOrCreateWindow(csId);
+    if (!window->roundDecreased) {
+        DecreaseWindow(window);
+        window->roundDecreased = true;
+    }
+}
+
+void ChunkServerInflightControl::OnUnstable(ChunkServerID csId) {
+    if (!option_.enable) {
+        return;
+    }
+
+    std::lock_guard<bthread::Mutex> lk(mtx_);
+    Window* window = GetOrCreateWindow(csId);
+    SetWindow(window, option_.minWindow);
+    window->roundDecreased = true;
+}
+
+uint32_t ChunkServerInflightControl::GetWindow(ChunkServerID csId) {
+    std::lock_guard<bthread::Mutex> lk(mtx_);
+    return GetOrCreateWindow(csId)->size;
+}
+
+uint32_t ChunkServerInflightControl::GetInflight(ChunkServerID csId) {
+    std::lock_guard<bthread::Mutex> lk(mtx_);
+    return GetOrCreateWindow(csId)->inflight;
+}
+
+ChunkServerInflightControl::Window*
+ChunkServerInflightControl::GetOrCreateWindow(ChunkServerID csId) {
+    auto iter = windows_.find(csId);
+    if (iter != windows_.end()) {
+        return iter->second.get();
+    }
+
+    std::unique_ptr<Window> window(new Window(
+        filename_ + "_chunkserver_" + std::to_string(csId) +
+            "_inflight_window",
+        option_.initWindow));
+    Window* ptr = window.get();
+    windows_.emplace(csId, std::move(window));
+    return ptr;
+}
+
+std::vector<ChunkServerInflightControl::WakeupFunc>
+ChunkServerInflightControl::GrantWaiters(Window* window) {
+    std::vector<WakeupFunc> wakeups;
+    while (!window->waiters.empty() && window->inflight < window->size) {
+        ++window->inflight;
+        wakeups.push_back(std::move(window->waiters.front()));
+        window->waiters.pop_front();
+    }
+    return wakeups;
+}
+
+void ChunkServerInflightControl::SetWindow(Window* window, uint32_t size) {
+    window->size =
+        std::min(std::max(size, option_.minWindow), option_.maxWindow);
+    window->sizeMetric.set_value(window->size);
+}
+
+void ChunkServerInflightControl::DecreaseWindow(Window* window) {
+    SetWindow(window,
+              static_cast<uint32_t>(window->size * option_.decreaseFactor));
+}
+
+void ChunkServerInflightControl::StartNewRound(Window* window) {
+    window->roundResponses = 0;
+    window->roundMinLatencyUs = UINT64_MAX;
+    window->roundDecreased = false;
+}
+
+}  // namespace client
+}  // namespace curve
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-04-05
+ * Author: curve
+ */
+
+#ifndef SRC_CLIENT_CHUNKSERVER_INFLIGHT_CONTROL_H_
+#define SRC_CLIENT_CHUNKSERVER_INFLIGHT_CONTROL_H_
+
+#include <bthread/mutex.h>
+#include <bvar/bvar.h>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/client/client_common.h"
+#include "src/client/config_info.h"
+
+namespace curve {
+namespace client {
+
+// 文件级别的inflight rpc限制是所有chunkserver共享的，一个慢的chunkserver
+// 就能占满整个窗口，导致发往其他chunkserver的请求也无法下发。
+// 这里给每个chunkserver单独维护一个根据rpc延迟调整的窗口，
+// 窗口已满时请求不阻塞调度线程，而是挂在对应chunkserver上，
+// 等有rpc返回时再把token交给它并重新调度
+class ChunkServerInflightControl {
+ public:
+    // 等待的请求拿到token之后的回调
+    using WakeupFunc = std::function<void()>;
+
+    ChunkServerInflightControl();
+    ~ChunkServerInflightControl();
+
+    ChunkServerInflightControl(const ChunkServerInflightControl&) = delete;
+    ChunkServerInflightControl& operator=(const ChunkServerInflightControl&) =
+        delete;
+
+    /**
+     * @param opt: 窗口配置
+     * @param filename: 文件名，用于区分不同文件的窗口大小metric
+     */
+    void Init(const ChunkServerInflightOption& opt,
+              const std::string& filename);
+
+    bool Enabled() const {
+        return option_.enable;
+    }
+
+    /**
+     * 获取发往chunkserver的inflight token
+     * @param csId: chunkserver id
+     * @param wakeup: 窗口已满时保存下来，等分配到token之后调用
+     * @return: true 立即获取成功 / false 窗口已满，之后通过wakeup通知
+     */
+    bool GetToken(ChunkServerID csId, WakeupFunc wakeup);
+
+    /**
+     * 释放token，如果有等待的请求并且窗口有空余，把token交给等待的请求
+     */
+    void ReleaseToken(ChunkServerID csId);
+
+    /**
+     * rpc正常返回，根据延迟调整窗口
+     */
+    void OnResponse(ChunkServerID csId, uint64_t latencyUs);
+
+    /**
+     * rpc超时或者chunkserver overload，乘性减小窗口，每轮最多减小一次
+     */
+    void OnCongested(ChunkServerID csId);
+
+    /**
+     * chunkserver被判定为unstable，窗口直接减到最小
+     */
+    void OnUnstable(ChunkServerID csId);
+
+    /**
+     * 测试使用，获取chunkserver当前的窗口大小和inflight数量
+     */
+    uint32_t GetWindow(ChunkServerID csId);
+    uint32_t GetInflight(ChunkServerID csId);
+
+ private:
+    struct Window;
+
+    Window* GetOrCreateWindow(ChunkServerID csId);
+
+    // 窗口有空余时把token分给等待的请求，返回需要唤醒的请求
+    std::vector<WakeupFunc> GrantWaiters(Window* window);
+
+    void SetWindow(Window* window, uint32_t size);
+
+    void DecreaseWindow(Window* window);
+
+    void StartNewRound(Window* window);
+
+ private:
+    ChunkServerInflightOption option_;
+    std::string filename_;
+
+    bthread::Mutex mtx_;
+    std::unordered_map<ChunkServerID, std::unique_ptr<Window>> windows_;
+};
+
+}  // namespace client
+}  // namespace curve
+
+#endif  // SRC_CLIENT_CHUNKSERVER_INFLIGHT_CONTROL_H_
@@ -24,6 +24,7 @@
 #define SRC_CLIENT_CLIENT_COMMON_H_
 
 #include <butil/endpoint.h>
+#include <butil/iobuf.h>
 #include <butil/status.h>
 #include <google/protobuf/stubs/callback.h>
 
@@ -308,6 +309,35 @@ class ClientDummyServerInfo {
 
 inline void TrivialDeleter(void*) {}
 
+/**
+ * 将用户iovec引用到IOBuf中，不拷贝数据
+ * @return: iovec的总长度
+ */
+inline size_t AppendIOVector(const CurveIOVector* vec, butil::IOBuf* buf) {
+    size_t total = 0;
+    for (int i = 0; i < vec->iovcnt; ++i) {
+        if (vec->iov[i].iov_len == 0) {
+            continue;
+        }
+        buf->append_user_data(vec->iov[i].iov_base, vec->iov[i].iov_len,
+                              TrivialDeleter);
+        total += vec->iov[i].iov_len;
+    }
+    return total;
+}
+
+/**
+ * 将IOBuf中的数据依次拷贝到用户iovec中
+ * @return: 拷贝的总长度
+ */
+inline size_t CutToIOVector(butil::IOBuf* buf, const CurveIOVector* vec) {
+    size_t total = 0;
+    for (int i = 0; i < vec->iovcnt && !buf->empty(); ++i) {
+        total += buf->cutn(vec->iov[i].iov_base, vec->iov[i].iov_len);
+    }
+    return total;
+}
+
 inline const char *FileStatusToName(FileStatus status) {
     switch (status) {
     case FileStatus::Created:
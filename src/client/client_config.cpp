@@ -75,6 +75,32 @@ int ClientConfig::Init(const std::string& configpath) {
     LOG_IF(ERROR, ret == false) << "config no chunkserver.enableAppliedIndexRead info";     // NOLINT
     RETURN_IF_FALSE(ret);
 
+    HedgedReadOption& hedgedReadOpt =
+        fileServiceOption_.ioOpt.ioSenderOpt.hedgedReadOpt;
+    ret = conf_.GetBoolValue("chunkserver.hedgedRead.enable",
+                             &hedgedReadOpt.enable);
+    LOG_IF(WARNING, ret == false)
+        << "config no chunkserver.hedgedRead.enable info, using default value "
+        << hedgedReadOpt.enable;
+
+    ret = conf_.GetDoubleValue("chunkserver.hedgedRead.delayPercentile",
+                               &hedgedReadOpt.delayPercentile);
+    LOG_IF(WARNING, ret == false)
+        << "config no chunkserver.hedgedRead.delayPercentile info, "
+           "using default value " << hedgedReadOpt.delayPercentile;
+
+    ret = conf_.GetUInt64Value("chunkserver.hedgedRead.minDelayUS",
+                               &hedgedReadOpt.minDelayUS);
+    LOG_IF(WARNING, ret == false)
+        << "config no chunkserver.hedgedRead.minDelayUS info, "
+           "using default value " << hedgedReadOpt.minDelayUS;
+
+    ret = conf_.GetUInt64Value("chunkserver.hedgedRead.maxDelayUS",
+                               &hedgedReadOpt.maxDelayUS);
+    LOG_IF(WARNING, ret == false)
+        << "config no chunkserver.hedgedRead.maxDelayUS info, "
+           "using default value " << hedgedReadOpt.maxDelayUS;
+
     ret = conf_.GetUInt32Value("chunkserver.opMaxRetry",
           &fileServiceOption_.ioOpt.ioSenderOpt.failRequestOpt.chunkserverOPMaxRetry);    // NOLINT
     LOG_IF(ERROR, ret == false) << "config no chunkserver.opMaxRetry info";
@@ -134,6 +160,44 @@ int ClientConfig::Init(const std::string& configpath) {
     LOG_IF(ERROR, ret == false) << "config no global.fileMaxInFlightRPCNum info";   // NOLINT
     RETURN_IF_FALSE(ret);
 
+    ChunkServerInflightOption& csInflightOpt =
+        fileServiceOption_.ioOpt.ioSenderOpt.inflightOpt.chunkserverOpt;
+    ret = conf_.GetBoolValue("global.chunkserverInflight.enable",
+                             &csInflightOpt.enable);
+    LOG_IF(WARNING, ret == false)
+        << "config no global.chunkserverInflight.enable info, "
+           "using default value " << csInflightOpt.enable;
+
+    ret = conf_.GetUInt32Value("global.chunkserverInflight.initWindow",
+                               &csInflightOpt.initWindow);
+    LOG_IF(WARNING, ret == false)
+        << "config no global.chunkserverInflight.initWindow info, "
+           "using default value " << csInflightOpt.initWindow;
+
+    ret = conf_.GetUInt32Value("global.chunkserverInflight.minWindow",
+                               &csInflightOpt.minWindow);
+    LOG_IF(WARNING, ret == false)
+        << "config no global.chunkserverInflight.minWindow info, "
+           "using default value " << csInflightOpt.minWindow;
+
+    ret = conf_.GetUInt32Value("global.chunkserverInflight.maxWindow",
+                               &csInflightOpt.maxWindow);
+    LOG_IF(WARNING, ret == false)
+        << "config no global.chunkserverInflight.maxWindow info, "
+           "using default value " << csInflightOpt.maxWindow;
+
+    ret = conf_.GetDoubleValue("global.chunkserverInflight.latencyRatio",
+                               &csInflightOpt.latencyRatio);
+    LOG_IF(WARNING, ret == false)
+        << "config no global.chunkserverInflight.latencyRatio info, "
+           "using default value " << csInflightOpt.latencyRatio;
+
+    ret = conf_.GetDoubleValue("global.chunkserverInflight.decreaseFactor",
+                               &csInflightOpt.decreaseFactor);
+    LOG_IF(WARNING, ret == false)
+        << "config no global.chunkserverInflight.decreaseFactor info, "
+           "using default value " << csInflightOpt.decreaseFactor;
+
     ret = conf_.GetUInt32Value("metacache.getLeaderRetry",
         &fileServiceOption_.ioOpt.metaCacheOpt.metacacheGetLeaderRetry);
     LOG_IF(ERROR, ret == false) << "config no metacache.getLeaderRetry info";
@@ -149,6 +213,18 @@ int ClientConfig::Init(const std::string& configpath) {
     LOG_IF(ERROR, ret == false) << "config no metacache.getLeaderTimeOutMS info";   // NOLINT
     RETURN_IF_FALSE(ret);
 
+    ret = conf_.GetBoolValue("metacache.prefetchOnOpen",
+        &fileServiceOption_.ioOpt.metaCacheOpt.prefetchOnOpen);
+    LOG_IF(WARNING, ret == false)
+        << "config no metacache.prefetchOnOpen info, using default value "
+        << fileServiceOption_.ioOpt.metaCacheOpt.prefetchOnOpen;
+
+    ret = conf_.GetUInt32Value("metacache.prefetchMaxSegments",
+        &fileServiceOption_.ioOpt.metaCacheOpt.prefetchMaxSegments);
+    LOG_IF(WARNING, ret == false)
+        << "config no metacache.prefetchMaxSegments info, using default value "
+        << fileServiceOption_.ioOpt.metaCacheOpt.prefetchMaxSegments;
+
     ret = conf_.GetUInt32Value("schedule.queueCapacity",
         &fileServiceOption_.ioOpt.reqSchdulerOpt.scheduleQueueCapacity);
     LOG_IF(ERROR, ret == false) << "config no schedule.queueCapacity info";
@@ -159,6 +235,12 @@ int ClientConfig::Init(const std::string& configpath) {
     LOG_IF(ERROR, ret == false) << "config no schedule.threadpoolSize info";
     RETURN_IF_FALSE(ret);
 
+    ret = conf_.GetUInt32Value("schedule.batchSize",
+        &fileServiceOption_.ioOpt.reqSchdulerOpt.scheduleBatchSize);
+    LOG_IF(WARNING, ret == false)
+        << "config no schedule.batchSize info, using default value "
+        << fileServiceOption_.ioOpt.reqSchdulerOpt.scheduleBatchSize;
+
     ret = conf_.GetUInt32Value("mds.refreshTimesPerLease",
         &fileServiceOption_.leaseOpt.mdsRefreshTimesPerLease);
     LOG_IF(ERROR, ret == false) << "config no mds.refreshTimesPerLease info";
@@ -262,6 +344,30 @@ int ClientConfig::Init(const std::string& configpath) {
         << "config no throttle.enable info, using default value "
         << fileServiceOption_.ioOpt.throttleOption.enable;
 
+    WriteCoalesceOption& coalesceOpt = fileServiceOption_.ioOpt.writeCoalesceOpt;
+    ret = conf_.GetBoolValue("writeCoalesce.enable", &coalesceOpt.enable);
+    LOG_IF(WARNING, ret == false)
+        << "config no writeCoalesce.enable info, using default value "
+        << coalesceOpt.enable;
+
+    ret = conf_.GetUInt64Value("writeCoalesce.windowUS",
+                               &coalesceOpt.windowUS);
+    LOG_IF(WARNING, ret == false)
+        << "config no writeCoalesce.windowUS info, using default value "
+        << coalesceOpt.windowUS;
+
+    ret = conf_.GetUInt32Value("writeCoalesce.maxWriteSize",
+                               &coalesceOpt.maxWriteSize);
+    LOG_IF(WARNING, ret == false)
+        << "config no writeCoalesce.maxWriteSize info, using default value "
+        << coalesceOpt.maxWriteSize;
+
+    ret = conf_.GetUInt32Value("writeCoalesce.maxMergedSize",
+                               &coalesceOpt.maxMergedSize);
+    LOG_IF(WARNING, ret == false)
+        << "config no writeCoalesce.maxMergedSize info, using default value "
+        << coalesceOpt.maxMergedSize;
+
     ret = conf_.GetBoolValue("discard.enable",
                              &fileServiceOption_.ioOpt.discardOption.enable);
     LOG_IF(ERROR, ret == false) << "config no discard.enable info";
@@ -102,6 +102,60 @@ struct DiscardMetric {
     bvar::Adder<int64_t> pending;
 };
 
+// 写合并统计
+struct WriteCoalesceMetric {
+    explicit WriteCoalesceMetric(const std::string& prefix)
+        : userWrites(prefix, "coalesce_user_write"),
+          mergedWrites(prefix, "coalesce_merged_write"),
+          mergeRatio(prefix, "coalesce_merge_ratio", GetMergeRatio, this) {}
+
+    // 进入合并窗口的用户写请求数量
+    bvar::Adder<uint64_t> userWrites;
+    // 合并之后实际下发的写请求数量
+    bvar::Adder<uint64_t> mergedWrites;
+    // 平均每个下发的写请求合并了多少个用户写请求
+    bvar::PassiveStatus<double> mergeRatio;
+
+    static double GetMergeRatio(void* arg) {
+        auto* metric = static_cast<WriteCoalesceMetric*>(arg);
+        uint64_t merged = metric->mergedWrites.get_value();
+        return merged == 0
+                   ? 0.0
+                   : static_cast<double>(metric->userWrites.get_value()) /
+                         merged;
+    }
+};
+
+// RequestContext对象池统计，进程级别
+struct RequestContextPoolMetric {
+    // 新分配的RequestContext数量
+    bvar::Adder<uint64_t> allocCount;
+    // 从对象池中复用的RequestContext数量
+    bvar::Adder<uint64_t> reuseCount;
+    // 归还到对象池的RequestContext数量
+    bvar::Adder<uint64_t> recycleCount;
+
+    explicit RequestContextPoolMetric(const std::string& prefix)
+        : allocCount(prefix, "alloc_count"),
+          reuseCount(prefix, "reuse_count"),
+          recycleCount(prefix, "recycle_count") {}
+};
+
+// hedged read统计，进程级别
+struct HedgedReadMetric {
+    // 发给follower的hedged read数量
+    bvar::Adder<uint64_t> sentCount;
+    // hedged read先于leader返回，作为读结果的数量
+    bvar::Adder<uint64_t> winCount;
+    // 被丢弃的读请求数量，包括较慢的一方以及失败的hedged read
+    bvar::Adder<uint64_t> discardCount;
+
+    explicit HedgedReadMetric(const std::string& prefix)
+        : sentCount(prefix, "sent_count"),
+          winCount(prefix, "win_count"),
+          discardCount(prefix, "discard_count") {}
+};
+
 // 文件级别metric信息统计
 struct FileMetric {
     const std::string prefix = "curve_client";
@@ -136,6 +190,8 @@ struct FileMetric {
 
     DiscardMetric discardMetric;
 
+    WriteCoalesceMetric writeCoalesceMetric;
+
     explicit FileMetric(const std::string& name)
         : filename(name),
           inflightRPCNum(prefix, filename + "_inflight_rpc_num"),
@@ -149,7 +205,8 @@ struct FileMetric {
           userDiscard(prefix, filename + "_discard"),
           getLeaderRetryQPS(prefix, filename + "_get_leader_retry_rpc"),
           suspendRPCMetric(prefix, filename + "_suspend_io_num"),
-          discardMetric(prefix + filename) {}
+          discardMetric(prefix + filename),
+          writeCoalesceMetric(prefix + filename) {}
 };
 
 // 用于全局mds接口统计信息调用信息统计
@@ -176,6 +233,8 @@ struct MDSClientMetric {
     InterfaceMetric getOrAllocateSegment;
     // DeAllocateSegment接口统计信息
     InterfaceMetric deAllocateSegment;
+    // ListSegment接口统计信息
+    InterfaceMetric listSegment;
     // RenameFile接口统计信息
     InterfaceMetric renameFile;
     // Extend接口统计信息
@@ -214,6 +273,7 @@ struct MDSClientMetric {
           getServerList(prefix, "getServerList"),
           getOrAllocateSegment(prefix, "getOrAllocateSegment"),
           deAllocateSegment(prefix, "deAllocateSegment"),
+          listSegment(prefix, "listSegment"),
           renameFile(prefix, "renameFile"),
           extendFile(prefix, "extendFile"),
           deleteFile(prefix, "deleteFile"),
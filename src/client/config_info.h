@@ -40,12 +40,35 @@ struct LogInfo {
     std::string logPath;
 };
 
+/**
+ * 每个chunkserver的inflight rpc窗口配置，窗口根据rpc延迟调整：
+ * 每收到窗口大小个回复算作一轮，一轮中的最小延迟不超过基准延迟的latencyRatio倍
+ * 时窗口加1，否则乘以decreaseFactor；rpc超时或者chunkserver overload时也会
+ * 乘性减小，chunkserver被判定为unstable时直接减到minWindow
+ * @enable: 是否开启，关闭时只有文件级别的fileMaxInFlightRPCNum限制
+ * @initWindow: 初始窗口
+ * @minWindow: 最小窗口
+ * @maxWindow: 最大窗口
+ * @latencyRatio: 判定拥塞的延迟倍数
+ * @decreaseFactor: 乘性减小的系数
+ */
+struct ChunkServerInflightOption {
+    bool enable = false;
+    uint32_t initWindow = 32;
+    uint32_t minWindow = 4;
+    uint32_t maxWindow = 256;
+    double latencyRatio = 2.0;
+    double decreaseFactor = 0.5;
+};
+
 /**
  * in flight IO控制信息
  * @fileMaxInFlightRPCNum: 为一个文件中最大允许的inflight IO数量
+ * @chunkserverOpt: 一个文件发往每个chunkserver的inflight rpc窗口配置
  */
 struct InFlightIOCntlInfo {
     uint64_t fileMaxInFlightRPCNum = 2048;
+    ChunkServerInflightOption chunkserverOpt;
 };
 
 struct MetaServerOption {
@@ -154,16 +177,33 @@ struct FailureRequestOption {
     uint64_t chunkserverMaxRetryTimesBeforeConsiderSuspend = 20;
 };
 
+/**
+ * hedged read配置，读请求发给leader之后一段时间还未返回，就再向一个follower
+ * 发送同样的读请求，先返回的结果作为本次读的结果
+ * @enable: 是否开启hedged read，依赖appliedindex read
+ * @delayPercentile: 等待时间取leader读延迟的该分位值
+ * @minDelayUS: 等待时间的下限
+ * @maxDelayUS: 等待时间的上限，leader还没有延迟统计时也使用该值
+ */
+struct HedgedReadOption {
+    bool enable = false;
+    double delayPercentile = 0.95;
+    uint64_t minDelayUS = 1000;
+    uint64_t maxDelayUS = 50000;
+};
+
 /**
  * 发送rpc给chunkserver的配置
  * @chunkserverEnableAppliedIndexRead: 是否开启使用appliedindex read
  * @inflightOpt: 一个文件向chunkserver发送请求时的inflight 请求控制配置
  * @failRequestOpt: rpc发送失败之后，需要进行rpc重试的相关配置
+ * @hedgedReadOpt: hedged read相关配置
  */
 struct IOSenderOption {
     bool chunkserverEnableAppliedIndexRead;
     InFlightIOCntlInfo inflightOpt;
     FailureRequestOption failRequestOpt;
+    HedgedReadOption hedgedReadOpt;
 };
 
 /**
@@ -171,10 +211,12 @@ struct IOSenderOption {
  * 线程池，线程池中的线程各自配置一个队列
  * @scheduleQueueCapacity: schedule模块配置的队列深度
  * @scheduleThreadpoolSize: schedule模块线程池大小
+ * @scheduleBatchSize: schedule线程每次从队列中取出的最大请求数
  */
 struct RequestScheduleOption {
     uint32_t scheduleQueueCapacity = 1024;
     uint32_t scheduleThreadpoolSize = 2;
+    uint32_t scheduleBatchSize = 32;
     IOSenderOption ioSenderOpt;
 };
 
@@ -208,6 +250,10 @@ struct MetaCacheOption {
     uint32_t discardGranularity = 4096;
     std::string metacacheGetLeaderBackupRequestLbName = "rr";
     ChunkServerUnstableOption chunkserverUnstableOption;
+    // 打开文件时是否一次性从mds获取所有已分配的segment和copyset信息
+    bool prefetchOnOpen = false;
+    // 文件segment数量超过该值时不做预取，避免mds返回过大的response
+    uint32_t prefetchMaxSegments = 4096;
 };
 
 struct AlignmentOption {
@@ -258,6 +304,21 @@ struct ThrottleOption {
     bool enable = false;
 };
 
+/**
+ * 写合并配置，相邻或者重叠的小写请求在一个很短的窗口内合并成一个请求下发，
+ * 减少chunkserver上的rpc和raft日志数量
+ * @enable: 是否开启写合并
+ * @windowUS: 合并窗口，第一个写请求最多等待这么久之后下发
+ * @maxWriteSize: 只有不超过该大小的写请求才会参与合并
+ * @maxMergedSize: 合并之后请求的最大大小，达到之后立即下发
+ */
+struct WriteCoalesceOption {
+    bool enable = false;
+    uint64_t windowUS = 100;
+    uint32_t maxWriteSize = 16 * 1024;
+    uint32_t maxMergedSize = 128 * 1024;
+};
+
 /**
  * IOOption存储了当前io 操作所需要的所有配置信息
  */
@@ -270,6 +331,7 @@ struct IOOption {
     CloseFdThreadOption closeFdThreadOption;
     ThrottleOption throttleOption;
     DiscardOption discardOption;
+    WriteCoalesceOption writeCoalesceOpt;
 };
 
 /**
@@ -24,9 +24,13 @@
 
 #include <glog/logging.h>
 #include <unistd.h>
+#include <butil/fast_rand.h>
+
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "src/client/hedged_read.h"
 #include "src/client/request_sender.h"
 #include "src/client/metacache.h"
 #include "src/client/client_config.h"
@@ -124,13 +128,76 @@ int CopysetClient::ReadChunk(const ChunkIDInfo& idinfo, uint64_t sn,
 
     auto task = [&](Closure* done, std::shared_ptr<RequestSender> senderPtr) {
         ReadChunkClosure *readDone = new ReadChunkClosure(this, done);
+        // 只对第一次发送的读请求做hedged read，重试的请求直接发给leader
+        std::unique_ptr<HedgedReadTask> hedgedRead;
+        if (reqclosure->GetRetriedTimes() == 1 &&
+            NeedHedgedRead(appliedindex, sourceInfo)) {
+            hedgedRead = CreateHedgedReadTask(idinfo, offset, length,
+                appliedindex, senderPtr->GetChunkServerId(), reqclosure);
+        }
+        if (hedgedRead != nullptr) {
+            readDone->SetHedgedReadState(hedgedRead->state);
+        }
+
         senderPtr->ReadChunk(idinfo, sn, offset, length,
                              appliedindex, sourceInfo, readDone);
+
+        // 在发送之后再启动定时器，避免hedged read结束请求时
+        // 上面的发送流程还在访问done
+        if (hedgedRead != nullptr) {
+            ScheduleHedgedRead(std::move(hedgedRead));
+        }
     };
 
     return DoRPCTask(idinfo, task, doneGuard.release());
 }
 
+bool CopysetClient::NeedHedgedRead(uint64_t appliedindex,
+                                   const RequestSourceInfo& sourceInfo) const {
+    // follower只有在apply到appliedindex之后才能直接读，
+    // clone chunk的读可能需要从源端拷贝数据，只能由leader处理
+    return iosenderopt_.hedgedReadOpt.enable &&
+           iosenderopt_.chunkserverEnableAppliedIndexRead &&
+           appliedindex > 0 && !sourceInfo.IsValid();
+}
+
+std::unique_ptr<HedgedReadTask> CopysetClient::CreateHedgedReadTask(
+    const ChunkIDInfo& idinfo, off_t offset, size_t length,
+    uint64_t appliedindex, ChunkServerID leaderId, RequestClosure* done) {
+    CopysetInfo<ChunkServerID> cpinfo =
+        metaCache_->GetCopysetinfo(idinfo.lpid_, idinfo.cpid_);
+    std::vector<const CopysetPeerInfo<ChunkServerID>*> followers;
+    for (const auto& peer : cpinfo.csinfos_) {
+        if (peer.peerID != leaderId) {
+            followers.push_back(&peer);
+        }
+    }
+    if (followers.empty()) {
+        return nullptr;
+    }
+
+    const auto* follower =
+        followers[butil::fast_rand_less_than(followers.size())];
+    auto senderPtr = senderManager_->GetOrCreateSender(
+        follower->peerID, follower->externalAddr.addr_, iosenderopt_);
+    if (senderPtr == nullptr) {
+        return nullptr;
+    }
+
+    std::unique_ptr<HedgedReadTask> task(new HedgedReadTask());
+    task->state = std::make_shared<HedgedReadState>();
+    task->sender = std::move(senderPtr);
+    task->metaCache = metaCache_;
+    task->done = done;
+    task->idinfo = idinfo;
+    task->offset = offset;
+    task->length = length;
+    task->appliedindex = appliedindex;
+    task->delayUS = ChunkServerReadLatency::GetInstance().GetHedgeDelayUS(
+        leaderId, iosenderopt_.hedgedReadOpt);
+    return task;
+}
+
 int CopysetClient::WriteChunk(const ChunkIDInfo& idinfo,
                               uint64_t fileId,
                               uint64_t epoch,
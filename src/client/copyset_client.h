@@ -44,7 +44,9 @@ using curve::common::Uncopyable;
 using ::google::protobuf::Closure;
 
 // TODO(tongguangxun) :后续除了read、write的接口也需要调整重试逻辑
+struct HedgedReadTask;
 class MetaCache;
+class RequestClosure;
 class RequestScheduler;
 /**
  * 负责管理 ChunkServer 的链接，向上层提供访问
@@ -226,6 +228,20 @@ class CopysetClient {
                      ChunkServerID* leaderid,
                      butil::EndPoint* leaderaddr);
 
+    // 读请求是否可以向follower发送hedged read
+    bool NeedHedgedRead(uint64_t appliedindex,
+                        const RequestSourceInfo& sourceInfo) const;
+
+    /**
+     * 选择一个follower，根据leader的读延迟生成hedged read任务
+     * @param[in]: leaderId为读请求发往的leader
+     * @param[in]: done是本次读请求的异步回调
+     * @return: hedged read任务，没有可用的follower时返回nullptr
+     */
+    std::unique_ptr<HedgedReadTask> CreateHedgedReadTask(
+        const ChunkIDInfo& idinfo, off_t offset, size_t length,
+        uint64_t appliedindex, ChunkServerID leaderId, RequestClosure* done);
+
     /**
      * 执行发送rpc task，并进行错误重试
      * @param[in]: idinfo为当前rpc task的id信息
@@ -179,6 +179,12 @@ int FileInstance::Open(const std::string &filename, const UserInfo &userinfo,
             sessionId->assign(lease.sessionID);
         }
         iomanager4file_.UpdateFileEpoch(fEpoch);
+
+        // 预取失败不影响打开文件，之后按需从mds获取
+        if (ret == LIBCURVE_ERROR::OK &&
+            fileopt_.ioOpt.metaCacheOpt.prefetchOnOpen) {
+            iomanager4file_.GetMetaCache()->Prefetch(finfo_);
+        }
     }
     return -ret;
 }
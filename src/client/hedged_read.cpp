@@ -0,0 +1,198 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-04-03
+ * Author: curve
+ */
+
+#include "src/client/hedged_read.h"
+
+#include <brpc/controller.h>
+#include <bthread/bthread.h>
+#include <bthread/unstable.h>
+#include <butil/time.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "proto/chunk.pb.h"
+#include "src/client/metacache.h"
+#include "src/client/request_closure.h"
+#include "src/client/request_context.h"
+#include "src/client/request_sender.h"
+
+namespace curve {
+namespace client {
+
+using curve::chunkserver::CHUNK_OP_STATUS;
+using curve::chunkserver::ChunkResponse;
+using curve::common::ReadLockGuard;
+using curve::common::WriteLockGuard;
+
+HedgedReadMetric& GetHedgedReadMetric() {
+    static HedgedReadMetric metric("curve_client_hedged_read");
+    return metric;
+}
+
+ChunkServerReadLatency& ChunkServerReadLatency::GetInstance() {
+    static ChunkServerReadLatency instance;
+    return instance;
+}
+
+bvar::LatencyRecorder* ChunkServerReadLatency::GetRecorder(
+    ChunkServerID csId) {
+    {
+        ReadLockGuard lk(rwlock_);
+        auto it = recorders_.find(csId);
+        if (it != recorders_.end()) {
+            return it->second.get();
+        }
+    }
+
+    WriteLockGuard lk(rwlock_);
+    auto& recorder = recorders_[csId];
+    if (recorder == nullptr) {
+        recorder.reset(new bvar::LatencyRecorder(
+            "curve_client_chunkserver_" + std::to_string(csId),
+            "read_latency"));
+    }
+    return recorder.get();
+}
+
+void ChunkServerReadLatency::Record(ChunkServerID csId, int64_t latencyUS) {
+    *GetRecorder(csId) << latencyUS;
+}
+
+uint64_t ChunkServerReadLatency::GetHedgeDelayUS(ChunkServerID csId,
+                                                 const HedgedReadOption& opt) {
+    int64_t latency = GetRecorder(csId)->latency_percentile(
+        opt.delayPercentile);
+    // no samples in the window yet, wait as long as we are allowed to
+    if (latency <= 0) {
+        return opt.maxDelayUS;
+    }
+
+    return std::min(opt.maxDelayUS,
+                    std::max(opt.minDelayUS, static_cast<uint64_t>(latency)));
+}
+
+namespace {
+
+class HedgedReadClosure : public google::protobuf::Closure {
+ public:
+    explicit HedgedReadClosure(std::unique_ptr<HedgedReadTask> task)
+        : task_(std::move(task)) {}
+
+    brpc::Controller* Cntl() {
+        return &cntl_;
+    }
+
+    ChunkResponse* Response() {
+        return &response_;
+    }
+
+    void Run() override {
+        std::unique_ptr<HedgedReadClosure> selfGuard(this);
+
+        bool success = !cntl_.Failed() &&
+            response_.status() == CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS;
+        if (success) {
+            ChunkServerReadLatency::GetInstance().Record(
+                task_->sender->GetChunkServerId(), cntl_.latency_us());
+        }
+
+        // the read sent to leader has finished the request, or the follower
+        // can't serve it, leave it to the leader
+        if (!success || !task_->state->TryFinish()) {
+            GetHedgedReadMetric().discardCount << 1;
+            return;
+        }
+
+        RequestClosure* done = task_->done;
+        RequestContext* reqCtx = done->GetReqCtx();
+        reqCtx->readData_ = cntl_.response_attachment();
+        task_->metaCache->UpdateAppliedIndex(
+            task_->idinfo.lpid_, task_->idinfo.cpid_, response_.appliedindex());
+
+        MetricHelper::LatencyRecord(done->GetMetric(), cntl_.latency_us(),
+                                    OpType::READ);
+        MetricHelper::IncremRPCQPSCount(done->GetMetric(), task_->length,
+                                        OpType::READ);
+        GetHedgedReadMetric().winCount << 1;
+
+        done->SetFailed(0);
+        done->Run();
+    }
+
+ private:
+    std::unique_ptr<HedgedReadTask> task_;
+    brpc::Controller cntl_;
+    ChunkResponse response_;
+};
+
+void* SendHedgedRead(void* arg) {
+    std::unique_ptr<HedgedReadTask> task(static_cast<HedgedReadTask*>(arg));
+    if (task->state->IsFinished()) {
+        return nullptr;
+    }
+
+    GetHedgedReadMetric().sentCount << 1;
+    HedgedReadTask* raw = task.get();
+    HedgedReadClosure* closure = new HedgedReadClosure(std::move(task));
+    raw->sender->ReadChunkFromFollower(raw->idinfo, raw->offset, raw->length,
+                                       raw->appliedindex, closure->Cntl(),
+                                       closure->Response(), closure);
+    return nullptr;
+}
+
+void OnHedgedReadTimer(void* arg) {
+    HedgedReadTask* task = static_cast<HedgedReadTask*>(arg);
+    if (task->state->IsFinished()) {
+        delete task;
+        return;
+    }
+
+    // timer callbacks run in the single timer thread, so send the rpc in
+    // another bthread
+    bthread_t tid;
+    if (bthread_start_background(&tid, nullptr, SendHedgedRead, task) != 0) {
+        SendHedgedRead(task);
+    }
+}
+
+}  // namespace
+
+bool ScheduleHedgedRead(std::unique_ptr<HedgedReadTask> task) {
+    bthread_timer_t timerId;
+    timespec abstime = butil::microseconds_from_now(task->delayUS);
+    int ret = bthread_timer_add(&timerId, abstime, OnHedgedReadTimer,
+                                task.get());
+    if (ret != 0) {
+        LOG(WARNING) << "bthread_timer_add failed, ret = " << ret
+                     << ", skip hedged read";
+        return false;
+    }
+
+    task.release();
+    return true;
+}
+
+}   // namespace client
+}   // namespace curve
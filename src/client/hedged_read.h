@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-04-03
+ * Author: curve
+ */
+
+#ifndef SRC_CLIENT_HEDGED_READ_H_
+#define SRC_CLIENT_HEDGED_READ_H_
+
+#include <bvar/bvar.h>
+#include <sys/types.h>
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+
+#include "src/client/client_common.h"
+#include "src/client/client_metric.h"
+#include "src/client/config_info.h"
+#include "src/common/concurrent/rw_lock.h"
+
+namespace curve {
+namespace client {
+
+class MetaCache;
+class RequestClosure;
+class RequestSender;
+
+/**
+ * 一次读请求的hedged read状态，由发给leader的读和发给follower的hedged read
+ * 共享，只有先完成的一方可以结束上层请求，另一方的结果直接丢弃
+ */
+class HedgedReadState {
+ public:
+    // 返回true表示由调用方结束上层请求
+    bool TryFinish() {
+        return !finished_.exchange(true, std::memory_order_acq_rel);
+    }
+
+    bool IsFinished() const {
+        return finished_.load(std::memory_order_acquire);
+    }
+
+ private:
+    std::atomic<bool> finished_{false};
+};
+
+/**
+ * 记录每个chunkserver的读延迟，hedged read根据leader的延迟分位值
+ * 决定等待多久之后再向follower发送请求，进程级别
+ */
+class ChunkServerReadLatency {
+ public:
+    static ChunkServerReadLatency& GetInstance();
+
+    void Record(ChunkServerID csId, int64_t latencyUS);
+
+    /**
+     * 获取向follower发送hedged read之前的等待时间
+     * @param csId: leader的chunkserver id
+     * @param opt: hedged read配置
+     * @return: 等待时间，单位us
+     */
+    uint64_t GetHedgeDelayUS(ChunkServerID csId, const HedgedReadOption& opt);
+
+ private:
+    ChunkServerReadLatency() = default;
+
+    bvar::LatencyRecorder* GetRecorder(ChunkServerID csId);
+
+ private:
+    curve::common::BthreadRWLock rwlock_;
+    std::unordered_map<ChunkServerID, std::unique_ptr<bvar::LatencyRecorder>>
+        recorders_;
+};
+
+/**
+ * 发给follower的hedged read
+ * @state: 与发给leader的读共享的状态
+ * @sender: follower对应的RequestSender
+ * @done: 上层请求的closure，只有在TryFinish成功之后才能访问
+ * @delayUS: 发送hedged read之前等待的时间
+ */
+struct HedgedReadTask {
+    std::shared_ptr<HedgedReadState> state;
+    std::shared_ptr<RequestSender> sender;
+    MetaCache* metaCache = nullptr;
+    RequestClosure* done = nullptr;
+    ChunkIDInfo idinfo;
+    off_t offset = 0;
+    size_t length = 0;
+    uint64_t appliedindex = 0;
+    uint64_t delayUS = 0;
+};
+
+/**
+ * 在task->delayUS之后发送hedged read，如果此时上层请求已经完成则直接丢弃
+ * @return: 定时器添加成功返回true
+ */
+bool ScheduleHedgedRead(std::unique_ptr<HedgedReadTask> task);
+
+HedgedReadMetric& GetHedgedReadMetric();
+
+}   // namespace client
+}   // namespace curve
+
+#endif  // SRC_CLIENT_HEDGED_READ_H_
@@ -205,6 +205,17 @@ void IOTracker::DoWrite(MDSClient* mdsclient, const FInfo_t* fileInfo,
         case UserDataType::IOBuffer:
             writeData_ = *reinterpret_cast<const butil::IOBuf*>(data_);
             break;
+        case UserDataType::IOVector: {
+            size_t total = AppendIOVector(
+                reinterpret_cast<const CurveIOVector*>(data_), &writeData_);
+            if (total != length_) {
+                LOG(ERROR) << "iovec length " << total
+                           << " mismatch with request length " << length_;
+                ReturnOnFail();
+                return;
+            }
+            break;
+        }
     }
 
     if (throttle) {
@@ -497,6 +508,15 @@ void IOTracker::Done() {
                     }
                     break;
                 }
+                case UserDataType::IOVector: {
+                    size_t nc = CutToIOVector(
+                        &readData,
+                        reinterpret_cast<const CurveIOVector*>(data_));
+                    if (nc != length_) {
+                        errcode_ = LIBCURVE_ERROR::FAILED;
+                    }
+                    break;
+                }
             }
 
             if (errcode_ != LIBCURVE_ERROR::OK) {
@@ -554,8 +574,7 @@ void IOTracker::Done() {
 
 void IOTracker::DestoryRequestList() {
     for (auto iter : reqlist_) {
-        iter->UnInit();
-        delete iter;
+        RequestContext::Recycle(iter);
     }
 }
 
@@ -48,6 +48,8 @@ bool IOManager4File::Initialize(const std::string& filename,
 
     inflightRpcCntl_.SetMaxInflightNum(
         ioopt_.ioSenderOpt.inflightOpt.fileMaxInFlightRPCNum);
+    mc_.GetChunkServerInflightControl().Init(
+        ioopt_.ioSenderOpt.inflightOpt.chunkserverOpt, filename);
 
     fileMetric_ = new (std::nothrow) FileMetric(filename);
     if (fileMetric_ == nullptr) {
@@ -87,6 +89,14 @@ bool IOManager4File::Initialize(const std::string& filename,
     discardTaskManager_.reset(
         new DiscardTaskManager(&(fileMetric_->discardMetric)));
 
+    if (ioopt_.writeCoalesceOpt.enable) {
+        writeCoalescer_.reset(new WriteCoalescer(
+            ioopt_.writeCoalesceOpt, &(fileMetric_->writeCoalesceMetric),
+            [this, mdsclient](CurveAioContext* ctx, UserDataType dataType) {
+                SubmitAioWrite(ctx, mdsclient, dataType);
+            }));
+    }
+
     LOG(INFO) << "iomanager init success, conf info: "
               << "isolationTaskThreadPoolSize = "
               << ioopt_.taskThreadOpt.isolationTaskThreadPoolSize
@@ -101,6 +111,11 @@ void IOManager4File::UnInitialize() {
         throttle_->Stop();
     }
 
+    // flush coalesced writes before stopping the task pool
+    if (writeCoalescer_) {
+        writeCoalescer_->Stop();
+    }
+
     bool exitFlag = false;
     std::mutex exitMtx;
     std::condition_variable exitCv;
@@ -210,13 +225,25 @@ int IOManager4File::AioWrite(CurveAioContext* ctx, MDSClient* mdsclient,
                              UserDataType dataType) {
     MetricHelper::IncremUserRPSCount(fileMetric_, OpType::WRITE);
 
+    if (writeCoalescer_ &&
+        writeCoalescer_->Add(ctx, dataType, GetCoalesceBoundary())) {
+        return LIBCURVE_ERROR::OK;
+    }
+
+    SubmitAioWrite(ctx, mdsclient, dataType);
+    return LIBCURVE_ERROR::OK;
+}
+
+void IOManager4File::SubmitAioWrite(CurveAioContext* ctx,
+                                    MDSClient* mdsclient,
+                                    UserDataType dataType) {
     IOTracker* temp = new (std::nothrow)
         IOTracker(this, &mc_, scheduler_, fileMetric_, disableStripe_);
     if (temp == nullptr) {
         ctx->ret = -LIBCURVE_ERROR::FAILED;
         ctx->cb(ctx);
         LOG(ERROR) << "allocate tracker failed!";
-        return LIBCURVE_ERROR::OK;
+        return;
     }
 
     temp->SetUserDataType(dataType);
@@ -228,7 +255,16 @@ int IOManager4File::AioWrite(CurveAioContext* ctx, MDSClient* mdsclient,
     };
 
     taskPool_.Enqueue(task);
-    return LIBCURVE_ERROR::OK;
+}
+
+uint64_t IOManager4File::GetCoalesceBoundary() const {
+    const FInfo* fileInfo = GetFileInfo();
+    if (!disableStripe_ && fileInfo->stripeUnit != 0 &&
+        fileInfo->stripeCount > 1) {
+        return fileInfo->stripeUnit;
+    }
+
+    return fileInfo->chunksize;
 }
 
 int IOManager4File::Discard(off_t offset, size_t length, MDSClient* mdsclient) {
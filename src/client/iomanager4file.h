@@ -43,6 +43,7 @@
 #include "src/common/concurrent/task_thread_pool.h"
 #include "src/common/throttle.h"
 #include "src/client/discard_task.h"
+#include "src/client/write_coalescer.h"
 
 namespace curve {
 namespace client {
@@ -260,6 +261,13 @@ class IOManager4File : public IOManager {
 
     bool IsNeedDiscard(size_t len) const;
 
+    // 下发一个异步写请求，不经过写合并
+    void SubmitAioWrite(CurveAioContext* ctx, MDSClient* mdsclient,
+                        UserDataType dataType);
+
+    // 写合并之后的请求不能跨越的边界，保证合并之后的请求只落在一个chunk上
+    uint64_t GetCoalesceBoundary() const;
+
  private:
     // 每个IOManager都有其IO配置，保存在iooption里
     IOOption ioopt_;
@@ -285,6 +293,9 @@ class IOManager4File : public IOManager {
 
     std::unique_ptr<common::Throttle> throttle_;
 
+    // 写合并，未开启时为空
+    std::unique_ptr<WriteCoalescer> writeCoalescer_;
+
     // 是否退出
     bool exit_;
 
@@ -36,6 +36,7 @@
 #include "include/client/libcurve.h"
 #include "include/client/libcurve_define.h"
 #include "include/curve_compiler_specific.h"
+#include "src/client/aio_queue.h"
 #include "src/client/client_common.h"
 #include "src/client/client_config.h"
 #include "src/client/file_instance.h"
@@ -885,6 +886,30 @@ int AioWrite(int fd, CurveAioContext *aioctx) {
     return globalclient->AioWrite(fd, aioctx);
 }
 
+int AioReadv(int fd, CurveAioContext *aioctx) {
+    if (globalclient == nullptr) {
+        LOG(ERROR) << "not inited!";
+        return -LIBCURVE_ERROR::FAILED;
+    }
+
+    DVLOG(9) << "offset: " << aioctx->offset << " length: " << aioctx->length
+             << " op: " << aioctx->op;
+    return globalclient->AioRead(fd, aioctx,
+                                 curve::client::UserDataType::IOVector);
+}
+
+int AioWritev(int fd, CurveAioContext *aioctx) {
+    if (globalclient == nullptr) {
+        LOG(ERROR) << "not inited!";
+        return -LIBCURVE_ERROR::FAILED;
+    }
+
+    DVLOG(9) << "offset: " << aioctx->offset << " length: " << aioctx->length
+             << " op: " << aioctx->op;
+    return globalclient->AioWrite(fd, aioctx,
+                                  curve::client::UserDataType::IOVector);
+}
+
 int AioDiscard(int fd, CurveAioContext *aioctx) {
     if (globalclient == nullptr) {
         LOG(ERROR) << "Not inited!";
@@ -894,6 +919,67 @@ int AioDiscard(int fd, CurveAioContext *aioctx) {
     return globalclient->AioDiscard(fd, aioctx);
 }
 
+static int SubmitAioQueueRequest(int fd, CurveAioContext* aioctx,
+                                 curve::client::UserDataType dataType) {
+    if (globalclient == nullptr) {
+        LOG(ERROR) << "Not inited!";
+        return -LIBCURVE_ERROR::FAILED;
+    }
+
+    switch (aioctx->op) {
+        case LIBCURVE_OP_READ:
+            return globalclient->AioRead(fd, aioctx, dataType);
+        case LIBCURVE_OP_WRITE:
+            return globalclient->AioWrite(fd, aioctx, dataType);
+        case LIBCURVE_OP_DISCARD:
+            return globalclient->AioDiscard(fd, aioctx);
+        default:
+            LOG(ERROR) << "Unknown aio op: " << aioctx->op;
+            return -LIBCURVE_ERROR::PARAM_ERROR;
+    }
+}
+
+CurveAioQueue* AioQueueCreate(uint32_t depth) {
+    if (globalclient == nullptr) {
+        LOG(ERROR) << "Not inited!";
+        return nullptr;
+    }
+
+    std::unique_ptr<curve::client::AioQueue> queue(
+        new curve::client::AioQueue(depth, SubmitAioQueueRequest));
+    if (queue->Init() != 0) {
+        return nullptr;
+    }
+
+    return reinterpret_cast<CurveAioQueue*>(queue.release());
+}
+
+int AioQueueDestroy(CurveAioQueue* queue) {
+    auto* q = reinterpret_cast<curve::client::AioQueue*>(queue);
+    if (q->Size() != 0) {
+        LOG(ERROR) << "Destroy aio queue with " << q->Size()
+                   << " requests not polled";
+        return -LIBCURVE_ERROR::FAILED;
+    }
+
+    delete q;
+    return LIBCURVE_ERROR::OK;
+}
+
+int AioQueueEventFd(CurveAioQueue* queue) {
+    return reinterpret_cast<curve::client::AioQueue*>(queue)->EventFd();
+}
+
+int AioQueueSubmit(CurveAioQueue* queue, int fd,
+                   CurveAioQueueRequest** reqs, int nr) {
+    return reinterpret_cast<curve::client::AioQueue*>(queue)->Submit(
+        fd, reqs, nr);
+}
+
+int AioQueuePoll(CurveAioQueue* queue, CurveAioQueueRequest** reqs, int max) {
+    return reinterpret_cast<curve::client::AioQueue*>(queue)->Poll(reqs, max);
+}
+
 int Create(const char *filename, const C_UserInfo_t *userinfo, size_t size) {
     if (globalclient == nullptr) {
         LOG(ERROR) << "not inited!";
@@ -44,6 +44,31 @@ using curve::mds::ProtoSession;
 using curve::mds::StatusCode;
 using curve::common::ChunkServerLocation;
 using curve::mds::topology::CopySetServerInfo;
+using curve::mds::SegmentCopysetInfo;
+
+namespace {
+
+CopysetPeerInfo<ChunkServerID> ToCopysetPeerInfo(
+    const ChunkServerLocation &csl) {
+    CopysetPeerInfo<ChunkServerID> csinfo;
+    uint16_t port = csl.port();
+    std::string internalIp = csl.hostip();
+    std::string externalIp = internalIp;
+    if (csl.has_externalip()) {
+        externalIp = csl.externalip();
+    }
+
+    EndPoint internal;
+    butil::str2endpoint(internalIp.c_str(), port, &internal);
+    EndPoint external;
+    butil::str2endpoint(externalIp.c_str(), port, &external);
+    csinfo.peerID = csl.chunkserverid();
+    csinfo.internalAddr = PeerAddr(internal);
+    csinfo.externalAddr = PeerAddr(external);
+    return csinfo;
+}
+
+}  // namespace
 
 // rpc发送和mds地址切换状态机
 int RPCExcutorRetryPolicy::DoRPCTask(RPCFunc rpctask, uint64_t maxRetryTimeMS) {
@@ -830,27 +855,11 @@ MDSClient::GetServerList(const LogicPoolID &logicalpooid,
             copysetseverl.cpid_ = info.copysetid();
             int cslocsNum = info.cslocs_size();
             for (int j = 0; j < cslocsNum; j++) {
-                CopysetPeerInfo<ChunkServerID> csinfo;
-                ChunkServerLocation csl = info.cslocs(j);
-                uint16_t port = csl.port();
-                std::string internalIp = csl.hostip();
-                csinfo.peerID = csl.chunkserverid();
-                std::string externalIp = internalIp;
-                if (csl.has_externalip()) {
-                    externalIp = csl.externalip();
-                }
-
-                EndPoint internal;
-                butil::str2endpoint(internalIp.c_str(), port, &internal);
-                EndPoint external;
-                butil::str2endpoint(externalIp.c_str(), port, &external);
-                csinfo.internalAddr = PeerAddr(internal);
-                csinfo.externalAddr = PeerAddr(external);
-
-                copysetseverl.AddCopysetPeerInfo(csinfo);
-                copyset_peer.append(internalIp)
+                const ChunkServerLocation& csl = info.cslocs(j);
+                copysetseverl.AddCopysetPeerInfo(ToCopysetPeerInfo(csl));
+                copyset_peer.append(csl.hostip())
                     .append(":")
-                    .append(std::to_string(port))
+                    .append(std::to_string(csl.port()))
                     .append(", ");
             }
             cpinfoVec->push_back(copysetseverl);
@@ -1127,6 +1136,80 @@ LIBCURVE_ERROR MDSClient::DeAllocateSegment(const FInfo *fileInfo,
         rpcExcutor_.DoRPCTask(task, metaServerOpt_.mdsMaxRetryMS));
 }
 
+LIBCURVE_ERROR
+MDSClient::ListSegment(const FInfo_t *fi, std::vector<SegmentInfo> *segInfos,
+                       std::vector<CopysetInfo<ChunkServerID>> *cpinfoVec) {
+    auto task = RPCTaskDefine {
+        (void)addrindex;
+        (void)rpctimeoutMS;
+        ListSegmentResponse response;
+        mdsClientMetric_.listSegment.qps.count << 1;
+        LatencyGuard lg(&mdsClientMetric_.listSegment.latency);
+        MDSClientBase::ListSegment(fi, &response, cntl, channel);
+        if (cntl->Failed()) {
+            mdsClientMetric_.listSegment.eps.count << 1;
+            LOG(WARNING) << "ListSegment failed, error = " << cntl->ErrorText()
+                         << ", filename = " << fi->fullPathName
+                         << ", log id = " << cntl->log_id();
+            return -cntl->ErrorCode();
+        }
+
+        auto statuscode = response.statuscode();
+        if (statuscode != StatusCode::kOK) {
+            LOG(WARNING) << "ListSegment mds return failed, error = "
+                         << mds::StatusCode_Name(statuscode)
+                         << ", filename = " << fi->fullPathName
+                         << ", log id = " << cntl->log_id();
+            LIBCURVE_ERROR errCode;
+            MDSStatusCode2LibcurveError(statuscode, &errCode);
+            return errCode;
+        }
+
+        // rpc可能重试，先清空上一次的结果
+        segInfos->clear();
+        cpinfoVec->clear();
+        for (const PageFileSegment &pfs : response.segments()) {
+            SegmentInfo segInfo;
+            segInfo.chunksize = pfs.chunksize();
+            segInfo.segmentsize = pfs.segmentsize();
+            segInfo.startoffset = pfs.startoffset();
+            segInfo.lpcpIDInfo.lpid = pfs.logicalpoolid();
+            for (const PageFileChunkInfo &chunk : pfs.chunks()) {
+                segInfo.lpcpIDInfo.cpidVec.push_back(chunk.copysetid());
+                segInfo.chunkvec.emplace_back(
+                    chunk.chunkid(), pfs.logicalpoolid(), chunk.copysetid());
+            }
+            segInfos->push_back(std::move(segInfo));
+        }
+
+        for (const SegmentCopysetInfo &info : response.copysets()) {
+            CopysetInfo<ChunkServerID> cpinfo;
+            cpinfo.lpid_ = info.logicalpoolid();
+            cpinfo.cpid_ = info.copysetid();
+            const ChunkServerLocation *leader = nullptr;
+            for (const ChunkServerLocation &csl : info.cslocs()) {
+                cpinfo.AddCopysetPeerInfo(ToCopysetPeerInfo(csl));
+                if (info.has_leaderid() &&
+                    csl.chunkserverid() == info.leaderid()) {
+                    leader = &csl;
+                }
+            }
+
+            // mds上的leader来自心跳，可能已经过期，过期时会在io路径上
+            // 被chunkserver重定向，和刷新leader的代价一样
+            if (leader != nullptr) {
+                cpinfo.UpdateLeaderInfo(
+                    ToCopysetPeerInfo(*leader).internalAddr);
+            }
+            cpinfoVec->push_back(cpinfo);
+        }
+
+        return LIBCURVE_ERROR::OK;
+    };
+    return ReturnError(
+        rpcExcutor_.DoRPCTask(task, metaServerOpt_.mdsMaxRetryMS));
+}
+
 LIBCURVE_ERROR MDSClient::RenameFile(const UserInfo_t &userinfo,
                                      const std::string &origin,
                                      const std::string &destination,
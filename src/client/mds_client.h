@@ -242,6 +242,18 @@ class MDSClient : public MDSClientBase,
     virtual LIBCURVE_ERROR DeAllocateSegment(const FInfo *fileInfo,
                                              uint64_t offset);
 
+    /**
+     * 获取文件所有已分配的segment，以及这些segment所在copyset的信息，
+     * 用于打开文件时一次性填充metacache
+     * @param: fi file info
+     * @param[out]: segInfos 已分配的segment信息
+     * @param[out]: cpinfoVec copyset的成员信息，mds知道leader时会带上leader
+     * @return: 成功返回LIBCURVE_ERROR::OK，否则返回对应的错误码
+     */
+    virtual LIBCURVE_ERROR ListSegment(
+        const FInfo_t *fi, std::vector<SegmentInfo> *segInfos,
+        std::vector<CopysetInfo<ChunkServerID>> *cpinfoVec);
+
     /**
      * Get File Info
      * @param: filename  file name
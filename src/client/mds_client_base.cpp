@@ -408,6 +408,22 @@ void MDSClientBase::GetOrAllocateSegment(bool allocate,
     stub.GetOrAllocateSegment(cntl, &request, response, NULL);
 }
 
+void MDSClientBase::ListSegment(const FInfo_t* fi,
+                                ListSegmentResponse* response,
+                                brpc::Controller* cntl,
+                                brpc::Channel* channel) {
+    ListSegmentRequest request;
+    request.set_filename(fi->fullPathName);
+    FillUserInfo(&request, fi->userinfo);
+
+    LOG(INFO) << "ListSegment: filename = " << fi->fullPathName
+              << ", owner = " << fi->owner
+              << ", log id = " << cntl->log_id();
+
+    curve::mds::CurveFSService_Stub stub(channel);
+    stub.ListSegment(cntl, &request, response, NULL);
+}
+
 void MDSClientBase::DeAllocateSegment(const FInfo* fileInfo,
                                       uint64_t segmentOffset,
                                       DeAllocateSegmentResponse* response,
@@ -73,6 +73,8 @@ using curve::mds::GetOrAllocateSegmentRequest;
 using curve::mds::GetOrAllocateSegmentResponse;
 using curve::mds::DeAllocateSegmentRequest;
 using curve::mds::DeAllocateSegmentResponse;
+using curve::mds::ListSegmentRequest;
+using curve::mds::ListSegmentResponse;
 using curve::mds::CheckSnapShotStatusRequest;
 using curve::mds::CheckSnapShotStatusResponse;
 using curve::mds::ListSnapShotFileInfoRequest;
@@ -356,6 +358,18 @@ class MDSClientBase {
                            DeAllocateSegmentResponse* response,
                            brpc::Controller* cntl, brpc::Channel* channel);
 
+    /**
+     * 获取文件所有已分配的segment，以及这些segment所在copyset的成员和leader
+     * @param: fi file info
+     * @param[out]: reponse  rpc response
+     * @param[in|out]: cntl  rpc controller
+     * @param[in]:channel  rpc channel
+     */
+    void ListSegment(const FInfo_t* fi,
+                     ListSegmentResponse* response,
+                     brpc::Controller* cntl,
+                     brpc::Channel* channel);
+
     /**
      * @brief 重名文件
      * @param:userinfo 用户信息
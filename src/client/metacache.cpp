@@ -55,6 +55,61 @@ void MetaCache::Init(const MetaCacheOption& metaCacheOpt,
     unstableHelper_.Init(metacacheopt_.chunkserverUnstableOption);
 }
 
+int MetaCache::Prefetch(const FInfo& fileInfo) {
+    const uint64_t segmentNum = fileInfo.length / fileInfo.segmentsize;
+    if (segmentNum > metacacheopt_.prefetchMaxSegments) {
+        LOG(INFO) << "skip prefetch metacache, filename = "
+                  << fileInfo.fullPathName << ", segment num = " << segmentNum
+                  << ", max segments = " << metacacheopt_.prefetchMaxSegments;
+        return -1;
+    }
+
+    std::vector<SegmentInfo> segInfos;
+    std::vector<CopysetInfo<ChunkServerID>> cpinfoVec;
+    LIBCURVE_ERROR ret =
+        mdsclient_->ListSegment(&fileInfo, &segInfos, &cpinfoVec);
+    if (ret != LIBCURVE_ERROR::OK) {
+        LOG(WARNING) << "prefetch metacache failed, filename = "
+                     << fileInfo.fullPathName << ", ret = " << ret;
+        return -1;
+    }
+
+    // 每个映射表只加一次锁
+    {
+        WriteLockGuard wrlk(rwlock4ChunkInfo_);
+        for (const auto& segInfo : segInfos) {
+            uint64_t chunkIdx = segInfo.startoffset / fileInfo.chunksize;
+            for (const auto& chunkIdInfo : segInfo.chunkvec) {
+                chunkindex2idMap_[chunkIdx++] = chunkIdInfo;
+            }
+        }
+    }
+
+    {
+        WriteLockGuard wrlk(rwlock4CSCopysetIDMap_);
+        for (const auto& cpinfo : cpinfoVec) {
+            for (const auto& peerInfo : cpinfo.csinfos_) {
+                chunkserverCopysetIDMap_[peerInfo.peerID].emplace(
+                    cpinfo.lpid_, cpinfo.cpid_);
+            }
+        }
+    }
+
+    {
+        // 已经缓存的copyset不覆盖，io路径上刷新到的leader比mds的更新
+        WriteLockGuard wrlk(rwlock4CopysetInfo_);
+        for (const auto& cpinfo : cpinfoVec) {
+            lpcsid2CopsetInfoMap_.emplace(
+                CalcLogicPoolCopysetID(cpinfo.lpid_, cpinfo.cpid_), cpinfo);
+        }
+    }
+
+    LOG(INFO) << "prefetch metacache success, filename = "
+              << fileInfo.fullPathName << ", segment num = " << segInfos.size()
+              << ", copyset num = " << cpinfoVec.size();
+    return 0;
+}
+
 MetaCacheErrorType MetaCache::GetChunkInfoByIndex(ChunkIndex chunkidx,
                                                   ChunkIDInfo* chunxinfo) {
     ReadLockGuard rdlk(rwlock4ChunkInfo_);
@@ -143,6 +198,21 @@ int MetaCache::GetLeader(LogicPoolID logicPoolId,
     return targetInfo.GetLeaderInfo(serverId, serverAddr);
 }
 
+bool MetaCache::GetCachedLeaderID(LogicPoolID logicPoolId,
+                                  CopysetID copysetId,
+                                  ChunkServerID* serverId) {
+    const auto key = CalcLogicPoolCopysetID(logicPoolId, copysetId);
+
+    ReadLockGuard rdlk(rwlock4CopysetInfo_);
+    auto iter = lpcsid2CopsetInfoMap_.find(key);
+    if (iter == lpcsid2CopsetInfoMap_.end() ||
+        !iter->second.HasValidLeader()) {
+        return false;
+    }
+
+    return iter->second.GetCurrentLeaderID(serverId);
+}
+
 int MetaCache::UpdateLeaderInternal(LogicPoolID logicPoolId,
                                     CopysetID copysetId,
                                     CopysetInfo<ChunkServerID>* toupdateCopyset,
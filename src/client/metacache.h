@@ -26,6 +26,7 @@
 #include <string>
 #include <unordered_map>
 
+#include "src/client/chunkserver_inflight_control.h"
 #include "src/client/client_common.h"
 #include "src/client/client_config.h"
 #include "src/client/client_metric.h"
@@ -73,6 +74,14 @@ class MetaCache {
      */
     void Init(const MetaCacheOption &metaCacheOpt, MDSClient *mdsclient);
 
+    /**
+     * 打开文件时从mds一次性获取所有已分配的segment，以及copyset的成员和leader，
+     * 填充到缓存中，避免之后每个segment第一次读写都要访问mds
+     * @param: fileInfo为打开的文件信息
+     * @return: 成功返回0，失败或者文件太大不做预取返回-1
+     */
+    int Prefetch(const FInfo &fileInfo);
+
     /**
      * 通过chunk index获取chunkid信息
      * @param: chunkidx以index查询chunk对应的id信息
@@ -106,6 +115,16 @@ class MetaCache {
     virtual int GetLeader(LogicPoolID logicPoolId, CopysetID copysetId,
                           ChunkServerID *serverId, butil::EndPoint *serverAddr,
                           bool refresh = false, FileMetric *fm = nullptr);
+
+    /**
+     * 只从缓存中获取copyset的leader id，不会去刷新leader
+     * @param: logicPoolId逻辑池id
+     * @param: copysetId复制组id
+     * @param: serverId为leader所在chunkserver的id，是出参
+     * @return: 缓存中有可用的leader返回true，否则返回false
+     */
+    bool GetCachedLeaderID(LogicPoolID logicPoolId, CopysetID copysetId,
+                           ChunkServerID* serverId);
     /**
      * 更新某个copyset的leader信息
      * @param logicPoolId 逻辑池id
@@ -241,6 +260,10 @@ class MetaCache {
 
     UnstableHelper &GetUnstableHelper() { return unstableHelper_; }
 
+    ChunkServerInflightControl &GetChunkServerInflightControl() {
+        return inflightControl_;
+    }
+
     uint64_t InodeId() const { return fileInfo_.id; }
 
     /**
@@ -323,6 +346,9 @@ class MetaCache {
     FileEpoch fEpoch_;
 
     UnstableHelper unstableHelper_;
+
+    // 发往每个chunkserver的inflight rpc窗口
+    ChunkServerInflightControl inflightControl_;
 };
 
 }  // namespace client
@@ -23,7 +23,9 @@
 #include "src/client/request_closure.h"
 
 #include <memory>
+#include <utility>
 
+#include "src/client/chunkserver_inflight_control.h"
 #include "src/client/io_tracker.h"
 #include "src/client/iomanager.h"
 #include "src/client/request_context.h"
@@ -52,6 +54,20 @@ void RequestClosure::ReleaseInflightRPCToken() {
         ioManager_->ReleaseInflightRpcToken();
         MetricHelper::DecremInflightRPC(metric_);
     }
+
+    if (csInflightControl_ != nullptr) {
+        ChunkServerInflightControl* control = csInflightControl_;
+        csInflightControl_ = nullptr;
+        control->ReleaseToken(csInflightId_);
+    }
+}
+
+bool RequestClosure::GetChunkServerInflightToken(
+    ChunkServerInflightControl* control, ChunkServerID csId,
+    std::function<void()> wakeup) {
+    csInflightControl_ = control;
+    csInflightId_ = csId;
+    return control->GetToken(csId, std::move(wakeup));
 }
 
 PaddingReadClosure::PaddingReadClosure(RequestContext* requestCtx,
@@ -64,6 +80,10 @@ void PaddingReadClosure::Run() {
     std::unique_ptr<PaddingReadClosure> selfGuard(this);
     std::unique_ptr<RequestContext> ctxGuard(alignedCtx_);
 
+    // 补齐读请求在调度时同样获取了inflight token，先于原始请求的处理释放，
+    // 否则窗口会被慢慢占满
+    ReleaseInflightRPCToken();
+
     const int errCode = GetErrorCode();
     if (errCode != 0) {
         HandleError(errCode);
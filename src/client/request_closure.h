@@ -26,6 +26,8 @@
 // for Closure
 #include <google/protobuf/stubs/callback.h>
 
+#include <functional>
+
 #include "include/curve_compiler_specific.h"
 #include "src/client/client_common.h"
 
@@ -34,6 +36,7 @@ namespace client {
 
 class IOTracker;
 class IOManager;
+class ChunkServerInflightControl;
 class RequestScheduler;
 struct FileMetric;
 struct RequestContext;
@@ -56,6 +59,26 @@ class CURVE_CACHELINE_ALIGNMENT RequestClosure
      */
     void ReleaseInflightRPCToken();
 
+    /**
+     * @brief Get the inflight token of the chunkserver that the rpc is sent
+     *        to, it's released together with the file inflight token
+     * @param control inflight windows of chunkservers
+     * @param csId chunkserver id
+     * @param wakeup called after the token is granted if the window is full
+     * @return true if the token is granted immediately
+     */
+    bool GetChunkServerInflightToken(ChunkServerInflightControl* control,
+                                     ChunkServerID csId,
+                                     std::function<void()> wakeup);
+
+    /**
+     * @brief Whether the chunkserver inflight token is granted, or will be
+     *        granted before the request is scheduled again
+     */
+    bool OwnChunkServerInflightToken() const {
+        return csInflightControl_ != nullptr;
+    }
+
     /**
      * @brief Get error code
      */
@@ -148,6 +171,22 @@ class CURVE_CACHELINE_ALIGNMENT RequestClosure
         return suspendRPC_;
     }
 
+    /**
+     * @brief Reset to the state of a new closure, except the request context
+     */
+    void Reset() {
+        tracker_ = nullptr;
+        suspendRPC_ = false;
+        ownInflight_ = false;
+        errcode_ = -1;
+        metric_ = nullptr;
+        retryTimes_ = 0;
+        ioManager_ = nullptr;
+        nextTimeoutMS_ = 0;
+        csInflightControl_ = nullptr;
+        csInflightId_ = 0;
+    }
+
  protected:
     // request context of this closure
     RequestContext* reqCtx_ = nullptr;
@@ -176,6 +215,10 @@ class CURVE_CACHELINE_ALIGNMENT RequestClosure
 
     // 下一次rpc超时时间
     uint64_t nextTimeoutMS_ = 0;
+
+    // 持有token的chunkserver窗口
+    ChunkServerInflightControl* csInflightControl_ = nullptr;
+    ChunkServerID csInflightId_ = 0;
 };
 
 // PaddingReadClosure is used to process unaligned request
@@ -22,10 +22,80 @@
 
 #include "src/client/request_context.h"
 
+#include <butil/object_pool.h>
+#include <glog/logging.h>
+
+#include "src/client/client_metric.h"
+
 namespace curve {
 namespace client {
 
 std::atomic<uint64_t> RequestContext::requestId(0);
 
+namespace {
+
+RequestContextPoolMetric& GetPoolMetric() {
+    static RequestContextPoolMetric metric("curve_client_request_context_pool");
+    return metric;
+}
+
+}  // namespace
+
+RequestContext* RequestContext::NewInitedRequestContext() {
+    // butil::ObjectPool caches objects per thread and moves them between
+    // threads in batches, so contexts freed in rpc callback threads can be
+    // reused by the threads issuing IO
+    RequestContext* ctx = butil::get_object<RequestContext>();
+    if (ctx == nullptr) {
+        LOG(ERROR) << "Allocate RequestContext Failed";
+        return nullptr;
+    }
+
+    if (ctx->done_ != nullptr) {
+        ctx->Reset();
+        GetPoolMetric().reuseCount << 1;
+        return ctx;
+    }
+
+    if (!ctx->Init()) {
+        LOG(ERROR) << "Init RequestContext Failed";
+        butil::return_object(ctx);
+        return nullptr;
+    }
+
+    GetPoolMetric().allocCount << 1;
+    return ctx;
+}
+
+void RequestContext::Recycle(RequestContext* ctx) {
+    // release data blocks before the context is cached
+    ctx->readData_.clear();
+    ctx->writeData_.clear();
+    butil::return_object(ctx);
+    GetPoolMetric().recycleCount << 1;
+}
+
+void RequestContext::Reset() {
+    idinfo_ = ChunkIDInfo();
+    offset_ = 0;
+    optype_ = OpType::UNKNOWN;
+    rawlength_ = 0;
+    subIoIndex_ = 0;
+    readData_.clear();
+    writeData_.clear();
+    fileId_ = 0;
+    epoch_ = 0;
+    seq_ = 0;
+    appliedindex_ = 0;
+    chunkinfodetail_ = nullptr;
+    chunksize_ = 0;
+    location_.clear();
+    sourceInfo_ = RequestSourceInfo();
+    correctedSeq_ = 0;
+    id_ = GetNextRequestContextId();
+    padding = Padding();
+    done_->Reset();
+}
+
 }  // namespace client
 }  // namespace curve
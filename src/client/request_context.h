@@ -133,21 +133,27 @@ struct CURVE_CACHELINE_ALIGNMENT RequestContext {
 
     Padding padding;
 
-    static RequestContext* NewInitedRequestContext() {
-        RequestContext* ctx = new (std::nothrow) RequestContext();
-        if (ctx && ctx->Init()) {
-            return ctx;
-        } else {
-            LOG(ERROR) << "Allocate or Init RequestContext Failed";
-            delete ctx;
-            return nullptr;
-        }
-    }
+    /**
+     * @brief Get an inited request context from the object pool, contexts
+     *        returned by Recycle() are reset and reused together with their
+     *        closure, a new one is allocated only if the pool is empty
+     */
+    static RequestContext* NewInitedRequestContext();
+
+    /**
+     * @brief Return a request context got by NewInitedRequestContext() to the
+     *        object pool
+     */
+    static void Recycle(RequestContext* ctx);
 
     static uint64_t GetNextRequestContextId() {
         return requestId.fetch_add(1, std::memory_order_relaxed);
     }
 
+ private:
+    // reset all fields to the state of a new inited request context
+    void Reset();
+
  private:
     static std::atomic<uint64_t> requestId;
 };
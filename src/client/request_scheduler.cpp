@@ -25,9 +25,12 @@
 #include <brpc/closure_guard.h>
 #include <glog/logging.h>
 
+#include <vector>
+
 #include "src/client/request_context.h"
 #include "src/client/request_closure.h"
 #include "src/client/chunk_closure.h"
+#include "src/client/metacache.h"
 
 namespace curve {
 namespace client {
@@ -61,7 +64,8 @@ int RequestScheduler::Init(const RequestScheduleOption& reqSchdulerOpt,
               << "scheduleQueueCapacity = "
               << reqschopt_.scheduleQueueCapacity
               << ", scheduleThreadpoolSize = "
-              << reqschopt_.scheduleThreadpoolSize;
+              << reqschopt_.scheduleThreadpoolSize
+              << ", scheduleBatchSize = " << reqschopt_.scheduleBatchSize;
     return 0;
 }
 
@@ -90,6 +94,8 @@ int RequestScheduler::ScheduleRequest(
     const std::vector<RequestContext*>& requests) {
     if (running_.load(std::memory_order_acquire)) {
         /* TODO(wudemiao): 后期考虑 qos */
+        std::vector<BBQItem<RequestContext*>> items;
+        items.reserve(requests.size());
         for (auto it : requests) {
             // skip the fake request
             if (!it->idinfo_.chunkExist) {
@@ -99,9 +105,11 @@ int RequestScheduler::ScheduleRequest(
                 continue;
             }
 
-            BBQItem<RequestContext *> req(it);
-            queue_.PutBack(req);
+            items.emplace_back(it);
         }
+
+        // put all sub-requests of one user request at once
+        queue_.PutBack(items.begin(), items.end());
         return 0;
     }
     return -1;
@@ -141,24 +149,35 @@ void RequestScheduler::WakeupBlockQueueAtExit() {
 }
 
 void RequestScheduler::Process() {
+    std::vector<BBQItem<RequestContext*>> items;
+    items.reserve(reqschopt_.scheduleBatchSize);
     while ((running_.load(std::memory_order_acquire) ||
             !queue_.Empty())  // flush all request in the queue
            && !stop_.load(std::memory_order_acquire)) {
         WaitValidSession();
-        BBQItem<RequestContext*> item = queue_.TakeFront();
-        if (!item.IsStop()) {
-            RequestContext* req = item.Item();
-            if (req->padding.aligned) {
-                ProcessAligned(req);
+        queue_.TakeFront(reqschopt_.scheduleBatchSize, &items);
+
+        bool stopped = false;
+        for (auto& item : items) {
+            if (!item.IsStop()) {
+                WaitValidSession();
+                RequestContext* req = item.Item();
+                if (req->padding.aligned) {
+                    ProcessAligned(req);
+                } else {
+                    ProcessUnaligned(req);
+                }
+            } else if (!stopped) {
+                /**
+                 * 一旦遇到stop item，所有线程都可以退出，因为此时
+                 * queue里面所有的request都被处理完了
+                 */
+                stopped = true;
+                stop_.store(true, std::memory_order_release);
             } else {
-                ProcessUnaligned(req);
+                // 批量取出了多个stop item，多余的还给其他线程
+                queue_.PutBack(item);
             }
-        } else {
-            /**
-             * 一旦遇到stop item，所有线程都可以退出，因为此时
-             * queue里面所有的request都被处理完了
-             */
-            stop_.store(true, std::memory_order_release);
         }
     }
 }
@@ -166,6 +185,12 @@ void RequestScheduler::Process() {
 void RequestScheduler::ProcessAligned(RequestContext* ctx) {
     brpc::ClosureGuard guard(ctx->done_);
 
+    if ((ctx->optype_ == OpType::READ || ctx->optype_ == OpType::WRITE) &&
+        !GetChunkServerInflightToken(ctx)) {
+        guard.release();
+        return;
+    }
+
     switch (ctx->optype_) {
         case OpType::READ:
             ctx->done_->GetInflightRPCToken();
@@ -207,6 +232,33 @@ void RequestScheduler::ProcessAligned(RequestContext* ctx) {
     }
 }
 
+bool RequestScheduler::GetChunkServerInflightToken(RequestContext* ctx) {
+    MetaCache* metaCache = client_.GetMetaCache();
+    ChunkServerInflightControl& control =
+        metaCache->GetChunkServerInflightControl();
+    RequestClosure* done = ctx->done_;
+    if (!control.Enabled() || done->OwnChunkServerInflightToken()) {
+        return true;
+    }
+
+    // 缓存中没有可用的leader时不做限制，由copyset client去刷新leader
+    ChunkServerID leaderId = 0;
+    if (!metaCache->GetCachedLeaderID(ctx->idinfo_.lpid_, ctx->idinfo_.cpid_,
+                                      &leaderId)) {
+        return true;
+    }
+
+    // 窗口已满时不阻塞调度线程，拿到token之后放回队列头部重新调度
+    return done->GetChunkServerInflightToken(&control, leaderId,
+                                             [this, ctx]() {
+        if (ReSchedule(ctx) != 0) {
+            LOG(ERROR) << "ReSchedule failed";
+            ctx->done_->SetFailed(-1);
+            ctx->done_->Run();
+        }
+    });
+}
+
 void RequestScheduler::ProcessUnaligned(RequestContext* ctx) {
     brpc::ClosureGuard doneGuard(ctx->done_);
     if (ctx->optype_ != OpType::READ && ctx->optype_ != OpType::WRITE) {
@@ -142,6 +142,13 @@ class RequestScheduler : public Uncopyable {
 
     void ProcessUnaligned(RequestContext* ctx);
 
+    /**
+     * 获取发往leader所在chunkserver的inflight token
+     * @return: true 获取成功或者不需要限制 / false 窗口已满，
+     *          分配到token之后请求会被重新调度
+     */
+    bool GetChunkServerInflightToken(RequestContext* ctx);
+
     void WaitValidSession() {
         // lease续约失败的时候需要阻塞IO直到续约成功
         if (blockIO_.load(std::memory_order_acquire) && blockingQueue_) {
@@ -111,6 +111,31 @@ int RequestSender::ReadChunk(const ChunkIDInfo& idinfo,
     return 0;
 }
 
+int RequestSender::ReadChunkFromFollower(const ChunkIDInfo& idinfo,
+                                         off_t offset,
+                                         size_t length,
+                                         uint64_t appliedindex,
+                                         brpc::Controller* cntl,
+                                         ChunkResponse* response,
+                                         google::protobuf::Closure* done) {
+    cntl->set_timeout_ms(iosenderopt_.failRequestOpt.chunkserverRPCTimeoutMS);
+
+    ChunkRequest request;
+    request.set_optype(curve::chunkserver::CHUNK_OP_TYPE::CHUNK_OP_READ);
+    request.set_logicpoolid(idinfo.lpid_);
+    request.set_copysetid(idinfo.cpid_);
+    request.set_chunkid(idinfo.cid_);
+    request.set_offset(offset);
+    request.set_size(length);
+    request.set_appliedindex(appliedindex);
+    request.set_followerread(true);
+
+    ChunkService_Stub stub(&channel_);
+    stub.ReadChunk(cntl, &request, response, done);
+
+    return 0;
+}
+
 int RequestSender::WriteChunk(const ChunkIDInfo& idinfo,
                               uint64_t fileId,
                               uint64_t epoch,
@@ -71,6 +71,25 @@ class RequestSender {
                   const RequestSourceInfo& sourceInfo,
                   ClientClosure *done);
 
+    /**
+     * 向follower发送hedged read，由调用方管理cntl和response，
+     * 不会更新上层请求的状态
+     * @param idinfo为chunk相关的id信息
+     * @param offset:读的偏移
+     * @param length:读的长度
+     * @param appliedindex:follower需要已经apply到appliedIndex才能直接读
+     * @param cntl:本次rpc的controller
+     * @param response:本次rpc的response
+     * @param done:rpc返回之后的回调
+     */
+    int ReadChunkFromFollower(const ChunkIDInfo& idinfo,
+                              off_t offset,
+                              size_t length,
+                              uint64_t appliedindex,
+                              brpc::Controller* cntl,
+                              ChunkResponse* response,
+                              google::protobuf::Closure* done);
+
     /**
    * 写Chunk
    * @param idinfo为chunk相关的id信息
@@ -176,6 +195,10 @@ class RequestSender {
        return channel_.CheckHealth() == 0;
     }
 
+    ChunkServerID GetChunkServerId() const {
+        return chunkServerId_;
+    }
+
  private:
     void UpdateRpcRPS(ClientClosure* done, OpType type) const;
 
@@ -0,0 +1,269 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-04-04
+ * Author: curve
+ */
+
+#include "src/client/write_coalescer.h"
+
+#include <bthread/bthread.h>
+#include <bthread/unstable.h>
+#include <butil/time.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "src/client/client_common.h"
+
+namespace curve {
+namespace client {
+
+// 合并之后的写请求，作为CurveAioContext下发，完成之后回调所有原始的写请求
+struct WriteCoalescer::PendingWrite : public CurveAioContext {
+    butil::IOBuf data;
+    std::vector<CurveAioContext*> origins;
+    // 只有一个写请求时，直接下发原始请求
+    UserDataType originType;
+};
+
+namespace {
+
+struct FlushTask {
+    WriteCoalescer* coalescer;
+    uint64_t seq;
+};
+
+}  // namespace
+
+WriteCoalescer::WriteCoalescer(const WriteCoalesceOption& opt,
+                               WriteCoalesceMetric* metric,
+                               SubmitFunc submit)
+    : option_(opt),
+      metric_(metric),
+      submit_(std::move(submit)),
+      pending_(nullptr),
+      pendingSeq_(0),
+      timers_(0),
+      stopped_(false) {}
+
+WriteCoalescer::~WriteCoalescer() {
+    Stop();
+}
+
+bool WriteCoalescer::Add(CurveAioContext* ctx, UserDataType dataType,
+                         uint64_t boundary) {
+    if (boundary == 0 || ctx->length == 0 ||
+        ctx->length > option_.maxWriteSize) {
+        return false;
+    }
+
+    const uint64_t start = ctx->offset;
+    const uint64_t end = start + ctx->length;
+    if (start / boundary != (end - 1) / boundary) {
+        return false;
+    }
+
+    butil::IOBuf data;
+    switch (dataType) {
+        case UserDataType::RawBuffer:
+            data.append_user_data(ctx->buf, ctx->length, TrivialDeleter);
+            break;
+        case UserDataType::IOBuffer:
+            data = *reinterpret_cast<const butil::IOBuf*>(ctx->buf);
+            break;
+        case UserDataType::IOVector:
+            if (AppendIOVector(static_cast<const CurveIOVector*>(ctx->buf),
+                               &data) != ctx->length) {
+                return false;
+            }
+            break;
+    }
+
+    PendingWrite* previous = nullptr;
+    PendingWrite* full = nullptr;
+    uint64_t newSeq = 0;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (stopped_) {
+            return false;
+        }
+
+        PendingWrite* write = pending_;
+        bool merge = false;
+        if (write != nullptr) {
+            const uint64_t pstart = write->offset;
+            const uint64_t pend = pstart + write->length;
+            merge = pstart / boundary == start / boundary &&
+                    start <= pend && end >= pstart &&
+                    std::max(end, pend) - std::min(start, pstart) <=
+                        option_.maxMergedSize;
+        }
+
+        if (merge) {
+            // 新写请求与等待中的请求相邻或者重叠，重叠的部分以新写请求为准
+            const uint64_t pstart = write->offset;
+            const uint64_t pend = pstart + write->length;
+            butil::IOBuf merged;
+            if (start > pstart) {
+                write->data.append_to(&merged, start - pstart, 0);
+            }
+            merged.append(data);
+            if (end < pend) {
+                write->data.append_to(&merged, pend - end, end - pstart);
+            }
+            write->data.swap(merged);
+            write->offset = std::min(start, pstart);
+            write->length = std::max(end, pend) - write->offset;
+        } else {
+            previous = TakePending();
+
+            write = new PendingWrite();
+            write->offset = ctx->offset;
+            write->length = ctx->length;
+            write->ret = 0;
+            write->op = LIBCURVE_OP_WRITE;
+            write->cb = OnMergedWriteDone;
+            write->buf = nullptr;
+            write->data.swap(data);
+            write->originType = dataType;
+
+            pending_ = write;
+            newSeq = ++pendingSeq_;
+            ++timers_;
+        }
+
+        write->origins.push_back(ctx);
+        if (write->length >= option_.maxMergedSize) {
+            full = TakePending();
+        }
+    }
+
+    metric_->userWrites << 1;
+    if (previous != nullptr) {
+        Submit(previous);
+    }
+    if (full != nullptr) {
+        Submit(full);
+    }
+    if (newSeq != 0) {
+        ScheduleFlush(newSeq);
+    }
+
+    return true;
+}
+
+void WriteCoalescer::Stop() {
+    PendingWrite* write = nullptr;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (stopped_) {
+            return;
+        }
+        stopped_ = true;
+        write = TakePending();
+    }
+
+    if (write != nullptr) {
+        Submit(write);
+    }
+
+    std::unique_lock<std::mutex> lk(mtx_);
+    cond_.wait(lk, [this]() { return timers_ == 0; });
+}
+
+WriteCoalescer::PendingWrite* WriteCoalescer::TakePending() {
+    PendingWrite* write = pending_;
+    pending_ = nullptr;
+    return write;
+}
+
+void WriteCoalescer::Submit(PendingWrite* write) {
+    metric_->mergedWrites << 1;
+
+    if (write->origins.size() == 1) {
+        CurveAioContext* origin = write->origins.front();
+        UserDataType type = write->originType;
+        delete write;
+        submit_(origin, type);
+        return;
+    }
+
+    write->buf = &write->data;
+    submit_(write, UserDataType::IOBuffer);
+}
+
+void* WriteCoalescer::RunFlushTask(void* arg) {
+    std::unique_ptr<FlushTask> task(static_cast<FlushTask*>(arg));
+    task->coalescer->FlushOnTimer(task->seq);
+    return nullptr;
+}
+
+void WriteCoalescer::OnFlushTimer(void* arg) {
+    // timer callbacks run in the single timer thread, and submitting a
+    // write may block on the task queue, so flush in another bthread
+    bthread_t tid;
+    if (bthread_start_background(&tid, nullptr, RunFlushTask, arg) != 0) {
+        RunFlushTask(arg);
+    }
+}
+
+void WriteCoalescer::ScheduleFlush(uint64_t seq) {
+    FlushTask* task = new FlushTask{this, seq};
+    bthread_timer_t timerId;
+    timespec abstime = butil::microseconds_from_now(option_.windowUS);
+    if (bthread_timer_add(&timerId, abstime, OnFlushTimer, task) != 0) {
+        LOG(WARNING) << "bthread_timer_add failed, flush coalesced write now";
+        delete task;
+        FlushOnTimer(seq);
+    }
+}
+
+void WriteCoalescer::FlushOnTimer(uint64_t seq) {
+    PendingWrite* write = nullptr;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (pending_ != nullptr && pendingSeq_ == seq) {
+            write = TakePending();
+        }
+    }
+
+    if (write != nullptr) {
+        Submit(write);
+    }
+
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (--timers_ == 0) {
+        cond_.notify_all();
+    }
+}
+
+void WriteCoalescer::OnMergedWriteDone(CurveAioContext* ctx) {
+    std::unique_ptr<PendingWrite> write(static_cast<PendingWrite*>(ctx));
+    write->data.clear();
+
+    for (CurveAioContext* origin : write->origins) {
+        origin->ret = write->ret < 0 ? write->ret
+                                     : static_cast<int>(origin->length);
+        origin->cb(origin);
+    }
+}
+
+}   // namespace client
+}   // namespace curve
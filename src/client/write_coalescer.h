@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-04-04
+ * Author: curve
+ */
+
+#ifndef SRC_CLIENT_WRITE_COALESCER_H_
+#define SRC_CLIENT_WRITE_COALESCER_H_
+
+#include <butil/iobuf.h>
+
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>               // NOLINT
+#include <vector>
+
+#include "include/client/libcurve.h"
+#include "src/client/client_metric.h"
+#include "src/client/config_info.h"
+
+namespace curve {
+namespace client {
+
+/**
+ * 写合并，将同一个chunk内相邻或者重叠的小写请求在一个很短的窗口内合并成一个
+ * 写请求下发，合并之后的请求完成时再逐个回调原始的写请求
+ *  - 同一时刻只有一个等待合并的请求，新的写请求如果不能与之合并，
+ *    就先下发等待中的请求，再开始新的合并
+ *  - 重叠的部分以后到的写请求为准
+ *  - 等待中的请求在窗口结束或者达到maxMergedSize之后下发
+ */
+class WriteCoalescer {
+ public:
+    // 下发一个写请求，合并之后的请求数据类型为IOBuffer
+    using SubmitFunc = std::function<void(CurveAioContext*, UserDataType)>;
+
+    WriteCoalescer(const WriteCoalesceOption& opt,
+                   WriteCoalesceMetric* metric,
+                   SubmitFunc submit);
+
+    ~WriteCoalescer();
+
+    /**
+     * 尝试合并一个写请求
+     * @param ctx: 用户的写请求
+     * @param dataType: 用户数据类型
+     * @param boundary: 合并之后的请求不能跨越的边界，一般为chunk大小
+     * @return: true表示请求已经交给合并流程，由合并流程负责回调，
+     *          false表示请求不能合并，需要调用方自己下发
+     */
+    bool Add(CurveAioContext* ctx, UserDataType dataType, uint64_t boundary);
+
+    /**
+     * 下发等待中的请求，并等待定时器全部退出，之后的写请求都不再合并
+     */
+    void Stop();
+
+ private:
+    struct PendingWrite;
+
+    // 取出等待中的请求，调用方需要持有锁
+    PendingWrite* TakePending();
+
+    void Submit(PendingWrite* write);
+
+    void ScheduleFlush(uint64_t seq);
+
+    void FlushOnTimer(uint64_t seq);
+
+    static void OnFlushTimer(void* arg);
+
+    static void* RunFlushTask(void* arg);
+
+    static void OnMergedWriteDone(CurveAioContext* ctx);
+
+ private:
+    WriteCoalesceOption option_;
+    WriteCoalesceMetric* metric_;
+    SubmitFunc submit_;
+
+    std::mutex mtx_;
+    std::condition_variable cond_;
+    PendingWrite* pending_;
+    // 每个等待中的请求的序号，定时器用它判断请求是否已经被下发
+    uint64_t pendingSeq_;
+    // 还没有退出的定时器数量
+    uint32_t timers_;
+    bool stopped_;
+};
+
+}   // namespace client
+}   // namespace curve
+
+#endif  // SRC_CLIENT_WRITE_COALESCER_H_
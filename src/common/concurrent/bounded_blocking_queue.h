@@ -30,6 +30,7 @@
 #include <mutex>                //NOLINT
 #include <atomic>
 #include <utility>
+#include <vector>
 
 #include "src/common/uncopyable.h"
 
@@ -109,6 +110,24 @@ class BoundedBlockingDeque : public Uncopyable {
         notEmpty_.notify_one();
     }
 
+    /**
+     * 将 [first, last) 一次性放入队尾，队列满时等待，
+     * 减少逐个入队时的加锁和唤醒开销
+     */
+    template <typename Iter>
+    void PutBack(Iter first, Iter last) {
+        std::unique_lock<std::mutex> guard(mutex_);
+        while (first != last) {
+            while (deque_.size() == capacity_) {
+                notFull_.wait(guard);
+            }
+            for (; first != last && deque_.size() < capacity_; ++first) {
+                deque_.push_back(*first);
+            }
+            notEmpty_.notify_all();
+        }
+    }
+
     T TakeFront() {
         std::unique_lock<std::mutex> guard(mutex_);
         while (deque_.empty()) {
@@ -120,6 +139,24 @@ class BoundedBlockingDeque : public Uncopyable {
         return front;
     }
 
+    /**
+     * 从队头一次取出至多 maxCount 个元素，队列为空时等待
+     * @return 取出的元素个数
+     */
+    size_t TakeFront(size_t maxCount, std::vector<T>* items) {
+        items->clear();
+        std::unique_lock<std::mutex> guard(mutex_);
+        while (deque_.empty()) {
+            notEmpty_.wait(guard);
+        }
+        do {
+            items->push_back(std::move(deque_.front()));
+            deque_.pop_front();
+        } while (!deque_.empty() && items->size() < maxCount);
+        notFull_.notify_all();
+        return items->size();
+    }
+
     T TakeBack() {
         std::unique_lock<std::mutex> guard(mutex_);
         while (deque_.empty()) {
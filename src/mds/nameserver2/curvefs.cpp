@@ -45,6 +45,8 @@ using curve::mds::topology::LogicalPoolIdType;
 using curve::mds::topology::PhysicalPool;
 using curve::mds::topology::PhysicalPoolIdType;
 using curve::mds::topology::CopySetIdType;
+using curve::mds::topology::CopySetInfo;
+using curve::mds::topology::CopySetKey;
 using curve::mds::topology::ChunkServer;
 using curve::mds::topology::ChunkServerStatus;
 using curve::mds::topology::OnlineState;
@@ -1324,6 +1326,69 @@ StatusCode CurveFS::GetOrAllocateSegment(const std::string & filename,
     }
 }
 
+StatusCode CurveFS::ListSegment(const std::string& filename,
+    std::vector<PageFileSegment>* segments,
+    ::google::protobuf::RepeatedPtrField<SegmentCopysetInfo>* copysets) {
+    assert(segments != nullptr);
+    assert(copysets != nullptr);
+
+    FileInfo fileInfo;
+    auto ret = GetFileInfo(filename, &fileInfo);
+    if (ret != StatusCode::kOK) {
+        LOG(INFO) << "get source file error, errCode = " << ret;
+        return ret;
+    }
+
+    if (fileInfo.filetype() != FileType::INODE_PAGEFILE) {
+        LOG(INFO) << "not pageFile, can't do this";
+        return StatusCode::kParaError;
+    }
+
+    if (storage_->ListSegment(fileInfo.id(), segments) != StoreStatus::OK) {
+        LOG(ERROR) << "ListSegment fail, fileInfo.id() = " << fileInfo.id();
+        return StatusCode::kStorageError;
+    }
+
+    // segments of a file share copysets, only return each copyset once
+    std::set<CopySetKey> keys;
+    for (const auto& segment : *segments) {
+        for (const auto& chunk : segment.chunks()) {
+            keys.emplace(segment.logicalpoolid(), chunk.copysetid());
+        }
+    }
+
+    for (const auto& key : keys) {
+        CopySetInfo csInfo;
+        if (!topology_->GetCopySet(key, &csInfo)) {
+            LOG(ERROR) << "ListSegment get copyset fail, logicalPoolId = "
+                       << key.first << ", copysetId = " << key.second;
+            return StatusCode::KInternalError;
+        }
+
+        SegmentCopysetInfo* info = copysets->Add();
+        info->set_logicalpoolid(key.first);
+        info->set_copysetid(key.second);
+        for (ChunkServerIdType csId : csInfo.GetCopySetMembers()) {
+            ChunkServer cs;
+            if (!topology_->GetChunkServer(csId, &cs)) {
+                LOG(ERROR) << "ListSegment get chunkserver fail, id = "
+                           << csId;
+                return StatusCode::KInternalError;
+            }
+            ChunkServerLocation* csLoc = info->add_cslocs();
+            csLoc->set_chunkserverid(csId);
+            csLoc->set_hostip(cs.GetHostIp());
+            csLoc->set_port(cs.GetPort());
+            csLoc->set_externalip(cs.GetExternalHostIp());
+        }
+        if (csInfo.GetLeader() != topology::UNINTIALIZE_ID) {
+            info->set_leaderid(csInfo.GetLeader());
+        }
+    }
+
+    return StatusCode::kOK;
+}
+
 StatusCode CurveFS::DeAllocateSegment(const std::string& fileName,
                                       uint64_t offset) {
     FileInfo fileInfo;
@@ -308,6 +308,18 @@ class CurveFS {
      */
     StatusCode DeAllocateSegment(const std::string& filename, uint64_t offset);
 
+    /**
+     * @brief list all allocated segments of the file, together with the
+     *        members and leader of the copysets these segments use
+     * @param filename
+     * @param[out] segments: allocated segments of the file
+     * @param[out] copysets: copysets used by the segments
+     * @return On success, return StatusCode::kOK
+     */
+    StatusCode ListSegment(const std::string& filename,
+        std::vector<PageFileSegment>* segments,
+        ::google::protobuf::RepeatedPtrField<SegmentCopysetInfo>* copysets);
+
     /**
      *  @brief get the root file info
      *  @param
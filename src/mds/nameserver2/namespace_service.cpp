@@ -583,6 +583,85 @@ void NameSpaceService::DeAllocateSegment(
     return;
 }
 
+void NameSpaceService::ListSegment(
+    ::google::protobuf::RpcController* controller,
+    const ::curve::mds::ListSegmentRequest* request,
+    ::curve::mds::ListSegmentResponse* response,
+    ::google::protobuf::Closure* done) {
+    brpc::ClosureGuard doneGuard(done);
+    brpc::Controller* cntl = static_cast<brpc::Controller*>(controller);
+    ExpiredTime expiredTime;
+
+    if (!isPathValid(request->filename())) {
+        response->set_statuscode(StatusCode::kParaError);
+        LOG(ERROR) << "logid = " << cntl->log_id()
+                   << ", ListSegment request path is invalid, filename = "
+                   << request->filename();
+        return;
+    }
+
+    LOG(INFO) << "logid = " << cntl->log_id()
+              << ", ListSegment request, filename = " << request->filename();
+
+    FileReadLockGuard guard(fileLockManager_, request->filename());
+
+    std::string signature;
+    if (request->has_signature()) {
+        signature = request->signature();
+    }
+
+    StatusCode retCode;
+    retCode = kCurveFS.CheckFileOwner(request->filename(), request->owner(),
+                                      signature, request->date());
+    if (retCode != StatusCode::kOK) {
+        response->set_statuscode(retCode);
+        if (google::ERROR != GetMdsLogLevel(retCode)) {
+            LOG(WARNING) << "logid = " << cntl->log_id()
+                << ", CheckFileOwner fail, filename = " <<  request->filename()
+                << ", owner = " << request->owner()
+                << ", statusCode = " << retCode;
+        } else {
+            LOG(ERROR) << "logid = " << cntl->log_id()
+                << ", CheckFileOwner fail, filename = " <<  request->filename()
+                << ", owner = " << request->owner()
+                << ", statusCode = " << retCode;
+        }
+        return;
+    }
+
+    std::vector<PageFileSegment> segments;
+    retCode = kCurveFS.ListSegment(request->filename(), &segments,
+                                   response->mutable_copysets());
+    if (retCode != StatusCode::kOK) {
+        response->set_statuscode(retCode);
+        if (google::ERROR != GetMdsLogLevel(retCode)) {
+            LOG(WARNING) << "logid = " << cntl->log_id()
+                << ", ListSegment fail, filename = " << request->filename()
+                << ", statusCode = " << retCode
+                << ", StatusCode_Name = " << StatusCode_Name(retCode)
+                << ", cost " << expiredTime.ExpiredMs() << " ms";
+        } else {
+            LOG(ERROR) << "logid = " << cntl->log_id()
+                << ", ListSegment fail, filename = " << request->filename()
+                << ", statusCode = " << retCode
+                << ", StatusCode_Name = " << StatusCode_Name(retCode)
+                << ", cost " << expiredTime.ExpiredMs() << " ms";
+        }
+        response->clear_copysets();
+        return;
+    }
+
+    response->set_statuscode(StatusCode::kOK);
+    for (auto& segment : segments) {
+        response->add_segments()->Swap(&segment);
+    }
+    LOG(INFO) << "logid = " << cntl->log_id()
+              << ", ListSegment ok, filename = " << request->filename()
+              << ", segment num = " << response->segments_size()
+              << ", copyset num = " << response->copysets_size()
+              << ", cost " << expiredTime.ExpiredMs() << " ms";
+}
+
 void NameSpaceService::RenameFile(::google::protobuf::RpcController* controller,
                          const ::curve::mds::RenameFileRequest* request,
                          ::curve::mds::RenameFileResponse* response,
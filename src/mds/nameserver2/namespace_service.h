@@ -102,6 +102,11 @@ class NameSpaceService: public CurveFSService {
         ::curve::mds::DeAllocateSegmentResponse* response,
         ::google::protobuf::Closure* done) override;
 
+    void ListSegment(::google::protobuf::RpcController* controller,
+                     const ::curve::mds::ListSegmentRequest* request,
+                     ::curve::mds::ListSegmentResponse* response,
+                     ::google::protobuf::Closure* done) override;
+
     void RenameFile(::google::protobuf::RpcController* controller,
                        const ::curve::mds::RenameFileRequest* request,
                        ::curve::mds::RenameFileResponse* response,
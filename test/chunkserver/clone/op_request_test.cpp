@@ -689,6 +689,81 @@ TEST_F(OpRequestTest, ReadChunkTest) {
         ASSERT_TRUE(closure->isDone_);
         delete[] chunkData;
     }
+    /**
+     * 测试Process
+     * 用例： node_->IsLeaderTerm() == false, 请求允许 follower read,
+     *       请求的 apply index 小于等于 node的 apply index
+     * 预期： 不会转发请求，由 follower 直接读本地chunk
+     */
+    {
+        // 重置closure
+        closure->Reset();
+
+        request->set_appliedindex(3);
+        request->set_followerread(true);
+
+        // 设置预期
+        EXPECT_CALL(*node_, IsLeaderTerm())
+            .WillRepeatedly(Return(false));
+        EXPECT_CALL(*node_, Propose(_))
+            .Times(0);
+
+        info.isClone = false;
+        EXPECT_CALL(*datastore_, GetChunkInfo(_, _))
+            .WillOnce(
+                DoAll(SetArgPointee<1>(info), Return(CSErrorCode::Success)));
+
+        char *chunkData = new char[length];
+        memset(chunkData, 'a', length);
+        EXPECT_CALL(*datastore_, ReadChunk(_, _, _, offset, length))
+            .WillOnce(DoAll(SetArrayArgument<2>(chunkData, chunkData + length),
+                            Return(CSErrorCode::Success)));
+        EXPECT_CALL(*node_, UpdateAppliedIndex(_)).Times(1);
+
+        opReq->Process();
+
+        int retry = 10;
+        while (retry-- > 0) {
+            if (closure->isDone_) {
+                break;
+            }
+
+            ::sleep(1);
+        }
+
+        ASSERT_TRUE(closure->isDone_);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  closure->response_->status());
+        delete[] chunkData;
+    }
+    /**
+     * 测试Process
+     * 用例： node_->IsLeaderTerm() == false, 请求允许 follower read,
+     *       请求的 apply index 大于 node的 apply index
+     * 预期： follower 数据可能落后，要求转发请求，返回CHUNK_OP_STATUS_REDIRECTED
+     */
+    {
+        // 重置closure
+        closure->Reset();
+
+        request->set_appliedindex(LAST_INDEX + 1);
+
+        // 设置预期
+        EXPECT_CALL(*node_, Propose(_))
+            .Times(0);
+
+        opReq->Process();
+
+        // 验证结果
+        ASSERT_TRUE(closure->isDone_);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED,
+                  closure->response_->status());
+
+        request->clear_followerread();
+        request->set_appliedindex(3);
+        EXPECT_CALL(*node_, IsLeaderTerm())
+            .WillRepeatedly(Return(true));
+    }
 
     /**
      * 测试OnApply
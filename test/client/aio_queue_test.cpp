@@ -0,0 +1,174 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-04-05
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "src/client/aio_queue.h"
+
+namespace curve {
+namespace client {
+
+namespace {
+
+CurveAioQueueRequest MakeRequest(LIBCURVE_OP op, off_t offset,
+                                 size_t length) {
+    CurveAioQueueRequest req;
+    req.op = op;
+    req.offset = offset;
+    req.length = length;
+    req.buf = nullptr;
+    req.vectored = 0;
+    req.userdata = nullptr;
+    req.ret = -1;
+    return req;
+}
+
+bool EventFdReadable(int fd) {
+    struct pollfd pfd = {fd, POLLIN, 0};
+    return ::poll(&pfd, 1, 0) == 1;
+}
+
+}  // namespace
+
+class AioQueueTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        queue_.reset(new AioQueue(
+            4, [this](int fd, CurveAioContext* ctx, UserDataType type) {
+                submittedFd_ = fd;
+                submittedType_ = type;
+                if (submitError_ != 0) {
+                    return submitError_;
+                }
+                pending_.push_back(ctx);
+                return static_cast<int>(LIBCURVE_ERROR::OK);
+            }));
+        ASSERT_EQ(0, queue_->Init());
+    }
+
+    void CompleteAll(int ret) {
+        std::vector<CurveAioContext*> pending;
+        pending.swap(pending_);
+        for (auto* ctx : pending) {
+            ctx->ret = ret < 0 ? ret : static_cast<int>(ctx->length);
+            ctx->cb(ctx);
+        }
+    }
+
+    std::unique_ptr<AioQueue> queue_;
+    std::vector<CurveAioContext*> pending_;
+    int submittedFd_ = -1;
+    UserDataType submittedType_ = UserDataType::IOBuffer;
+    int submitError_ = 0;
+};
+
+TEST_F(AioQueueTest, SubmitAndPoll) {
+    CurveAioQueueRequest r1 = MakeRequest(LIBCURVE_OP_READ, 0, 4096);
+    CurveAioQueueRequest r2 = MakeRequest(LIBCURVE_OP_WRITE, 4096, 8192);
+    r2.vectored = 1;
+    CurveAioQueueRequest* reqs[] = {&r1, &r2};
+
+    ASSERT_EQ(1, queue_->Submit(3, reqs, 1));
+    ASSERT_EQ(3, submittedFd_);
+    ASSERT_EQ(UserDataType::RawBuffer, submittedType_);
+    ASSERT_EQ(1, queue_->Submit(3, reqs + 1, 1));
+    ASSERT_EQ(UserDataType::IOVector, submittedType_);
+    ASSERT_EQ(2, pending_.size());
+    ASSERT_EQ(2, queue_->Size());
+    ASSERT_FALSE(EventFdReadable(queue_->EventFd()));
+
+    CurveAioQueueRequest* done[4];
+    ASSERT_EQ(0, queue_->Poll(done, 4));
+
+    // completions run in other threads, like brpc/bthread workers
+    std::thread([this]() { CompleteAll(0); }).join();
+    ASSERT_TRUE(EventFdReadable(queue_->EventFd()));
+    uint64_t value = 0;
+    ASSERT_EQ(sizeof(value), ::read(queue_->EventFd(), &value, sizeof(value)));
+    ASSERT_EQ(1, value);
+
+    ASSERT_EQ(1, queue_->Poll(done, 1));
+    ASSERT_EQ(&r1, done[0]);
+    ASSERT_EQ(4096, r1.ret);
+    ASSERT_EQ(1, queue_->Poll(done, 4));
+    ASSERT_EQ(&r2, done[0]);
+    ASSERT_EQ(8192, r2.ret);
+    ASSERT_EQ(0, queue_->Size());
+}
+
+TEST_F(AioQueueTest, QueueFull) {
+    std::vector<CurveAioQueueRequest> reqs;
+    for (int i = 0; i < 6; ++i) {
+        reqs.push_back(MakeRequest(LIBCURVE_OP_READ, i * 4096, 4096));
+    }
+    std::vector<CurveAioQueueRequest*> ptrs;
+    for (auto& req : reqs) {
+        ptrs.push_back(&req);
+    }
+
+    ASSERT_EQ(4, queue_->Submit(1, ptrs.data(), 6));
+    ASSERT_EQ(0, queue_->Submit(1, ptrs.data() + 4, 2));
+
+    // completed but not polled requests still occupy the queue
+    CompleteAll(0);
+    ASSERT_EQ(0, queue_->Submit(1, ptrs.data() + 4, 2));
+
+    CurveAioQueueRequest* done[4];
+    ASSERT_EQ(2, queue_->Poll(done, 2));
+    ASSERT_EQ(2, queue_->Submit(1, ptrs.data() + 4, 2));
+    CompleteAll(-LIBCURVE_ERROR::FAILED);
+
+    ASSERT_EQ(4, queue_->Poll(done, 4));
+    ASSERT_EQ(&reqs[2], done[0]);
+    ASSERT_EQ(&reqs[3], done[1]);
+    ASSERT_EQ(&reqs[4], done[2]);
+    ASSERT_EQ(-LIBCURVE_ERROR::FAILED, reqs[5].ret);
+}
+
+TEST_F(AioQueueTest, SubmitFailed) {
+    CurveAioQueueRequest r1 = MakeRequest(LIBCURVE_OP_READ, 0, 4096);
+    CurveAioQueueRequest r2 = MakeRequest(LIBCURVE_OP_READ, 4096, 4096);
+    CurveAioQueueRequest* reqs[] = {&r1, &r2};
+
+    submitError_ = -LIBCURVE_ERROR::BAD_FD;
+    ASSERT_EQ(-LIBCURVE_ERROR::BAD_FD, queue_->Submit(1, reqs, 2));
+    ASSERT_EQ(0, queue_->Size());
+
+    // zero length request completes without submitting
+    CurveAioQueueRequest empty = MakeRequest(LIBCURVE_OP_WRITE, 0, 0);
+    CurveAioQueueRequest* emptyReqs[] = {&empty, &r1};
+    ASSERT_EQ(1, queue_->Submit(1, emptyReqs, 2));
+    ASSERT_TRUE(EventFdReadable(queue_->EventFd()));
+
+    CurveAioQueueRequest* done[4];
+    ASSERT_EQ(1, queue_->Poll(done, 4));
+    ASSERT_EQ(&empty, done[0]);
+    ASSERT_EQ(0, empty.ret);
+}
+
+}  // namespace client
+}  // namespace curve
@@ -0,0 +1,191 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-04-05
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "src/client/chunkserver_inflight_control.h"
+#include "src/client/request_closure.h"
+#include "test/client/mock/mock_request_context.h"
+
+namespace curve {
+namespace client {
+
+namespace {
+
+ChunkServerInflightOption MakeOption(uint32_t init, uint32_t min,
+                                     uint32_t max) {
+    ChunkServerInflightOption opt;
+    opt.enable = true;
+    opt.initWindow = init;
+    opt.minWindow = min;
+    opt.maxWindow = max;
+    opt.latencyRatio = 2.0;
+    opt.decreaseFactor = 0.5;
+    return opt;
+}
+
+}  // namespace
+
+TEST(ChunkServerInflightControlTest, WaitForToken) {
+    ChunkServerInflightControl control;
+    control.Init(MakeOption(2, 1, 4), "WaitForToken");
+    ASSERT_TRUE(control.Enabled());
+
+    int woken = 0;
+    auto wakeup = [&woken]() { ++woken; };
+    ASSERT_TRUE(control.GetToken(1, wakeup));
+    ASSERT_TRUE(control.GetToken(1, wakeup));
+    ASSERT_FALSE(control.GetToken(1, wakeup));
+    ASSERT_FALSE(control.GetToken(1, wakeup));
+    ASSERT_EQ(2, control.GetInflight(1));
+
+    // 其他chunkserver不受影响
+    ASSERT_TRUE(control.GetToken(2, wakeup));
+
+    // token直接交给等待的请求，inflight数量不变
+    control.ReleaseToken(1);
+    ASSERT_EQ(1, woken);
+    ASSERT_EQ(2, control.GetInflight(1));
+
+    control.ReleaseToken(1);
+    control.ReleaseToken(1);
+    ASSERT_EQ(2, woken);
+    ASSERT_EQ(1, control.GetInflight(1));
+
+    // 没有等待的请求之后可以直接获取
+    ASSERT_TRUE(control.GetToken(1, wakeup));
+    ASSERT_EQ(2, woken);
+}
+
+TEST(ChunkServerInflightControlTest, AdjustByLatency) {
+    ChunkServerInflightControl control;
+    control.Init(MakeOption(4, 2, 5), "AdjustByLatency");
+
+    // 一轮为窗口大小个回复，延迟正常时窗口加1，不超过最大值
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(4, control.GetWindow(1));
+        control.OnResponse(1, 100);
+    }
+    ASSERT_EQ(5, control.GetWindow(1));
+    for (int i = 0; i < 5; ++i) {
+        control.OnResponse(1, 120);
+    }
+    ASSERT_EQ(5, control.GetWindow(1));
+
+    // 一轮中的最小延迟超过基准延迟2倍，窗口减半，不小于最小值
+    control.OnResponse(1, 1000);
+    control.OnResponse(1, 1000);
+    control.OnResponse(1, 1000);
+    control.OnResponse(1, 1000);
+    control.OnResponse(1, 300);
+    ASSERT_EQ(2, control.GetWindow(1));
+}
+
+TEST(ChunkServerInflightControlTest, CongestedAndUnstable) {
+    ChunkServerInflightControl control;
+    control.Init(MakeOption(16, 2, 32), "CongestedAndUnstable");
+
+    // 每轮最多因为超时减小一次
+    control.OnCongested(1);
+    ASSERT_EQ(8, control.GetWindow(1));
+    control.OnCongested(1);
+    ASSERT_EQ(8, control.GetWindow(1));
+
+    // 这一轮已经减小过，结束时不再增大
+    for (int i = 0; i < 8; ++i) {
+        control.OnResponse(1, 100);
+    }
+    ASSERT_EQ(8, control.GetWindow(1));
+    control.OnCongested(1);
+    ASSERT_EQ(4, control.GetWindow(1));
+
+    control.OnUnstable(1);
+    ASSERT_EQ(2, control.GetWindow(1));
+}
+
+TEST(ChunkServerInflightControlTest, Disabled) {
+    ChunkServerInflightControl control;
+    ChunkServerInflightOption opt = MakeOption(4, 2, 8);
+    opt.enable = false;
+    control.Init(opt, "Disabled");
+    ASSERT_FALSE(control.Enabled());
+
+    control.OnCongested(1);
+    control.OnUnstable(1);
+    ASSERT_EQ(4, control.GetWindow(1));
+}
+
+TEST(ChunkServerInflightControlTest, PaddingReadReleaseToken) {
+    ChunkServerInflightControl control;
+    control.Init(MakeOption(1, 1, 1), "PaddingReadReleaseToken");
+
+    // 未对齐的读请求，调度时先发出对齐的补齐读
+    auto newUnalignedRead = []() {
+        RequestContext* ctx = new RequestContext();
+        ctx->optype_ = OpType::READ;
+        ctx->offset_ = 512;
+        ctx->rawlength_ = 512;
+        ctx->padding.aligned = false;
+        ctx->padding.offset = 0;
+        ctx->padding.length = 4096;
+        ctx->done_ = new FakeRequestClosure(nullptr, ctx);
+        return ctx;
+    };
+
+    int woken = 0;
+    auto wakeup = [&woken]() { ++woken; };
+
+    // 补齐读失败
+    {
+        std::unique_ptr<RequestContext> ctx(newUnalignedRead());
+        std::unique_ptr<RequestClosure> done(ctx->done_);
+        auto* padding = new PaddingReadClosure(ctx.get(), nullptr);
+        ASSERT_TRUE(padding->GetChunkServerInflightToken(&control, 1, wakeup));
+        ASSERT_EQ(1, control.GetInflight(1));
+
+        padding->SetFailed(-1);
+        padding->Run();
+        ASSERT_EQ(0, control.GetInflight(1));
+        ASSERT_EQ(-1, done->GetErrorCode());
+    }
+
+    // 补齐读成功返回，窗口已满时等待的请求拿到token
+    {
+        std::unique_ptr<RequestContext> ctx(newUnalignedRead());
+        std::unique_ptr<RequestClosure> done(ctx->done_);
+        auto* padding = new PaddingReadClosure(ctx.get(), nullptr);
+        ASSERT_TRUE(padding->GetChunkServerInflightToken(&control, 1, wakeup));
+        ASSERT_FALSE(control.GetToken(1, wakeup));
+
+        padding->SetFailed(0);
+        padding->Run();
+        ASSERT_EQ(1, woken);
+        ASSERT_EQ(1, control.GetInflight(1));
+        control.ReleaseToken(1);
+        ASSERT_EQ(0, control.GetInflight(1));
+    }
+}
+
+}  // namespace client
+}  // namespace curve
@@ -22,6 +22,8 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include "src/client/client_common.h"
 
 namespace curve {
@@ -71,5 +73,36 @@ TEST(ClientCommon, PeerAddrTest) {
     ASSERT_EQ(caddr2.addr_, ep1);
 }
 
+TEST(ClientCommon, IOVectorTest) {
+    char seg1[] = "hello";
+    char seg2[] = "curve";
+    struct iovec iov[3];
+    iov[0].iov_base = seg1;
+    iov[0].iov_len = 5;
+    iov[1].iov_base = nullptr;
+    iov[1].iov_len = 0;
+    iov[2].iov_base = seg2;
+    iov[2].iov_len = 5;
+    CurveIOVector vec{iov, 3};
+
+    // 写请求直接引用用户内存
+    butil::IOBuf data;
+    ASSERT_EQ(10, AppendIOVector(&vec, &data));
+    ASSERT_EQ("hellocurve", data.to_string());
+
+    // 读请求的数据依次填到用户iovec中
+    butil::IOBuf readData;
+    readData.append("0123456789");
+    ASSERT_EQ(10, CutToIOVector(&readData, &vec));
+    ASSERT_EQ("01234", std::string(seg1, 5));
+    ASSERT_EQ("56789", std::string(seg2, 5));
+    ASSERT_TRUE(readData.empty());
+
+    // 数据不足时返回实际拷贝的长度
+    readData.append("abc");
+    ASSERT_EQ(3, CutToIOVector(&readData, &vec));
+    ASSERT_EQ("abc34", std::string(seg1, 5));
+}
+
 }  // namespace client
 }  // namespace curve
@@ -26,6 +26,7 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <atomic>
 #include <thread>   //NOLINT
 #include <chrono>   // NOLINT
 
@@ -40,6 +41,7 @@
 #include "test/client/mock/mock_request_scheduler.h"
 #include "src/client/request_closure.h"
 #include "src/client/metacache.h"
+#include "src/client/hedged_read.h"
 
 namespace curve {
 namespace client {
@@ -1701,6 +1703,187 @@ TEST_F(CopysetClientTest, read_error_test) {
     scheduler.Fini();
 }
 
+namespace {
+
+// 延迟一段时间后返回读请求，用于控制leader和follower回包的先后顺序
+struct DelayedReadChunk {
+    uint32_t delayMS;
+    char fill;
+
+    void operator()(::google::protobuf::RpcController *controller,
+                    const ::curve::chunkserver::ChunkRequest *request,
+                    ::curve::chunkserver::ChunkResponse *response,
+                    google::protobuf::Closure *done) const {
+        brpc::ClosureGuard doneGuard(done);
+        std::this_thread::sleep_for(std::chrono::milliseconds(delayMS));
+        brpc::Controller *cntl = dynamic_cast<brpc::Controller *>(controller);
+        cntl->response_attachment().resize(request->size(), fill);
+    }
+};
+
+class HedgedReadRequestClosure : public RequestClosure {
+ public:
+    HedgedReadRequestClosure(curve::common::CountDownEvent *cond,
+                             RequestContext *reqctx,
+                             std::atomic<int> *runs)
+        : RequestClosure(reqctx), cond_(cond), runs_(runs) {}
+
+    void Run() override {
+        ReleaseInflightRPCToken();
+        runs_->fetch_add(1);
+        cond_->Signal();
+    }
+
+ private:
+    curve::common::CountDownEvent *cond_;
+    std::atomic<int> *runs_;
+};
+
+}  // namespace
+
+/**
+ * leader和hedged read都返回时，只有先返回的一方结束用户请求
+ */
+TEST_F(CopysetClientTest, hedged_read_race_test) {
+    MockChunkServiceImpl leaderService;
+    ASSERT_EQ(server_->AddService(&leaderService,
+                                  brpc::SERVER_DOESNT_OWN_SERVICE), 0);
+    ASSERT_EQ(server_->Start(listenAddr_.c_str(), nullptr), 0);
+
+    MockChunkServiceImpl followerService;
+    brpc::Server followerServer;
+    std::string followerStr = "127.0.0.1:9110";
+    ASSERT_EQ(followerServer.AddService(&followerService,
+                                        brpc::SERVER_DOESNT_OWN_SERVICE), 0);
+    ASSERT_EQ(followerServer.Start(followerStr.c_str(), nullptr), 0);
+
+    IOSenderOption ioSenderOpt;
+    ioSenderOpt.failRequestOpt.chunkserverRPCTimeoutMS = 5000;
+    ioSenderOpt.failRequestOpt.chunkserverOPMaxRetry = 3;
+    ioSenderOpt.failRequestOpt.chunkserverOPRetryIntervalUS = 500;
+    ioSenderOpt.chunkserverEnableAppliedIndexRead = 1;
+    ioSenderOpt.hedgedReadOpt.enable = true;
+    ioSenderOpt.hedgedReadOpt.minDelayUS = 1000;
+    ioSenderOpt.hedgedReadOpt.maxDelayUS = 1000;
+
+    RequestScheduleOption reqopt;
+    reqopt.ioSenderOpt = ioSenderOpt;
+
+    CopysetClient copysetClient;
+    MockMetaCache mockMetaCache;
+    mockMetaCache.DelegateToFake();
+
+    ChunkServerInflightOption inflightOpt;
+    inflightOpt.enable = true;
+    ChunkServerInflightControl &inflightControl =
+        mockMetaCache.GetChunkServerInflightControl();
+    inflightControl.Init(inflightOpt, "hedged_read_race_test");
+
+    RequestScheduler scheduler;
+    scheduler.Init(reqopt, &mockMetaCache);
+    scheduler.Run();
+
+    copysetClient.Init(&mockMetaCache, ioSenderOpt, &scheduler);
+
+    LogicPoolID logicPoolId = 1;
+    CopysetID copysetId = 100001;
+    ChunkID chunkId = 1;
+    uint64_t sn = 1;
+    size_t len = 8;
+
+    ChunkServerID leaderId = 10000;
+    butil::EndPoint leaderAddr;
+    butil::str2endpoint(listenAddr_.c_str(), &leaderAddr);
+    ChunkServerID followerId = 10001;
+    butil::EndPoint followerAddr;
+    butil::str2endpoint(followerStr.c_str(), &followerAddr);
+
+    CopysetInfo<ChunkServerID> cpinfo;
+    cpinfo.AddCopysetPeerInfo(CopysetPeerInfo<ChunkServerID>(
+        leaderId, PeerAddr(leaderAddr), PeerAddr(leaderAddr)));
+    cpinfo.AddCopysetPeerInfo(CopysetPeerInfo<ChunkServerID>(
+        followerId, PeerAddr(followerAddr), PeerAddr(followerAddr)));
+    mockMetaCache.UpdateCopysetInfo(logicPoolId, copysetId, cpinfo);
+
+    EXPECT_CALL(mockMetaCache, GetLeader(_, _, _, _, _, _))
+        .WillRepeatedly(DoAll(SetArgPointee<2>(leaderId),
+                              SetArgPointee<3>(leaderAddr),
+                              Return(0)));
+
+    FileMetric fm("test");
+    IOTracker iot(nullptr, nullptr, nullptr, &fm);
+    iot.PrepareReadIOBuffers(1);
+
+    ChunkResponse response;
+    response.set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+    response.set_appliedindex(1);
+
+    HedgedReadMetric &metric = GetHedgedReadMetric();
+
+    auto runRace = [&](uint32_t leaderDelayMS, uint32_t followerDelayMS,
+                       char expected) {
+        RequestContext *reqCtx = new FakeRequestContext();
+        reqCtx->optype_ = OpType::READ;
+        reqCtx->idinfo_ = ChunkIDInfo(chunkId, logicPoolId, copysetId);
+        reqCtx->subIoIndex_ = 0;
+        reqCtx->offset_ = 0;
+        reqCtx->rawlength_ = len;
+
+        std::atomic<int> runs(0);
+        curve::common::CountDownEvent cond(1);
+        RequestClosure *reqDone =
+            new HedgedReadRequestClosure(&cond, reqCtx, &runs);
+        reqDone->SetFileMetric(&fm);
+        reqDone->SetIOTracker(&iot);
+        reqCtx->done_ = reqDone;
+        ASSERT_TRUE(reqDone->GetChunkServerInflightToken(
+            &inflightControl, leaderId, []() {}));
+        ASSERT_EQ(1, inflightControl.GetInflight(leaderId));
+
+        EXPECT_CALL(leaderService, ReadChunk(_, _, _, _)).Times(1)
+            .WillOnce(DoAll(SetArgPointee<2>(response),
+                            Invoke(DelayedReadChunk{leaderDelayMS, 'a'})));
+        EXPECT_CALL(followerService, ReadChunk(_, _, _, _)).Times(1)
+            .WillOnce(DoAll(SetArgPointee<2>(response),
+                            Invoke(DelayedReadChunk{followerDelayMS, 'b'})));
+
+        uint64_t sent = metric.sentCount.get_value();
+        uint64_t win = metric.winCount.get_value();
+        uint64_t discard = metric.discardCount.get_value();
+
+        copysetClient.ReadChunk(reqCtx->idinfo_, sn, 0, len, 1, {}, reqDone);
+        cond.Wait();
+        ASSERT_EQ(0, reqDone->GetErrorCode());
+        ASSERT_EQ(std::string(len, expected), reqCtx->readData_.to_string());
+        ASSERT_EQ(0, inflightControl.GetInflight(leaderId));
+
+        // 等待较慢的一方返回并被丢弃
+        for (int i = 0; i < 500; ++i) {
+            if (metric.discardCount.get_value() != discard) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        ASSERT_EQ(discard + 1, metric.discardCount.get_value());
+        ASSERT_EQ(sent + 1, metric.sentCount.get_value());
+        ASSERT_EQ(win + (expected == 'b' ? 1 : 0),
+                  metric.winCount.get_value());
+
+        // 被丢弃的一方不能再次结束请求，也不能再归还token
+        ASSERT_EQ(1, runs.load());
+        ASSERT_EQ(0, inflightControl.GetInflight(leaderId));
+    };
+
+    // leader先返回
+    runRace(200, 600, 'a');
+    // hedged read先返回
+    runRace(600, 0, 'b');
+
+    scheduler.Fini();
+    followerServer.Stop(0);
+    followerServer.Join();
+}
+
 /**
  * read snapshot error testing
  */
@@ -0,0 +1,191 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-04-05
+ * Author: curve
+ */
+
+// fio ioengine style load generator for the libcurve aio queue, keeps
+// iodepth requests in flight from a single thread and reaps completions by
+// waiting on the queue eventfd or by busy polling, e.g.
+//   aio_queue_bench -conf=./client.conf -filename=/test_user_ -rw=randread
+//                   -bs=4096 -iodepth=128 -runtime=60
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <chrono>  // NOLINT
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "include/client/libcurve.h"
+
+DEFINE_string(conf, "./client.conf", "client config path");
+DEFINE_string(filename, "/test_user_", "volume name with user info");
+DEFINE_string(rw, "randread", "read/write/randread/randwrite");
+DEFINE_uint64(bs, 4096, "block size");
+DEFINE_uint32(iodepth, 128, "number of requests in flight");
+DEFINE_uint32(runtime, 30, "test duration in seconds");
+DEFINE_bool(busy_poll, false, "busy poll completions instead of eventfd");
+
+namespace {
+
+struct BenchRequest {
+    CurveAioQueueRequest req;
+    std::chrono::steady_clock::time_point start;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    google::ParseCommandLineFlags(&argc, &argv, false);
+
+    const bool isWrite = FLAGS_rw.find("write") != std::string::npos;
+    const bool isRandom = FLAGS_rw.compare(0, 4, "rand") == 0;
+
+    if (Init(FLAGS_conf.c_str()) != 0) {
+        LOG(ERROR) << "Init libcurve failed";
+        return -1;
+    }
+
+    int fd = Open4Qemu(FLAGS_filename.c_str());
+    FileStatInfo info;
+    if (fd < 0 || StatFile4Qemu(FLAGS_filename.c_str(), &info) != 0) {
+        LOG(ERROR) << "Open " << FLAGS_filename << " failed";
+        UnInit();
+        return -1;
+    }
+
+    const uint64_t blocks = info.length / FLAGS_bs;
+    if (blocks == 0 || FLAGS_iodepth == 0) {
+        LOG(ERROR) << "Invalid bs " << FLAGS_bs << " or iodepth "
+                   << FLAGS_iodepth << " for file size " << info.length;
+        Close(fd);
+        UnInit();
+        return -1;
+    }
+
+    CurveAioQueue* queue = AioQueueCreate(FLAGS_iodepth);
+    if (queue == nullptr) {
+        LOG(ERROR) << "Create aio queue failed";
+        Close(fd);
+        UnInit();
+        return -1;
+    }
+
+    std::mt19937_64 rng(std::random_device{}());
+    uint64_t nextBlock = 0;
+
+    std::vector<BenchRequest> requests(FLAGS_iodepth);
+    std::vector<CurveAioQueueRequest*> toSubmit;
+    for (auto& r : requests) {
+        void* buf = nullptr;
+        if (posix_memalign(&buf, IO_ALIGNED_BLOCK_SIZE, FLAGS_bs) != 0) {
+            LOG(ERROR) << "Allocate buffer failed";
+            return -1;
+        }
+        r.req.op = isWrite ? LIBCURVE_OP_WRITE : LIBCURVE_OP_READ;
+        r.req.length = FLAGS_bs;
+        r.req.buf = buf;
+        r.req.userdata = &r;
+        toSubmit.push_back(&r.req);
+    }
+
+    auto prepare = [&](CurveAioQueueRequest* req) {
+        uint64_t block = isRandom ? rng() % blocks : nextBlock++ % blocks;
+        req->offset = block * FLAGS_bs;
+        static_cast<BenchRequest*>(req->userdata)->start =
+            std::chrono::steady_clock::now();
+    };
+
+    uint64_t completed = 0;
+    uint64_t errors = 0;
+    uint64_t totalLatencyUs = 0;
+    std::vector<CurveAioQueueRequest*> done(FLAGS_iodepth);
+
+    auto begin = std::chrono::steady_clock::now();
+    auto deadline = begin + std::chrono::seconds(FLAGS_runtime);
+    bool stopping = false;
+    uint32_t inflight = 0;
+    while (!stopping || inflight > 0) {
+        if (!stopping && !toSubmit.empty()) {
+            for (auto* req : toSubmit) {
+                prepare(req);
+            }
+            int ret = AioQueueSubmit(queue, fd, toSubmit.data(),
+                                     toSubmit.size());
+            if (ret < 0) {
+                LOG(ERROR) << "Submit failed, ret = " << ret;
+                stopping = true;
+            } else {
+                inflight += ret;
+                toSubmit.erase(toSubmit.begin(), toSubmit.begin() + ret);
+            }
+        }
+
+        if (!FLAGS_busy_poll) {
+            struct pollfd pfd = {AioQueueEventFd(queue), POLLIN, 0};
+            if (::poll(&pfd, 1, 100) == 1) {
+                uint64_t value;
+                (void)::read(pfd.fd, &value, sizeof(value));
+            }
+        }
+
+        int n = 0;
+        while ((n = AioQueuePoll(queue, done.data(), done.size())) > 0) {
+            auto now = std::chrono::steady_clock::now();
+            for (int i = 0; i < n; ++i) {
+                auto* r = static_cast<BenchRequest*>(done[i]->userdata);
+                totalLatencyUs +=
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        now - r->start).count();
+                errors += done[i]->ret < 0 ? 1 : 0;
+                toSubmit.push_back(done[i]);
+            }
+            completed += n;
+            inflight -= n;
+        }
+
+        stopping = stopping || std::chrono::steady_clock::now() >= deadline;
+    }
+
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - begin).count();
+    std::cout << FLAGS_rw << ": bs=" << FLAGS_bs
+              << ", iodepth=" << FLAGS_iodepth
+              << (FLAGS_busy_poll ? ", busy poll" : ", eventfd")
+              << "\n  iops=" << static_cast<uint64_t>(completed / seconds)
+              << ", bw=" << completed * FLAGS_bs / seconds / 1024 / 1024
+              << " MiB/s, avg lat="
+              << (completed == 0 ? 0 : totalLatencyUs / completed)
+              << " us, errors=" << errors << std::endl;
+
+    for (auto& r : requests) {
+        free(r.req.buf);
+    }
+    AioQueueDestroy(queue);
+    Close(fd);
+    UnInit();
+    return errors == 0 ? 0 : -1;
+}
@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-04-03
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "src/client/hedged_read.h"
+
+namespace curve {
+namespace client {
+
+TEST(HedgedReadTest, OnlyOneFinish) {
+    HedgedReadState state;
+    ASSERT_FALSE(state.IsFinished());
+    ASSERT_TRUE(state.TryFinish());
+    ASSERT_TRUE(state.IsFinished());
+    ASSERT_FALSE(state.TryFinish());
+}
+
+TEST(HedgedReadTest, HedgeDelay) {
+    HedgedReadOption opt;
+    opt.delayPercentile = 0.9;
+    opt.minDelayUS = 1000;
+    opt.maxDelayUS = 50000;
+
+    auto& latency = ChunkServerReadLatency::GetInstance();
+
+    // no latency recorded, wait for the max delay
+    ASSERT_EQ(opt.maxDelayUS, latency.GetHedgeDelayUS(10001, opt));
+
+    // latency recorder updates its percentiles every second
+    for (int i = 0; i < 100; i++) {
+        latency.Record(10002, 10);
+        latency.Record(10003, 1000000);
+    }
+    ::sleep(2);
+    ASSERT_EQ(opt.minDelayUS, latency.GetHedgeDelayUS(10002, opt));
+    ASSERT_EQ(opt.maxDelayUS, latency.GetHedgeDelayUS(10003, opt));
+}
+
+}  // namespace client
+}  // namespace curve
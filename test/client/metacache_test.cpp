@@ -28,6 +28,8 @@
 #include <tuple>
 #include <vector>
 
+#include "test/client/mock/mock_mdsclient.h"
+
 namespace curve {
 namespace client {
 
@@ -109,5 +111,84 @@ TEST_F(MetaCacheTest, TestCleanChunksInSegment) {
     }
 }
 
+TEST_F(MetaCacheTest, TestPrefetch) {
+    using ::testing::_;
+    using ::testing::DoAll;
+    using ::testing::Return;
+    using ::testing::SetArgPointee;
+
+    MockMDSClient mdsclient;
+    MetaCacheOption opt;
+    opt.prefetchMaxSegments = 4;
+    metaCache_.Init(opt, &mdsclient);
+
+    fileInfo_.fullPathName = "/MetaCacheTest";
+    fileInfo_.length = 4 * GiB;
+    fileInfo_.segmentsize = 1 * GiB;
+    fileInfo_.chunksize = 512 * MiB;
+
+    // only the second segment is allocated
+    SegmentInfo segInfo;
+    segInfo.segmentsize = 1 * GiB;
+    segInfo.chunksize = 512 * MiB;
+    segInfo.startoffset = 1 * GiB;
+    segInfo.lpcpIDInfo.lpid = 1;
+    segInfo.lpcpIDInfo.cpidVec = {10, 11};
+    segInfo.chunkvec = {ChunkIDInfo(100, 1, 10), ChunkIDInfo(101, 1, 11)};
+
+    // copyset 10 with leader from mds, copyset 11 without
+    std::vector<CopysetInfo<ChunkServerID>> cpinfoVec(2);
+    for (int i = 0; i < 2; ++i) {
+        cpinfoVec[i].lpid_ = 1;
+        cpinfoVec[i].cpid_ = 10 + i;
+        for (int j = 0; j < 3; ++j) {
+            CopysetPeerInfo<ChunkServerID> peer;
+            peer.peerID = j + 1;
+            butil::EndPoint ep;
+            butil::str2endpoint("127.0.0.1", 8200 + j, &ep);
+            peer.internalAddr = PeerAddr(ep);
+            peer.externalAddr = PeerAddr(ep);
+            cpinfoVec[i].AddCopysetPeerInfo(peer);
+        }
+    }
+    ASSERT_EQ(0, cpinfoVec[0].UpdateLeaderInfo(
+                     cpinfoVec[0].csinfos_[1].internalAddr));
+
+    EXPECT_CALL(mdsclient, ListSegment(_, _, _))
+        .WillOnce(DoAll(SetArgPointee<1>(std::vector<SegmentInfo>{segInfo}),
+                        SetArgPointee<2>(cpinfoVec),
+                        Return(LIBCURVE_ERROR::OK)));
+    ASSERT_EQ(0, metaCache_.Prefetch(fileInfo_));
+
+    ChunkIDInfo chunkInfo;
+    ASSERT_EQ(MetaCacheErrorType::CHUNKINFO_NOT_FOUND,
+              metaCache_.GetChunkInfoByIndex(0, &chunkInfo));
+    ASSERT_EQ(MetaCacheErrorType::OK,
+              metaCache_.GetChunkInfoByIndex(2, &chunkInfo));
+    ASSERT_EQ(100, chunkInfo.cid_);
+    ASSERT_EQ(10, chunkInfo.cpid_);
+    ASSERT_EQ(MetaCacheErrorType::OK,
+              metaCache_.GetChunkInfoByIndex(3, &chunkInfo));
+    ASSERT_EQ(101, chunkInfo.cid_);
+
+    // leader is usable without asking chunkservers
+    ChunkServerID leaderId = 0;
+    ASSERT_TRUE(metaCache_.GetCachedLeaderID(1, 10, &leaderId));
+    ASSERT_EQ(2, leaderId);
+    ASSERT_FALSE(metaCache_.GetCachedLeaderID(1, 11, &leaderId));
+    ASSERT_EQ(3, metaCache_.GetServerList(1, 11).csinfos_.size());
+
+    // file with too many segments is not prefetched
+    fileInfo_.length = 8 * GiB;
+    EXPECT_CALL(mdsclient, ListSegment(_, _, _)).Times(0);
+    ASSERT_EQ(-1, metaCache_.Prefetch(fileInfo_));
+
+    // prefetch failure
+    fileInfo_.length = 4 * GiB;
+    EXPECT_CALL(mdsclient, ListSegment(_, _, _))
+        .WillOnce(Return(LIBCURVE_ERROR::FAILED));
+    ASSERT_EQ(-1, metaCache_.Prefetch(fileInfo_));
+}
+
 }  // namespace client
 }  // namespace curve
@@ -32,6 +32,9 @@ namespace client {
 class MockMDSClient : public MDSClient {
  public:
     MOCK_METHOD2(DeAllocateSegment, LIBCURVE_ERROR(const FInfo*, uint64_t));
+    MOCK_METHOD3(ListSegment,
+                 LIBCURVE_ERROR(const FInfo*, std::vector<SegmentInfo>*,
+                                std::vector<CopysetInfo<ChunkServerID>>*));
 };
 
 }  // namespace client
@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-31
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+
+#include "src/client/request_context.h"
+
+namespace curve {
+namespace client {
+
+TEST(RequestContextTest, RecycleAndReuse) {
+    RequestContext* ctx = RequestContext::NewInitedRequestContext();
+    ASSERT_NE(nullptr, ctx);
+    ASSERT_NE(nullptr, ctx->done_);
+    ASSERT_EQ(ctx, ctx->done_->GetReqCtx());
+
+    RequestClosure* done = ctx->done_;
+    uint64_t id = ctx->id_;
+    ctx->idinfo_ = ChunkIDInfo(1, 2, 3);
+    ctx->optype_ = OpType::WRITE;
+    ctx->offset_ = 4096;
+    ctx->rawlength_ = 4096;
+    ctx->seq_ = 1;
+    ctx->writeData_.append("hello");
+    ctx->location_ = "location";
+    ctx->padding.aligned = false;
+    ctx->done_->SetFailed(0);
+    ctx->done_->IncremRetriedTimes();
+    ctx->done_->SetNextTimeOutMS(1000);
+
+    // the context and its closure are reused in the same thread
+    RequestContext::Recycle(ctx);
+    RequestContext* reused = RequestContext::NewInitedRequestContext();
+    ASSERT_EQ(ctx, reused);
+    ASSERT_EQ(done, reused->done_);
+    ASSERT_NE(id, reused->id_);
+
+    ASSERT_EQ(0, reused->idinfo_.cid_);
+    ASSERT_EQ(OpType::UNKNOWN, reused->optype_);
+    ASSERT_EQ(0, reused->offset_);
+    ASSERT_EQ(0, reused->rawlength_);
+    ASSERT_EQ(0, reused->seq_);
+    ASSERT_TRUE(reused->writeData_.empty());
+    ASSERT_TRUE(reused->location_.empty());
+    ASSERT_TRUE(reused->padding.aligned);
+    ASSERT_EQ(-1, reused->done_->GetErrorCode());
+    ASSERT_EQ(0, reused->done_->GetRetriedTimes());
+    ASSERT_EQ(0, reused->done_->GetNextTimeoutMS());
+    ASSERT_EQ(nullptr, reused->done_->GetIOTracker());
+
+    RequestContext::Recycle(reused);
+}
+
+}  // namespace client
+}  // namespace curve
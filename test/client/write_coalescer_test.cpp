@@ -0,0 +1,239 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-04-04
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>  // NOLINT
+#include <mutex>   // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "src/client/write_coalescer.h"
+
+namespace curve {
+namespace client {
+
+namespace {
+
+struct UserWrite : public CurveAioContext {
+    std::string data;
+    int result = 0;
+    bool done = false;
+
+    UserWrite(off_t off, size_t len, char c) : data(len, c) {
+        offset = off;
+        length = len;
+        ret = 0;
+        op = LIBCURVE_OP_WRITE;
+        cb = OnDone;
+        buf = &data[0];
+    }
+
+    CurveAioContext* Ctx() {
+        return this;
+    }
+
+    static void OnDone(CurveAioContext* ctx) {
+        UserWrite* write = static_cast<UserWrite*>(ctx);
+        write->result = ctx->ret;
+        write->done = true;
+    }
+};
+
+class WriteCoalescerTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        opt_.enable = true;
+        opt_.windowUS = 100 * 1000;
+        opt_.maxWriteSize = 16 * 1024;
+        opt_.maxMergedSize = 64 * 1024;
+    }
+
+    std::unique_ptr<WriteCoalescer> NewCoalescer() {
+        return std::unique_ptr<WriteCoalescer>(new WriteCoalescer(
+            opt_, &metric_,
+            [this](CurveAioContext* ctx, UserDataType dataType) {
+                std::lock_guard<std::mutex> lk(mtx_);
+                submitted_.emplace_back(ctx, dataType);
+            }));
+    }
+
+    std::vector<std::pair<CurveAioContext*, UserDataType>> Submitted() {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return submitted_;
+    }
+
+    WriteCoalesceOption opt_;
+    WriteCoalesceMetric metric_{"write_coalescer_test"};
+    std::mutex mtx_;
+    std::vector<std::pair<CurveAioContext*, UserDataType>> submitted_;
+};
+
+}  // namespace
+
+TEST_F(WriteCoalescerTest, MergeAdjacentAndOverlapping) {
+    const uint64_t chunkSize = 16 * 1024 * 1024;
+    auto coalescer = NewCoalescer();
+
+    UserWrite w1(0, 4096, 'a');
+    UserWrite w2(4096, 4096, 'b');
+    UserWrite w3(2048, 4096, 'c');
+    ASSERT_TRUE(coalescer->Add(w1.Ctx(), UserDataType::RawBuffer, chunkSize));
+    ASSERT_TRUE(coalescer->Add(w2.Ctx(), UserDataType::RawBuffer, chunkSize));
+    ASSERT_TRUE(coalescer->Add(w3.Ctx(), UserDataType::RawBuffer, chunkSize));
+    ASSERT_TRUE(Submitted().empty());
+
+    coalescer->Stop();
+    auto submitted = Submitted();
+    ASSERT_EQ(1, submitted.size());
+    ASSERT_EQ(UserDataType::IOBuffer, submitted[0].second);
+
+    CurveAioContext* merged = submitted[0].first;
+    ASSERT_EQ(0, merged->offset);
+    ASSERT_EQ(8192, merged->length);
+    std::string expected =
+        std::string(2048, 'a') + std::string(4096, 'c') + std::string(2048, 'b');
+    ASSERT_EQ(expected,
+              reinterpret_cast<butil::IOBuf*>(merged->buf)->to_string());
+
+    merged->ret = merged->length;
+    merged->cb(merged);
+    ASSERT_TRUE(w1.done && w2.done && w3.done);
+    ASSERT_EQ(4096, w1.result);
+    ASSERT_EQ(4096, w2.result);
+    ASSERT_EQ(4096, w3.result);
+
+    ASSERT_EQ(3, metric_.userWrites.get_value());
+    ASSERT_EQ(1, metric_.mergedWrites.get_value());
+}
+
+TEST_F(WriteCoalescerTest, MergedWriteFailed) {
+    const uint64_t chunkSize = 16 * 1024 * 1024;
+    auto coalescer = NewCoalescer();
+
+    UserWrite w1(8192, 4096, 'a');
+    UserWrite w2(4096, 4096, 'b');
+    ASSERT_TRUE(coalescer->Add(w1.Ctx(), UserDataType::RawBuffer, chunkSize));
+    ASSERT_TRUE(coalescer->Add(w2.Ctx(), UserDataType::RawBuffer, chunkSize));
+    coalescer->Stop();
+
+    auto submitted = Submitted();
+    ASSERT_EQ(1, submitted.size());
+    CurveAioContext* merged = submitted[0].first;
+    ASSERT_EQ(4096, merged->offset);
+    ASSERT_EQ(8192, merged->length);
+
+    merged->ret = -LIBCURVE_ERROR::FAILED;
+    merged->cb(merged);
+    ASSERT_EQ(-LIBCURVE_ERROR::FAILED, w1.result);
+    ASSERT_EQ(-LIBCURVE_ERROR::FAILED, w2.result);
+}
+
+TEST_F(WriteCoalescerTest, NotMerged) {
+    const uint64_t chunkSize = 64 * 1024;
+    auto coalescer = NewCoalescer();
+
+    // too large
+    UserWrite large(0, opt_.maxWriteSize + 4096, 'a');
+    ASSERT_FALSE(coalescer->Add(large.Ctx(), UserDataType::RawBuffer,
+                                chunkSize));
+
+    // across chunks
+    UserWrite across(chunkSize - 4096, 8192, 'a');
+    ASSERT_FALSE(coalescer->Add(across.Ctx(), UserDataType::RawBuffer,
+                                chunkSize));
+
+    // not adjacent, the pending write is submitted as it is
+    UserWrite w1(0, 4096, 'a');
+    UserWrite w2(16384, 4096, 'b');
+    ASSERT_TRUE(coalescer->Add(w1.Ctx(), UserDataType::RawBuffer, chunkSize));
+    ASSERT_TRUE(coalescer->Add(w2.Ctx(), UserDataType::RawBuffer, chunkSize));
+    auto submitted = Submitted();
+    ASSERT_EQ(1, submitted.size());
+    ASSERT_EQ(w1.Ctx(), submitted[0].first);
+    ASSERT_EQ(UserDataType::RawBuffer, submitted[0].second);
+
+    // adjacent but in another chunk
+    UserWrite w3(chunkSize, 4096, 'c');
+    ASSERT_TRUE(coalescer->Add(w3.Ctx(), UserDataType::RawBuffer, chunkSize));
+    submitted = Submitted();
+    ASSERT_EQ(2, submitted.size());
+    ASSERT_EQ(w2.Ctx(), submitted[1].first);
+
+    coalescer->Stop();
+    submitted = Submitted();
+    ASSERT_EQ(3, submitted.size());
+    ASSERT_EQ(w3.Ctx(), submitted[2].first);
+
+    // no more coalescing after stop
+    UserWrite w4(0, 4096, 'd');
+    ASSERT_FALSE(coalescer->Add(w4.Ctx(), UserDataType::RawBuffer, chunkSize));
+}
+
+TEST_F(WriteCoalescerTest, FlushWhenFull) {
+    const uint64_t chunkSize = 16 * 1024 * 1024;
+    auto coalescer = NewCoalescer();
+
+    std::vector<std::unique_ptr<UserWrite>> writes;
+    for (uint64_t off = 0; off < opt_.maxMergedSize; off += 16384) {
+        writes.emplace_back(new UserWrite(off, 16384, 'a'));
+        ASSERT_TRUE(coalescer->Add(writes.back()->Ctx(),
+                                   UserDataType::RawBuffer, chunkSize));
+    }
+
+    auto submitted = Submitted();
+    ASSERT_EQ(1, submitted.size());
+    ASSERT_EQ(opt_.maxMergedSize, submitted[0].first->length);
+
+    submitted[0].first->ret = submitted[0].first->length;
+    submitted[0].first->cb(submitted[0].first);
+    for (auto& write : writes) {
+        ASSERT_TRUE(write->done);
+    }
+}
+
+TEST_F(WriteCoalescerTest, FlushWhenWindowExpired) {
+    const uint64_t chunkSize = 16 * 1024 * 1024;
+    opt_.windowUS = 1000;
+    auto coalescer = NewCoalescer();
+
+    UserWrite w1(0, 4096, 'a');
+    UserWrite w2(4096, 4096, 'b');
+    ASSERT_TRUE(coalescer->Add(w1.Ctx(), UserDataType::RawBuffer, chunkSize));
+    ASSERT_TRUE(coalescer->Add(w2.Ctx(), UserDataType::RawBuffer, chunkSize));
+
+    for (int i = 0; i < 100 && Submitted().empty(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    auto submitted = Submitted();
+    ASSERT_EQ(1, submitted.size());
+    ASSERT_EQ(8192, submitted[0].first->length);
+    submitted[0].first->ret = submitted[0].first->length;
+    submitted[0].first->cb(submitted[0].first);
+    ASSERT_TRUE(w1.done && w2.done);
+}
+
+}  // namespace client
+}  // namespace curve
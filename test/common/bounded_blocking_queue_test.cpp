@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: 2023-03-31
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>   //NOLINT
+#include <vector>
+
+#include "src/common/concurrent/bounded_blocking_queue.h"
+
+namespace curve {
+namespace common {
+
+TEST(BoundedBlockingDequeTest, BatchPutAndTake) {
+    BoundedBlockingDeque<int> deque;
+    ASSERT_EQ(0, deque.Init(8));
+
+    std::vector<int> in{1, 2, 3, 4, 5};
+    deque.PutBack(in.begin(), in.end());
+    deque.PutFront(0);
+    ASSERT_EQ(6, deque.Size());
+
+    std::vector<int> out;
+    ASSERT_EQ(4, deque.TakeFront(4, &out));
+    ASSERT_EQ((std::vector<int>{0, 1, 2, 3}), out);
+
+    ASSERT_EQ(2, deque.TakeFront(4, &out));
+    ASSERT_EQ((std::vector<int>{4, 5}), out);
+    ASSERT_TRUE(deque.Empty());
+
+    // at least one item is taken
+    deque.PutBack(6);
+    ASSERT_EQ(1, deque.TakeFront(0, &out));
+    ASSERT_EQ(6, out[0]);
+}
+
+TEST(BoundedBlockingDequeTest, BatchPutExceedCapacity) {
+    BoundedBlockingDeque<int> deque;
+    ASSERT_EQ(0, deque.Init(4));
+
+    std::vector<int> in(100);
+    for (int i = 0; i < 100; i++) {
+        in[i] = i;
+    }
+
+    std::thread producer([&]() { deque.PutBack(in.begin(), in.end()); });
+
+    std::vector<int> all;
+    std::vector<int> out;
+    while (all.size() < in.size()) {
+        ASSERT_LE(deque.TakeFront(3, &out), 3);
+        all.insert(all.end(), out.begin(), out.end());
+    }
+    producer.join();
+
+    ASSERT_EQ(in, all);
+    ASSERT_TRUE(deque.Empty());
+}
+
+}  // namespace common
+}  // namespace curve
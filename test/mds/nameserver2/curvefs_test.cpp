@@ -1221,6 +1221,107 @@ TEST_F(CurveFSTest, testGetAllocatedSize) {
     }
 }
 
+TEST_F(CurveFSTest, testListSegment) {
+    FileInfo fileInfo;
+    fileInfo.set_id(1);
+    fileInfo.set_filetype(FileType::INODE_PAGEFILE);
+
+    // two segments sharing copyset 2
+    std::vector<PageFileSegment> segments(2);
+    for (int i = 0; i < 2; ++i) {
+        segments[i].set_logicalpoolid(1);
+        segments[i].set_segmentsize(DefaultSegmentSize);
+        segments[i].set_chunksize(curvefs_->GetDefaultChunkSize());
+        segments[i].set_startoffset(i * DefaultSegmentSize);
+        for (int j = 0; j < 2; ++j) {
+            PageFileChunkInfo* chunk = segments[i].add_chunks();
+            chunk->set_chunkid(i * 2 + j);
+            chunk->set_copysetid(i + j + 1);
+        }
+    }
+
+    curve::mds::topology::CopySetInfo copyset(1, 1);
+    copyset.SetCopySetMembers({1, 2, 3});
+    copyset.SetLeader(2);
+    curve::mds::topology::ChunkServer cs(1, "", "", 1, "127.0.0.1", 8200, "");
+
+    // test normal
+    {
+        std::vector<PageFileSegment> out;
+        ::google::protobuf::RepeatedPtrField<SegmentCopysetInfo> copysets;
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo),
+            Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, ListSegment(_, _))
+        .WillOnce(DoAll(SetArgPointee<1>(segments),
+            Return(StoreStatus::OK)));
+        EXPECT_CALL(*topology_, GetCopySet(_, _))
+        .Times(3)
+        .WillRepeatedly(DoAll(SetArgPointee<1>(copyset), Return(true)));
+        EXPECT_CALL(*topology_, GetChunkServer(_, _))
+        .Times(9)
+        .WillRepeatedly(DoAll(SetArgPointee<1>(cs), Return(true)));
+        ASSERT_EQ(StatusCode::kOK,
+                  curvefs_->ListSegment("/file1", &out, &copysets));
+        ASSERT_EQ(2, out.size());
+        ASSERT_EQ(3, copysets.size());
+        for (int i = 0; i < 3; ++i) {
+            ASSERT_EQ(1, copysets.Get(i).logicalpoolid());
+            ASSERT_EQ(i + 1, copysets.Get(i).copysetid());
+            ASSERT_EQ(3, copysets.Get(i).cslocs_size());
+            ASSERT_EQ(2, copysets.Get(i).leaderid());
+        }
+    }
+    // test file not exist
+    {
+        std::vector<PageFileSegment> out;
+        ::google::protobuf::RepeatedPtrField<SegmentCopysetInfo> copysets;
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .WillOnce(Return(StoreStatus::KeyNotExist));
+        ASSERT_EQ(StatusCode::kFileNotExists,
+                  curvefs_->ListSegment("/file1", &out, &copysets));
+    }
+    // test not page file
+    {
+        FileInfo dirInfo;
+        dirInfo.set_filetype(FileType::INODE_DIRECTORY);
+        std::vector<PageFileSegment> out;
+        ::google::protobuf::RepeatedPtrField<SegmentCopysetInfo> copysets;
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(dirInfo),
+            Return(StoreStatus::OK)));
+        ASSERT_EQ(StatusCode::kParaError,
+                  curvefs_->ListSegment("/file1", &out, &copysets));
+    }
+    // test list segment fail
+    {
+        std::vector<PageFileSegment> out;
+        ::google::protobuf::RepeatedPtrField<SegmentCopysetInfo> copysets;
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo),
+            Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, ListSegment(_, _))
+        .WillOnce(Return(StoreStatus::InternalError));
+        ASSERT_EQ(StatusCode::kStorageError,
+                  curvefs_->ListSegment("/file1", &out, &copysets));
+    }
+    // test copyset not found
+    {
+        std::vector<PageFileSegment> out;
+        ::google::protobuf::RepeatedPtrField<SegmentCopysetInfo> copysets;
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo),
+            Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, ListSegment(_, _))
+        .WillOnce(DoAll(SetArgPointee<1>(segments),
+            Return(StoreStatus::OK)));
+        EXPECT_CALL(*topology_, GetCopySet(_, _))
+        .WillOnce(Return(false));
+        ASSERT_EQ(StatusCode::KInternalError,
+                  curvefs_->ListSegment("/file1", &out, &copysets));
+    }
+}
+
 TEST_F(CurveFSTest, testGetFileSize) {
     uint64_t fileSize;
     FileInfo  fileInfo;